@@ -0,0 +1,127 @@
+#include "AmcpCommand.h"
+
+#include <charconv>
+
+AmcpCommand::AmcpCommand()
+    : encoder(QStringConverter::Utf8, QStringConverter::Flag::Stateless)
+{
+    this->buffer.reserve(256);
+}
+
+AmcpCommand& AmcpCommand::clear()
+{
+    // Keep the capacity, the buffer is reused for every command sent on the device.
+    this->buffer.resize(0);
+
+    return *this;
+}
+
+AmcpCommand& AmcpCommand::append(int value)
+{
+    char digits[16];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    this->buffer.append(digits, result.ptr - digits);
+
+    return *this;
+}
+
+AmcpCommand& AmcpCommand::number(int value)
+{
+    appendSeparator();
+
+    return append(value);
+}
+
+AmcpCommand& AmcpCommand::number(float value)
+{
+    appendSeparator();
+
+    // Same output as QString::arg(double), six significant digits and no trailing zeros, but locale independent.
+    char digits[32];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), static_cast<double>(value), std::chars_format::general, 6);
+    this->buffer.append(digits, result.ptr - digits);
+
+    return *this;
+}
+
+AmcpCommand& AmcpCommand::layer(int channel, int videolayer)
+{
+    return number(channel).append("-").append(videolayer);
+}
+
+AmcpCommand& AmcpCommand::text(QStringView value)
+{
+    // Empty parameters are left out, the server splits on whitespace anyway.
+    if (value.isEmpty())
+        return *this;
+
+    appendSeparator();
+    appendUtf8(value);
+
+    return *this;
+}
+
+AmcpCommand& AmcpCommand::quoted(QStringView value)
+{
+    appendSeparator();
+
+    this->buffer.append('"');
+    appendUtf8(value);
+    this->buffer.append('"');
+
+    return *this;
+}
+
+AmcpCommand& AmcpCommand::escaped(QStringView value)
+{
+    appendSeparator();
+
+    this->buffer.append('"');
+
+    qsizetype start = 0;
+    for (qsizetype i = 0; i < value.size(); ++i)
+    {
+        if (value.at(i) != u'\\' && value.at(i) != u'"')
+            continue;
+
+        appendUtf8(value.mid(start, i - start));
+        this->buffer.append('\\');
+        this->buffer.append(static_cast<char>(value.at(i).unicode()));
+
+        start = i + 1;
+    }
+    appendUtf8(value.mid(start));
+
+    this->buffer.append('"');
+
+    return *this;
+}
+
+bool AmcpCommand::isEmpty() const
+{
+    return this->buffer.isEmpty();
+}
+
+const QByteArray& AmcpCommand::data() const
+{
+    return this->buffer;
+}
+
+void AmcpCommand::appendSeparator()
+{
+    if (!this->buffer.isEmpty())
+        this->buffer.append(' ');
+}
+
+void AmcpCommand::appendUtf8(QStringView value)
+{
+    if (value.isEmpty())
+        return;
+
+    // Encode straight into the buffer, no temporary QByteArray.
+    qsizetype size = this->buffer.size();
+    this->buffer.resize(size + this->encoder.requiredSpace(value.size()));
+
+    char* end = this->encoder.appendToBuffer(this->buffer.data() + size, value);
+    this->buffer.resize(end - this->buffer.constData());
+}
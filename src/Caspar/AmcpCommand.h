@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Shared.h"
+
+#include <cstddef>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QStringEncoder>
+#include <QtCore/QStringView>
+
+class CASPAR_EXPORT AmcpCommand
+{
+    public:
+        explicit AmcpCommand();
+
+        AmcpCommand& clear();
+
+        // Literals are copied with their compile time length, they are expected to be ASCII.
+        template <std::size_t N>
+        AmcpCommand& keyword(const char (&keyword)[N])
+        {
+            appendSeparator();
+            this->buffer.append(keyword, N - 1);
+
+            return *this;
+        }
+
+        template <std::size_t N>
+        AmcpCommand& option(bool enabled, const char (&keyword)[N])
+        {
+            if (enabled)
+                this->keyword(keyword);
+
+            return *this;
+        }
+
+        template <std::size_t N>
+        AmcpCommand& append(const char (&literal)[N])
+        {
+            this->buffer.append(literal, N - 1);
+
+            return *this;
+        }
+
+        AmcpCommand& append(int value);
+        AmcpCommand& number(int value);
+        AmcpCommand& number(float value);
+        AmcpCommand& layer(int channel, int videolayer);
+        AmcpCommand& text(QStringView value);
+        AmcpCommand& quoted(QStringView value);
+        AmcpCommand& escaped(QStringView value);
+
+        bool isEmpty() const;
+        const QByteArray& data() const;
+
+    private:
+        QByteArray buffer;
+        QStringEncoder encoder;
+
+        void appendSeparator();
+        void appendUtf8(QStringView value);
+};
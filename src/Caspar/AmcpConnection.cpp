@@ -0,0 +1,182 @@
+#include "AmcpConnection.h"
+
+#include <QtCore/QMetaObject>
+#include <QtCore/QTimer>
+
+#include <QtNetwork/QTcpSocket>
+
+AmcpConnection::AmcpConnection(const QString& address, int port, QObject* parent)
+    : QObject(parent), address(address), port(port), queue(nullptr),
+      writeCount(0), writtenCommandCount(0), writeLatency(0), maxWriteLatency(0)
+{
+    this->socket = new QTcpSocket(this);
+
+    QObject::connect(this->socket, SIGNAL(readyRead()), this, SLOT(readMessage()));
+    QObject::connect(this->socket, SIGNAL(connected()), this, SLOT(setConnected()));
+    QObject::connect(this->socket, SIGNAL(disconnected()), this, SLOT(setDisconnected()));
+}
+
+AmcpConnection::~AmcpConnection()
+{
+    // Release the messages that never got written.
+    AmcpConnectionMessage* message = this->queue.exchange(nullptr);
+    while (message != nullptr)
+    {
+        AmcpConnectionMessage* next = message->next;
+        delete message;
+        message = next;
+    }
+}
+
+qint64 AmcpConnection::getWriteCount() const
+{
+    return this->writeCount.load(std::memory_order_relaxed);
+}
+
+qint64 AmcpConnection::getWrittenCommandCount() const
+{
+    return this->writtenCommandCount.load(std::memory_order_relaxed);
+}
+
+qint64 AmcpConnection::getWriteLatency() const
+{
+    return this->writeLatency.load(std::memory_order_relaxed);
+}
+
+qint64 AmcpConnection::getMaxWriteLatency() const
+{
+    return this->maxWriteLatency.load(std::memory_order_relaxed);
+}
+
+void AmcpConnection::enqueueMessage(const QByteArray& message, int commands, const QSharedPointer<AmcpDispatchRound>& round)
+{
+    // Lock free push from any thread. The I/O thread is only woken up when the queue goes
+    // from empty to non-empty, it then drains everything that was queued in the meantime.
+    AmcpConnectionMessage* node = new AmcpConnectionMessage();
+    node->data = message;
+    node->commands = commands;
+    node->round = round;
+    node->timer.start();
+
+    AmcpConnectionMessage* previous = this->queue.load(std::memory_order_relaxed);
+    do
+    {
+        node->next = previous;
+    } while (!this->queue.compare_exchange_weak(previous, node, std::memory_order_release, std::memory_order_relaxed));
+
+    if (previous == nullptr)
+        QMetaObject::invokeMethod(this, "writeQueue", Qt::QueuedConnection);
+}
+
+void AmcpConnection::writeQueue()
+{
+    AmcpConnectionMessage* message = this->queue.exchange(nullptr, std::memory_order_acquire);
+
+    // The queue is a stack, newest message first. Reverse it to keep the command order.
+    AmcpConnectionMessage* ordered = nullptr;
+    while (message != nullptr)
+    {
+        AmcpConnectionMessage* next = message->next;
+        message->next = ordered;
+        ordered = message;
+        message = next;
+    }
+
+    if (ordered == nullptr)
+        return;
+
+    // Everything queued since the last wakeup goes out in a single write, the oldest message gives the latency.
+    qint64 latency = ordered->timer.nsecsElapsed() / 1000;
+
+    int commands = 0;
+    QByteArray data;
+    QList<QSharedPointer<AmcpDispatchRound>> rounds;
+    while (ordered != nullptr)
+    {
+        commands += ordered->commands;
+        data.append(ordered->data);
+
+        if (!ordered->round.isNull())
+            rounds.append(ordered->round);
+
+        AmcpConnectionMessage* next = ordered->next;
+        delete ordered;
+        ordered = next;
+    }
+
+    if (!this->isConnected)
+        return;
+
+    this->socket->write(data);
+    this->socket->flush();
+
+    foreach (const QSharedPointer<AmcpDispatchRound>& round, rounds)
+        round->written();
+
+    this->writeCount.fetch_add(1, std::memory_order_relaxed);
+    this->writtenCommandCount.fetch_add(commands, std::memory_order_relaxed);
+    this->writeLatency.fetch_add(latency, std::memory_order_relaxed);
+    if (latency > this->maxWriteLatency.load(std::memory_order_relaxed))
+        this->maxWriteLatency.store(latency, std::memory_order_relaxed);
+}
+
+void AmcpConnection::connectDevice()
+{
+    if (this->isConnected)
+        return;
+
+    this->socket->connectToHost(this->address, this->port);
+
+    QTimer::singleShot(5000, this, SLOT(connectDevice()));
+}
+
+void AmcpConnection::disconnectDevice()
+{
+    this->socket->blockSignals(true);
+    this->socket->disconnectFromHost();
+    this->socket->blockSignals(false);
+
+    this->isConnected = false;
+}
+
+void AmcpConnection::setConnected()
+{
+    this->isConnected = true;
+
+    // Commands are already coalesced before they are written, Nagle would only delay them further.
+    this->socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+    this->parser.clear();
+
+    emit connected();
+}
+
+void AmcpConnection::setDisconnected()
+{
+    this->isConnected = false;
+
+    emit disconnected();
+
+    QTimer::singleShot(5000, this, SLOT(connectDevice()));
+}
+
+void AmcpConnection::readMessage()
+{
+    QList<QString> lines;
+    while (this->socket->bytesAvailable())
+    {
+        const QByteArray data = this->socket->readAll();
+        this->bytesReceived += data.size();
+
+        this->parser.append(data);
+        this->parser.parse(lines);
+    }
+
+    // Partial lines stay in the I/O thread, the device is only woken up for complete ones.
+    if (lines.isEmpty())
+        return;
+
+    emit linesReceived(lines, this->bytesReceived);
+
+    this->bytesReceived = 0;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Shared.h"
+
+#include "AmcpDispatchRound.h"
+#include "AmcpLineParser.h"
+
+#include <atomic>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+
+class QObject;
+class QTcpSocket;
+
+class CASPAR_EXPORT AmcpConnection : public QObject
+{
+    Q_OBJECT
+
+    public:
+        explicit AmcpConnection(const QString& address, int port, QObject* parent = 0);
+        virtual ~AmcpConnection();
+
+        void enqueueMessage(const QByteArray& message, int commands = 1, const QSharedPointer<AmcpDispatchRound>& round = QSharedPointer<AmcpDispatchRound>());
+
+        qint64 getWriteCount() const;
+        qint64 getWrittenCommandCount() const;
+        qint64 getWriteLatency() const;
+        qint64 getMaxWriteLatency() const;
+
+        Q_SLOT void connectDevice();
+        Q_SLOT void disconnectDevice();
+
+        Q_SIGNAL void connected();
+        Q_SIGNAL void disconnected();
+        Q_SIGNAL void linesReceived(const QList<QString>&, qint64);
+
+    private:
+        struct AmcpConnectionMessage
+        {
+            QByteArray data;
+            int commands = 0;
+            QElapsedTimer timer;
+            QSharedPointer<AmcpDispatchRound> round;
+            AmcpConnectionMessage* next = nullptr;
+        };
+
+        QString address;
+
+        int port;
+
+        bool isConnected = false;
+
+        QTcpSocket* socket = nullptr;
+
+        std::atomic<AmcpConnectionMessage*> queue;
+
+        std::atomic<qint64> writeCount;
+        std::atomic<qint64> writtenCommandCount;
+        std::atomic<qint64> writeLatency;
+        std::atomic<qint64> maxWriteLatency;
+
+        qint64 bytesReceived = 0;
+
+        AmcpLineParser parser;
+
+        Q_SLOT void writeQueue();
+        Q_SLOT void readMessage();
+        Q_SLOT void setConnected();
+        Q_SLOT void setDisconnected();
+};
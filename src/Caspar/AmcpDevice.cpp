@@ -1,27 +1,34 @@
 #include "AmcpDevice.h"
+#include "AmcpConnection.h"
 
+#include <charconv>
+
+#include <QtCore/QMetaObject>
 #include <QtCore/QStringList>
 #include <QtCore/QThread>
-#include <QtCore5Compat/QTextCodec>
-#include <QtCore/QTimer>
-
-#include <QtNetwork/QTcpSocket>
 
 AmcpDevice::AmcpDevice(const QString& address, int port, QObject* parent)
     : QObject(parent), address(address), port(port)
 {
-    this->socket = new QTcpSocket(this);
+    // The socket, line framing and reconnects live in their own thread, so socket I/O never waits on the GUI.
+    this->thread = new QThread(this);
+    this->thread->setObjectName(QString("AMCP %1:%2").arg(address).arg(port));
 
-    this->decoder = new QTextDecoder(QTextCodec::codecForName("UTF-8"));
+    this->connection = new AmcpConnection(address, port);
+    this->connection->moveToThread(this->thread);
 
-    QObject::connect(this->socket, SIGNAL(readyRead()), this, SLOT(readMessage()));
-    QObject::connect(this->socket, SIGNAL(connected()), this, SLOT(setConnected()));
-    QObject::connect(this->socket, SIGNAL(disconnected()), this, SLOT(setDisconnected()));
+    QObject::connect(this->thread, SIGNAL(finished()), this->connection, SLOT(deleteLater()));
+    QObject::connect(this->connection, SIGNAL(linesReceived(const QList<QString>&, qint64)), this, SLOT(receiveLines(const QList<QString>&, qint64)));
+    QObject::connect(this->connection, SIGNAL(connected()), this, SLOT(setConnected()));
+    QObject::connect(this->connection, SIGNAL(disconnected()), this, SLOT(setDisconnected()));
+
+    this->thread->start();
 }
 
 AmcpDevice::~AmcpDevice()
 {
-    delete this->decoder;
+    this->thread->quit();
+    this->thread->wait();
 }
 
 void AmcpDevice::connectDevice()
@@ -29,19 +36,20 @@ void AmcpDevice::connectDevice()
     if (this->connected)
         return;
 
-    this->socket->connectToHost(this->address, this->port);
-
-    QTimer::singleShot(5000, this, SLOT(connectDevice()));
+    QMetaObject::invokeMethod(this->connection, "connectDevice", Qt::QueuedConnection);
 }
 
 void AmcpDevice::disconnectDevice()
 {
-    this->socket->blockSignals(true);
-    this->socket->disconnectFromHost();
-    this->socket->blockSignals(false);
+    QMetaObject::invokeMethod(this->connection, "disconnectDevice", Qt::BlockingQueuedConnection);
 
     this->connected = false;
     this->command = AmcpDeviceCommand::CONNECTIONSTATE;
+    this->pendingRequests.clear();
+    this->responseCount = this->commandCount;
+    this->batch.clear();
+    this->batchCommands = 0;
+    this->batchRound.reset();
 
     sendNotification();
 }
@@ -58,10 +66,13 @@ void AmcpDevice::setDisconnected()
 {
     this->connected = false;
     this->command = AmcpDeviceCommand::CONNECTIONSTATE;
+    this->pendingRequests.clear();
+    this->responseCount = this->commandCount;
+    this->batch.clear();
+    this->batchCommands = 0;
+    this->batchRound.reset();
 
     sendNotification();
-
-    QTimer::singleShot(5000, this, SLOT(connectDevice()));
 }
 
 void AmcpDevice::setDisableCommands(bool disable)
@@ -69,11 +80,99 @@ void AmcpDevice::setDisableCommands(bool disable)
     this->disableCommands = disable;
 }
 
+void AmcpDevice::setPipelined(bool pipelined)
+{
+    this->pipelined = pipelined;
+}
+
+void AmcpDevice::setFanOut(bool fanOut, bool mirror)
+{
+    this->fanOut = fanOut;
+    this->mirror = mirror;
+}
+
+void AmcpDevice::setBatchWrites(bool batchWrites)
+{
+    this->batchWrites = batchWrites;
+
+    if (!this->batchWrites)
+        flushBatch();
+}
+
 bool AmcpDevice::isConnected() const
 {
     return this->connected;
 }
 
+bool AmcpDevice::isPipelined() const
+{
+    return this->pipelined;
+}
+
+bool AmcpDevice::isBatchWrites() const
+{
+    return this->batchWrites;
+}
+
+int AmcpDevice::getPendingRequestCount() const
+{
+    return this->pendingRequests.count();
+}
+
+int AmcpDevice::getCommandCount() const
+{
+    return this->commandCount;
+}
+
+int AmcpDevice::getResponseCount() const
+{
+    return this->responseCount;
+}
+
+int AmcpDevice::getQueueDepth() const
+{
+    // Every AMCP command is answered by exactly one response.
+    return qMax(0, this->commandCount - this->responseCount);
+}
+
+qint64 AmcpDevice::getBytesRead() const
+{
+    return this->bytesRead;
+}
+
+qint64 AmcpDevice::getBytesWritten() const
+{
+    return this->bytesWritten;
+}
+
+qint64 AmcpDevice::getWriteCount() const
+{
+    return this->connection->getWriteCount();
+}
+
+double AmcpDevice::getCommandsPerWrite() const
+{
+    qint64 writes = this->connection->getWriteCount();
+    if (writes == 0)
+        return 0;
+
+    return static_cast<double>(this->connection->getWrittenCommandCount()) / writes;
+}
+
+qint64 AmcpDevice::getAverageWriteLatency() const
+{
+    qint64 writes = this->connection->getWriteCount();
+    if (writes == 0)
+        return 0;
+
+    return this->connection->getWriteLatency() / writes;
+}
+
+qint64 AmcpDevice::getMaxWriteLatency() const
+{
+    return this->connection->getMaxWriteLatency();
+}
+
 int AmcpDevice::getPort() const
 {
     return this->port;
@@ -84,32 +183,92 @@ const QString& AmcpDevice::getAddress() const
     return this->address;
 }
 
-void AmcpDevice::writeMessage(const QString& message)
+quint64 AmcpDevice::writeMessage(const QString& message)
 {
-    if (this->connected && !this->disableCommands)
+    return writeMessage(this->builder.clear().text(QStringView(message).trimmed()));
+}
+
+quint64 AmcpDevice::writeMessage(const AmcpCommand& command)
+{
+    if (!this->connected || this->disableCommands || command.isEmpty())
+        return 0;
+
+    // Collect the commands issued during this event loop turn, they are handed to the I/O thread as one write.
+    if (this->batchWrites && this->batch.isEmpty())
+        QMetaObject::invokeMethod(this, "flushBatch", Qt::QueuedConnection);
+
+    // Batched commands are appended to the batch in place, otherwise the message is sized once.
+    QByteArray message;
+    QByteArray& data = (this->batchWrites) ? this->batch : message;
+    if (!this->batchWrites)
+        data.reserve(command.data().size() + 32);
+
+    qsizetype start = data.size();
+
+    quint64 id = 0;
+    if (this->pipelined)
     {
-        this->socket->write(QString("%1\r\n").arg(message.trimmed()).toUtf8());
-        this->socket->flush();
+        // Tag the command with REQ <id>, servers 2.2+ echo the id back as RES <id> in the reply header.
+        id = this->nextRequestId++;
+
+        this->pendingRequests.insert(id, QString::fromUtf8(command.data()));
 
-        qDebug("Sent message to %s:%d: %s\\r\\n", qPrintable(this->address), this->port, qPrintable(message.trimmed()));
+        char digits[24];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), id);
+
+        data.append("REQ ");
+        data.append(digits, result.ptr - digits);
+        data.append(' ');
     }
-}
 
-void AmcpDevice::readMessage()
-{
-    while (this->socket->bytesAvailable())
+    data.append(command.data());
+    data.append("\r\n");
+
+    // Devices taking part in a shadow fan-out share the dispatch round of this event loop turn, so the skew between them is recorded.
+    QSharedPointer<AmcpDispatchRound> round;
+    if (this->fanOut)
     {
-        this->fragments += this->decoder->toUnicode(this->socket->readAll());
+        round = AmcpDispatchRound::current();
+        round->join(this, this->mirror);
+    }
 
-        int position;
-        while ((position = this->fragments.indexOf("\r\n")) != -1)
-        {
-            QString line = this->fragments.left(position);
-            this->fragments.remove(0, position + 2);
+    if (this->batchWrites)
+    {
+        if (this->batchRound.isNull())
+            this->batchRound = round;
 
-            parseLine(line);
-        }
+        this->batchCommands++;
     }
+    else
+        this->connection->enqueueMessage(data, 1, round);
+
+    this->bytesWritten += data.size() - start;
+
+    this->commandCount++;
+
+    qDebug("Sent message to %s:%d: %.*s\\r\\n", qPrintable(this->address), this->port, static_cast<int>(data.size() - start - 2), data.constData() + start);
+
+    return id;
+}
+
+void AmcpDevice::flushBatch()
+{
+    if (this->batch.isEmpty())
+        return;
+
+    this->connection->enqueueMessage(this->batch, this->batchCommands, this->batchRound);
+
+    this->batch.clear();
+    this->batchCommands = 0;
+    this->batchRound.reset();
+}
+
+void AmcpDevice::receiveLines(const QList<QString>& lines, qint64 bytes)
+{
+    this->bytesRead += bytes;
+
+    foreach (const QString& line, lines)
+        parseLine(line);
 }
 
 AmcpDevice::AmcpDeviceCommand AmcpDevice::translateCommand(const QString& command)
@@ -142,6 +301,23 @@ AmcpDevice::AmcpDeviceCommand AmcpDevice::translateCommand(const QString& comman
     return AmcpDeviceCommand::NONE;
 }
 
+AmcpDevice::AmcpDeviceCommand AmcpDevice::translateRequest(const QString& request)
+{
+    QStringList tokens = request.toUpper().split(" ", Qt::SkipEmptyParts);
+    if (tokens.isEmpty())
+        return AmcpDeviceCommand::NONE;
+
+    // Two word commands (INFO SYSTEM, DATA LIST, THUMBNAIL RETRIEVE...) take precedence.
+    if (tokens.count() > 1)
+    {
+        AmcpDeviceCommand command = translateCommand(QString("%1 %2").arg(tokens.at(0)).arg(tokens.at(1)));
+        if (command != AmcpDeviceCommand::NONE)
+            return command;
+    }
+
+    return translateCommand(tokens.at(0));
+}
+
 void AmcpDevice::parseLine(const QString& line)
 {
     switch (this->state)
@@ -168,8 +344,27 @@ void AmcpDevice::parseHeader(const QString& line)
     if (line.length() == 0)
         return;
 
+    QString header = line;
     QStringList tokens = line.split(" ");
 
+    // Pipelined replies are prefixed with RES <id>, match them with the pending request.
+    if (tokens.count() > 2 && tokens.at(0) == "RES")
+    {
+        this->requestId = tokens.at(1).toULongLong();
+        this->request = this->pendingRequests.take(this->requestId);
+
+        // The server answers in order, requests issued before this one that were never echoed will not be.
+        QMutableHashIterator<quint64, QString> iterator(this->pendingRequests);
+        while (iterator.hasNext())
+        {
+            if (iterator.next().key() < this->requestId)
+                iterator.remove();
+        }
+
+        header = line.section(' ', 2);
+        tokens = header.split(" ");
+    }
+
     this->code = tokens.at(0).toInt();
     switch (this->code)
     {
@@ -181,21 +376,30 @@ void AmcpDevice::parseHeader(const QString& line)
             this->state = AmcpDeviceParserState::ExpectingTwoline;
             break;
         default:
-            parseOneline(line);
+            parseOneline(header);
             return;
     }
 
-    this->command = translateCommand(tokens.at(1));
-    if (tokens.count() > 3)
-        this->command = translateCommand(QString("%1 %2").arg(tokens.at(1)).arg(tokens.at(2)));
+    // A rejected request is reported as the error it is, not as the reply of the command that was sent.
+    if (this->code != 400 && !this->request.isEmpty())
+        this->command = translateRequest(this->request);
+
+    if (this->command == AmcpDeviceCommand::NONE)
+    {
+        this->command = translateCommand(tokens.at(1));
+        if (tokens.count() > 3)
+            this->command = translateCommand(QString("%1 %2").arg(tokens.at(1)).arg(tokens.at(2)));
+    }
 
-    this->response.append(line);
+    this->response.append(header);
 }
 
 void AmcpDevice::parseOneline(const QString& line)
 {
     AmcpDevice::response.append(line);
 
+    this->responseCount++;
+
     sendNotification();
 }
 
@@ -204,20 +408,37 @@ void AmcpDevice::parseTwoline(const QString& line)
     AmcpDevice::response.append(line);
 
     if (AmcpDevice::response.count() == 2)
+    {
+        this->responseCount++;
+
         sendNotification();
+    }
 }
 
 void AmcpDevice::parseMultiline(const QString& line)
 {
     if (line.length() == 0)
+    {
+        this->responseCount++;
+
         sendNotification();
-    else
+    }
+    else if (!parseItem(line))
         AmcpDevice::response.append(line);
 }
 
+bool AmcpDevice::parseItem(const QString& line)
+{
+    Q_UNUSED(line);
+
+    return false;
+}
+
 void AmcpDevice::resetDevice()
 {
     this->code = 0;
+    this->requestId = 0;
+    this->request.clear();
     this->response.clear();
     this->command = AmcpDeviceCommand::NONE;
     this->state = AmcpDeviceParserState::ExpectingHeader;
@@ -2,11 +2,20 @@
 
 #include "Shared.h"
 
+#include "AmcpCommand.h"
+#include "AmcpDispatchRound.h"
+
+#include <cstddef>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
 #include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+
+class AmcpConnection;
 
 class QObject;
-class QTcpSocket;
-class QTextDecoder;
+class QThread;
 
 class CASPAR_EXPORT AmcpDevice : public QObject
 {
@@ -19,8 +28,23 @@ class CASPAR_EXPORT AmcpDevice : public QObject
         void disconnectDevice();
 
         void setDisableCommands(bool disable);
+        void setPipelined(bool pipelined);
+        void setBatchWrites(bool batchWrites);
+        void setFanOut(bool fanOut, bool mirror);
 
         bool isConnected() const;
+        bool isPipelined() const;
+        bool isBatchWrites() const;
+        int getPendingRequestCount() const;
+        int getCommandCount() const;
+        int getResponseCount() const;
+        int getQueueDepth() const;
+        qint64 getBytesRead() const;
+        qint64 getBytesWritten() const;
+        qint64 getWriteCount() const;
+        double getCommandsPerWrite() const;
+        qint64 getAverageWriteLatency() const;
+        qint64 getMaxWriteLatency() const;
         int getPort() const;
         const QString& getAddress() const;
 
@@ -57,15 +81,25 @@ class CASPAR_EXPORT AmcpDevice : public QObject
             THUMBNAILRETRIEVE
         };
 
-        QTcpSocket* socket = nullptr;
         AmcpDeviceCommand command = AmcpDeviceCommand::NONE;
 
         QList<QString> response;
 
+        quint64 requestId = 0;
+        QString request;
+
         virtual void sendNotification() = 0;
+        virtual bool parseItem(const QString& line);
 
         void resetDevice();
-        void writeMessage(const QString& message);
+        quint64 writeMessage(const QString& message);
+        quint64 writeMessage(const AmcpCommand& command);
+
+        template <std::size_t N>
+        AmcpCommand& beginCommand(const char (&keyword)[N])
+        {
+            return this->builder.clear().keyword(keyword);
+        }
 
     private:
         enum class AmcpDeviceParserState
@@ -83,10 +117,27 @@ class CASPAR_EXPORT AmcpDevice : public QObject
 
         bool connected = false;
         bool disableCommands = false;
+        bool pipelined = false;
+        bool batchWrites = false;
+        bool fanOut = false;
+        bool mirror = false;
+
+        int commandCount = 0;
+        int responseCount = 0;
+        qint64 bytesRead = 0;
+        qint64 bytesWritten = 0;
+
+        int batchCommands = 0;
+        QByteArray batch;
+        QSharedPointer<AmcpDispatchRound> batchRound;
+
+        AmcpCommand builder;
 
-        QString fragments;
+        quint64 nextRequestId = 1;
+        QHash<quint64, QString> pendingRequests;
 
-        QTextDecoder* decoder = nullptr;
+        QThread* thread = nullptr;
+        AmcpConnection* connection = nullptr;
 
         AmcpDeviceParserState state = AmcpDeviceParserState::ExpectingHeader;
 
@@ -97,8 +148,10 @@ class CASPAR_EXPORT AmcpDevice : public QObject
         void parseMultiline(const QString& line);
 
         AmcpDeviceCommand translateCommand(const QString& command);
+        AmcpDeviceCommand translateRequest(const QString& request);
 
-        Q_SLOT void readMessage();
+        Q_SLOT void flushBatch();
+        Q_SLOT void receiveLines(const QList<QString>& lines, qint64 bytes);
         Q_SLOT void setConnected();
         Q_SLOT void setDisconnected();
 };
@@ -0,0 +1,85 @@
+#include "AmcpDispatchRound.h"
+
+#include <limits>
+
+#include <QtCore/QTimer>
+
+std::atomic<qint64> AmcpDispatchRound::roundCount(0);
+std::atomic<qint64> AmcpDispatchRound::totalSkew(0);
+std::atomic<qint64> AmcpDispatchRound::maxSkew(0);
+
+AmcpDispatchRound::AmcpDispatchRound()
+    : firstWrite(std::numeric_limits<qint64>::max()), lastWrite(-1)
+{
+    this->timer.start();
+}
+
+AmcpDispatchRound::~AmcpDispatchRound()
+{
+    // The last reference goes away once every device has written its part, the round is complete.
+    // Only rounds where a primary and at least one mirror took part are recorded.
+    if (!this->mirrored || this->devices.count() < 2 || this->lastWrite.load() < 0)
+        return;
+
+    qint64 skew = (this->lastWrite.load() - this->firstWrite.load()) / 1000;
+
+    AmcpDispatchRound::roundCount.fetch_add(1, std::memory_order_relaxed);
+    AmcpDispatchRound::totalSkew.fetch_add(skew, std::memory_order_relaxed);
+
+    qint64 max = AmcpDispatchRound::maxSkew.load(std::memory_order_relaxed);
+    while (skew > max && !AmcpDispatchRound::maxSkew.compare_exchange_weak(max, skew, std::memory_order_relaxed))
+        ;
+}
+
+QSharedPointer<AmcpDispatchRound> AmcpDispatchRound::current()
+{
+    // Everything written during one event loop turn belongs to the same round,
+    // e.g. a playout command and its copies to the shadow servers.
+    static QSharedPointer<AmcpDispatchRound> round;
+    if (round.isNull())
+    {
+        round.reset(new AmcpDispatchRound());
+        QTimer::singleShot(0, [] { round.reset(); });
+    }
+
+    return round;
+}
+
+qint64 AmcpDispatchRound::getRoundCount()
+{
+    return AmcpDispatchRound::roundCount.load(std::memory_order_relaxed);
+}
+
+qint64 AmcpDispatchRound::getAverageSkew()
+{
+    qint64 rounds = AmcpDispatchRound::roundCount.load(std::memory_order_relaxed);
+    if (rounds == 0)
+        return 0;
+
+    return AmcpDispatchRound::totalSkew.load(std::memory_order_relaxed) / rounds;
+}
+
+qint64 AmcpDispatchRound::getMaxSkew()
+{
+    return AmcpDispatchRound::maxSkew.load(std::memory_order_relaxed);
+}
+
+void AmcpDispatchRound::join(const void* device, bool mirror)
+{
+    this->devices.insert(device);
+    this->mirrored = this->mirrored || mirror;
+}
+
+void AmcpDispatchRound::written()
+{
+    // Called from the I/O threads, keep the first and the last socket write of the round.
+    qint64 now = this->timer.nsecsElapsed();
+
+    qint64 first = this->firstWrite.load(std::memory_order_relaxed);
+    while (now < first && !this->firstWrite.compare_exchange_weak(first, now, std::memory_order_relaxed))
+        ;
+
+    qint64 last = this->lastWrite.load(std::memory_order_relaxed);
+    while (now > last && !this->lastWrite.compare_exchange_weak(last, now, std::memory_order_relaxed))
+        ;
+}
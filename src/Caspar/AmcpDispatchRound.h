@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Shared.h"
+
+#include <atomic>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QSet>
+#include <QtCore/QSharedPointer>
+
+class CASPAR_EXPORT AmcpDispatchRound
+{
+    public:
+        explicit AmcpDispatchRound();
+        ~AmcpDispatchRound();
+
+        static QSharedPointer<AmcpDispatchRound> current();
+
+        static qint64 getRoundCount();
+        static qint64 getAverageSkew();
+        static qint64 getMaxSkew();
+
+        void join(const void* device, bool mirror);
+        void written();
+
+    private:
+        QElapsedTimer timer;
+        QSet<const void*> devices;
+        bool mirrored = false;
+
+        std::atomic<qint64> firstWrite;
+        std::atomic<qint64> lastWrite;
+
+        static std::atomic<qint64> roundCount;
+        static std::atomic<qint64> totalSkew;
+        static std::atomic<qint64> maxSkew;
+};
@@ -0,0 +1,53 @@
+#include "AmcpLineParser.h"
+
+#include <cstring>
+
+AmcpLineParser::AmcpLineParser()
+{
+}
+
+void AmcpLineParser::append(const QByteArray& data)
+{
+    // Drop the lines already parsed before appending, only the unterminated tail is moved.
+    if (this->bufferOffset > 0)
+    {
+        this->buffer.remove(0, this->bufferOffset);
+        this->bufferScanned -= this->bufferOffset;
+        this->bufferOffset = 0;
+    }
+
+    this->buffer.append(data);
+}
+
+void AmcpLineParser::parse(QList<QString>& lines)
+{
+    // Scan the raw bytes for CRLF, bytes already scanned for an unterminated line are skipped.
+    this->bufferScanned = qMax(this->bufferOffset, this->bufferScanned);
+    while (this->bufferScanned < this->buffer.size())
+    {
+        const char* data = this->buffer.constData();
+        const char* newline = static_cast<const char*>(std::memchr(data + this->bufferScanned, '\n', this->buffer.size() - this->bufferScanned));
+        if (newline == nullptr)
+        {
+            this->bufferScanned = this->buffer.size();
+            break;
+        }
+
+        this->bufferScanned = (newline - data) + 1;
+        if (newline == data + this->bufferOffset || *(newline - 1) != '\r')
+            continue; // Bare LF, not a line terminator.
+
+        const char* begin = data + this->bufferOffset;
+        this->bufferOffset = this->bufferScanned;
+
+        // Only complete lines are decoded, so a multibyte character is never split between two reads.
+        lines.append(QString::fromUtf8(begin, (newline - 1) - begin));
+    }
+}
+
+void AmcpLineParser::clear()
+{
+    this->buffer.clear();
+    this->bufferOffset = 0;
+    this->bufferScanned = 0;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Shared.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+class CASPAR_EXPORT AmcpLineParser
+{
+    public:
+        explicit AmcpLineParser();
+
+        void append(const QByteArray& data);
+        void parse(QList<QString>& lines);
+        void clear();
+
+    private:
+        QByteArray buffer;
+        qsizetype bufferOffset = 0;
+        qsizetype bufferScanned = 0;
+};
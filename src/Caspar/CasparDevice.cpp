@@ -1,237 +1,233 @@
 #include "CasparDevice.h"
 
+#include "HostResolver.h"
 #include "Timecode.h"
 
 #include "../Core/DatabaseManager.h"
 
 #include <QtCore/QStringList>
 
-#include <QtNetwork/QHostInfo>
-
 CasparDevice::CasparDevice(const QString& address, int port, QObject* parent)
     : AmcpDevice(address, port, parent)
 {
+    HostResolver::getInstance().prefetch(address);
 }
 
 const QString CasparDevice::resolveIpAddress() const
 {
-    if (AmcpDevice::getAddress() == "localhost")
-        return "127.0.0.1";
-
-    QHostAddress address(AmcpDevice::getAddress());
-    if (!address.isNull())
-        return getAddress(); // The ip address is valid.
+    return HostResolver::getInstance().resolve(AmcpDevice::getAddress());
+}
 
-    // We don't have a valid ip address. Try to resolve using dns lookup.
-    QHostInfo hostInfo = QHostInfo::fromName(AmcpDevice::getAddress());
-    if (hostInfo.error() != QHostInfo::NoError)
-        return "";
+bool CasparDevice::supportsPipelining(const QString& version)
+{
+    // Request ids (REQ / RES) were introduced in server 2.2.
+    QStringList tokens = version.trimmed().split(" ").at(0).split(".");
+    if (tokens.count() < 2)
+        return false;
 
-    if (hostInfo.addresses().isEmpty())
-        return "";
+    int major = tokens.at(0).toInt();
+    int minor = tokens.at(1).toInt();
 
-    return hostInfo.addresses().at(0).toString();
+    return major > 2 || (major == 2 && minor >= 2);
 }
 
 void CasparDevice::refreshData()
 {
-    writeMessage("DATA LIST");
+    writeMessage(beginCommand("DATA").keyword("LIST"));
 }
 
 void CasparDevice::refreshFlashVersion()
 {
-    writeMessage("VERSION FLASH");
+    writeMessage(beginCommand("VERSION").keyword("FLASH"));
 }
 
 void CasparDevice::refreshServerVersion()
 {
-    writeMessage("VERSION SERVER");
+    writeMessage(beginCommand("VERSION").keyword("SERVER"));
 }
 
 void CasparDevice::refreshTemplateHostVersion()
 {
-    writeMessage("VERSION TEMPLATEHOST");
+    writeMessage(beginCommand("VERSION").keyword("TEMPLATEHOST"));
 }
 
 void CasparDevice::refreshMedia()
 {
-    writeMessage("CLS");
+    writeMessage(beginCommand("CLS"));
 }
 
 void CasparDevice::refreshTemplate()
 {
-    writeMessage("TLS");
+    writeMessage(beginCommand("TLS"));
 }
 
 void CasparDevice::refreshChannels()
 {
-    writeMessage("INFO");
+    writeMessage(beginCommand("INFO"));
 }
 
 void CasparDevice::refreshThumbnail()
 {
-    writeMessage("THUMBNAIL LIST");
+    writeMessage(beginCommand("THUMBNAIL").keyword("LIST"));
 }
 
-void CasparDevice::retrieveThumbnail(const QString& name)
+quint64 CasparDevice::retrieveThumbnail(const QString& name)
 {
-    writeMessage(QString("THUMBNAIL RETRIEVE \"%1\"").arg(name));
+    return writeMessage(beginCommand("THUMBNAIL").keyword("RETRIEVE").quoted(name));
 }
 
-void CasparDevice::sendCommand(const QString& command)
+quint64 CasparDevice::sendCommand(const QString& command)
 {
-    writeMessage(QString("%1").arg(command));
+    return writeMessage(command);
 }
 
 void CasparDevice::clearChannel(int channel)
 {
-    writeMessage(QString("CLEAR %1").arg(channel));
+    writeMessage(beginCommand("CLEAR").number(channel));
 }
 
 void CasparDevice::clearMixerChannel(int channel)
 {
-    writeMessage(QString("MIXER %1 CLEAR").arg(channel));
+    writeMessage(beginCommand("MIXER").number(channel).keyword("CLEAR"));
 }
 
 void CasparDevice::clearVideolayer(int channel, int videolayer)
 {
-    writeMessage(QString("CLEAR %1-%2").arg(channel).arg(videolayer));
+    writeMessage(beginCommand("CLEAR").layer(channel, videolayer));
 }
 
 void CasparDevice::clearMixerVideolayer(int channel, int videolayer)
 {
-    writeMessage(QString("MIXER %1-%2 CLEAR").arg(channel).arg(videolayer));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("CLEAR"));
 }
 
 void CasparDevice::pause(int channel, int videolayer)
 {
-    writeMessage(QString("PAUSE %1-%2").arg(channel).arg(videolayer));
+    writeMessage(beginCommand("PAUSE").layer(channel, videolayer));
 }
 
 void CasparDevice::resume(int channel, int videolayer)
 {
-    writeMessage(QString("RESUME %1-%2").arg(channel).arg(videolayer));
+    writeMessage(beginCommand("RESUME").layer(channel, videolayer));
 }
 
 void CasparDevice::stop(int channel, int videolayer)
 {
-    writeMessage(QString("STOP %1-%2").arg(channel).arg(videolayer));
+    writeMessage(beginCommand("STOP").layer(channel, videolayer));
 }
 
 void CasparDevice::play(int channel, int videolayer)
 {
-    writeMessage(QString("PLAY %1-%2").arg(channel).arg(videolayer));
+    writeMessage(beginCommand("PLAY").layer(channel, videolayer));
 }
 
 void CasparDevice::print(int channel, const QString& output)
 {
-    writeMessage(QString("ADD %1 IMAGE \"%2\"").arg(channel).arg(output));
+    writeMessage(beginCommand("ADD").number(channel).keyword("IMAGE").quoted(output));
 }
 
 void CasparDevice::loadRouteChannel(int toChannel, int toVideolayer, int fromChannel)
 {
-    writeMessage(QString("LOADBG %1-%2 route://%3").arg(toChannel).arg(toVideolayer).arg(fromChannel));
+    writeMessage(beginCommand("LOADBG").layer(toChannel, toVideolayer).keyword("route://").append(fromChannel));
 }
 
 void CasparDevice::loadRouteChannel(int toChannel, int toVideolayer, int fromChannel, int outputDelay)
 {
-    writeMessage(QString("LOADBG %1-%2 route://%3 FRAMES_DELAY %4").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(outputDelay));
+    writeMessage(beginCommand("LOADBG").layer(toChannel, toVideolayer).keyword("route://").append(fromChannel)
+                 .keyword("FRAMES_DELAY").number(outputDelay));
 }
 
 void CasparDevice::playRouteChannel(int toChannel, int toVideolayer, int fromChannel)
 {
-    writeMessage(QString("PLAY %1-%2 route://%3").arg(toChannel).arg(toVideolayer).arg(fromChannel));
+    writeMessage(beginCommand("PLAY").layer(toChannel, toVideolayer).keyword("route://").append(fromChannel));
 }
 
 void CasparDevice::playRouteChannel(int toChannel, int toVideolayer, int fromChannel, int outputDelay)
 {
-    writeMessage(QString("PLAY %1-%2 route://%3 FRAMES_DELAY %4").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(outputDelay));
+    writeMessage(beginCommand("PLAY").layer(toChannel, toVideolayer).keyword("route://").append(fromChannel)
+                 .keyword("FRAMES_DELAY").number(outputDelay));
 }
 
 void CasparDevice::loadRouteVideolayer(int toChannel, int toVideolayer, int fromChannel, int fromVideolayer)
 {
-    writeMessage(QString("LOADBG %1-%2 route://%3-%4").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(fromVideolayer));
+    writeMessage(beginCommand("LOADBG").layer(toChannel, toVideolayer)
+                 .keyword("route://").append(fromChannel).append("-").append(fromVideolayer));
 }
 
 void CasparDevice::loadRouteVideolayer(int toChannel, int toVideolayer, int fromChannel, int fromVideolayer, int outputDelay)
 {
-    writeMessage(QString("LOADBG %1-%2 route://%3-%4 FRAMES_DELAY %5").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(fromVideolayer).arg(outputDelay));
+    writeMessage(beginCommand("LOADBG").layer(toChannel, toVideolayer)
+                 .keyword("route://").append(fromChannel).append("-").append(fromVideolayer)
+                 .keyword("FRAMES_DELAY").number(outputDelay));
 }
 
 void CasparDevice::playRouteVideolayer(int toChannel, int toVideolayer, int fromChannel, int fromVideolayer)
 {
-    writeMessage(QString("PLAY %1-%2 route://%3-%4").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(fromVideolayer));
+    writeMessage(beginCommand("PLAY").layer(toChannel, toVideolayer)
+                 .keyword("route://").append(fromChannel).append("-").append(fromVideolayer));
 }
 
 void CasparDevice::playRouteVideolayer(int toChannel, int toVideolayer, int fromChannel, int fromVideolayer, int outputDelay)
 {
-    writeMessage(QString("PLAY %1-%2 route://%3-%4 FRAMES_DELAY %5").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(fromVideolayer).arg(outputDelay));
+    writeMessage(beginCommand("PLAY").layer(toChannel, toVideolayer)
+                 .keyword("route://").append(fromChannel).append("-").append(fromVideolayer)
+                 .keyword("FRAMES_DELAY").number(outputDelay));
 }
 
 void CasparDevice::addTemplate(int channel, int videolayer, int flashlayer, const QString& name, bool playOnLoad)
 {
-    writeMessage(QString("CG %1-%2 ADD %3 \"%4\" %5")
-                 .arg(channel).arg(videolayer).arg(flashlayer).arg(name)
-                 .arg((playOnLoad == true) ? "1" : "0"));
+    writeMessage(beginCommand("CG").layer(channel, videolayer).keyword("ADD").number(flashlayer).quoted(name)
+                 .number((playOnLoad == true) ? 1 : 0));
 }
 
 void CasparDevice::addTemplate(int channel, int videolayer, int flashlayer, const QString& name, bool playOnLoad,
                                const QString& data)
 {
-    writeMessage(QString("CG %1-%2 ADD %3 %4 \"%5\" \"%6\"")
-                 .arg(channel).arg(videolayer).arg(flashlayer).arg(name)
-                 .arg((playOnLoad == true) ? "1" : "0").arg(data));
+    writeMessage(beginCommand("CG").layer(channel, videolayer).keyword("ADD").number(flashlayer).text(name)
+                 .keyword((playOnLoad == true) ? "\"1\"" : "\"0\"").quoted(data));
 }
 
 void CasparDevice::invokeTemplate(int channel, int videolayer, int flashlayer, const QString& label)
 {
-    QString value = label;
-    value = value.replace("\\", "\\\\").replace("\"", "\\\""); // Escape possibly HTML params.
-
-    writeMessage(QString("CG %1-%2 INVOKE %3 \"%4\"")
-                 .arg(channel).arg(videolayer).arg(flashlayer).arg(value));
+    // Escape possibly HTML params.
+    writeMessage(beginCommand("CG").layer(channel, videolayer).keyword("INVOKE").number(flashlayer).escaped(label));
 }
 
 void CasparDevice::nextTemplate(int channel, int videolayer, int flashlayer)
 {
-    writeMessage(QString("CG %1-%2 NEXT %3")
-                 .arg(channel).arg(videolayer).arg(flashlayer));
+    writeMessage(beginCommand("CG").layer(channel, videolayer).keyword("NEXT").number(flashlayer));
 }
 
 void CasparDevice::playTemplate(int channel, int videolayer, int flashlayer)
 {
-    writeMessage(QString("CG %1-%2 PLAY %3")
-                 .arg(channel).arg(videolayer).arg(flashlayer));
+    writeMessage(beginCommand("CG").layer(channel, videolayer).keyword("PLAY").number(flashlayer));
 }
 
 void CasparDevice::playTemplate(int channel, int videolayer, int flashlayer, const QString& name)
 {
-    writeMessage(QString("CG %1-%2 ADD %3 \"%4\" 1")
-                 .arg(channel).arg(videolayer).arg(flashlayer).arg(name));
+    writeMessage(beginCommand("CG").layer(channel, videolayer).keyword("ADD").number(flashlayer).quoted(name)
+                 .number(1));
 }
 
 void CasparDevice::playTemplate(int channel, int videolayer, int flashlayer, const QString& name, const QString& data)
 {
-    writeMessage(QString("CG %1-%2 ADD %3 \"%4\" 1 \"%5\"")
-                 .arg(channel).arg(videolayer).arg(flashlayer).arg(name).arg(data));
+    writeMessage(beginCommand("CG").layer(channel, videolayer).keyword("ADD").number(flashlayer).quoted(name)
+                 .number(1).quoted(data));
 }
 
 void CasparDevice::removeTemplate(int channel, int videolayer, int flashlayer)
 {
-    writeMessage(QString("CG %1-%2 REMOVE %3")
-                 .arg(channel).arg(videolayer).arg(flashlayer));
+    writeMessage(beginCommand("CG").layer(channel, videolayer).keyword("REMOVE").number(flashlayer));
 }
 
 void CasparDevice::stopTemplate(int channel, int videolayer, int flashlayer)
 {
-    writeMessage(QString("CG %1-%2 STOP %3")
-                 .arg(channel).arg(videolayer).arg(flashlayer));
+    writeMessage(beginCommand("CG").layer(channel, videolayer).keyword("STOP").number(flashlayer));
 }
 
 void CasparDevice::updateTemplate(int channel, int videolayer, int flashlayer, const QString& data)
 {
-    writeMessage(QString("CG %1-%2 UPDATE %3 \"%4\"")
-                 .arg(channel).arg(videolayer).arg(flashlayer).arg(data));
+    writeMessage(beginCommand("CG").layer(channel, videolayer).keyword("UPDATE").number(flashlayer).quoted(data));
 }
 
 void CasparDevice::playHtml(int channel, int videolayer, const QString& url, const QString& transition, int duration,
@@ -240,19 +236,17 @@ void CasparDevice::playHtml(int channel, int videolayer, const QString& url, con
     if (useAuto)
         loadHtml(channel, videolayer, url, transition, duration, easing, direction, false, useAuto);
     else
-        writeMessage(QString("PLAY %1-%2 [HTML] \"%3\" %4 %5 %6 %7")
-                     .arg(channel).arg(videolayer).arg(url).arg(transition).arg(duration).arg(easing)
-                     .arg(direction));
+        writeMessage(beginCommand("PLAY").layer(channel, videolayer).keyword("[HTML]").quoted(url)
+                     .text(transition).number(duration).text(easing).text(direction));
 }
 
 void CasparDevice::loadHtml(int channel, int videolayer, const QString& url, const QString& transition, int duration,
                             const QString& easing, const QString& direction, bool freezeOnLoad, bool useAuto)
 {
-    writeMessage(QString("%1 %2-%3 [HTML] \"%4\" %5 %6 %7 %8 %9")
-                 .arg((freezeOnLoad == true) ? "LOAD" : "LOADBG")
-                 .arg(channel).arg(videolayer).arg(url).arg(transition).arg(duration).arg(easing)
-                 .arg(direction)
-                 .arg((useAuto == true) ? "AUTO" : ""));
+    AmcpCommand& message = (freezeOnLoad == true) ? beginCommand("LOAD") : beginCommand("LOADBG");
+    writeMessage(message.layer(channel, videolayer).keyword("[HTML]").quoted(url)
+                 .text(transition).number(duration).text(easing).text(direction)
+                 .option(useAuto, "AUTO"));
 }
 
 void CasparDevice::playMovie(int channel, int videolayer, const QString& name, const QString& transition, int duration,
@@ -261,26 +255,33 @@ void CasparDevice::playMovie(int channel, int videolayer, const QString& name, c
     if (useAuto)
         loadMovie(channel, videolayer, name, transition, duration, easing, direction, seek, length, loop, false, useAuto);
     else
-        writeMessage(QString("PLAY %1-%2 \"%3\" %4 %5 %6 %7 %8 %9 %10")
-                     .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
-                     .arg(direction)
-                     .arg((seek > 0) ? QString("SEEK %1").arg(seek) : "")
-                     .arg((length > 0) ? QString("LENGTH %1").arg(length) : "")
-                     .arg((loop == true) ? "LOOP" : ""));
+    {
+        AmcpCommand& message = beginCommand("PLAY").layer(channel, videolayer).quoted(name)
+                               .text(transition).number(duration).text(easing).text(direction);
+        if (seek > 0)
+            message.keyword("SEEK").number(seek);
+
+        if (length > 0)
+            message.keyword("LENGTH").number(length);
+
+        writeMessage(message.option(loop, "LOOP"));
+    }
 }
 
 void CasparDevice::loadMovie(int channel, int videolayer, const QString& name, const QString& transition, int duration,
                              const QString& easing, const QString& direction, int seek, int length, bool loop,
                              bool freezeOnLoad, bool useAuto)
 {
-    writeMessage(QString("%1 %2-%3 \"%4\" %5 %6 %7 %8 %9 %10 %11 %12")
-                 .arg((freezeOnLoad == true) ? "LOAD" : "LOADBG")
-                 .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
-                 .arg(direction)
-                 .arg((seek > 0) ? QString("SEEK %1").arg(seek) : "")
-                 .arg((length > 0) ? QString("LENGTH %1").arg(length) : "")
-                 .arg((loop == true) ? "LOOP" : "")
-                 .arg((useAuto == true) ? "AUTO" : ""));
+    AmcpCommand& message = (freezeOnLoad == true) ? beginCommand("LOAD") : beginCommand("LOADBG");
+    message.layer(channel, videolayer).quoted(name)
+           .text(transition).number(duration).text(easing).text(direction);
+    if (seek > 0)
+        message.keyword("SEEK").number(seek);
+
+    if (length > 0)
+        message.keyword("LENGTH").number(length);
+
+    writeMessage(message.option(loop, "LOOP").option(useAuto, "AUTO"));
 }
 
 void CasparDevice::playAudio(int channel, int videolayer, const QString& name, const QString& transition, int duration,
@@ -289,20 +290,17 @@ void CasparDevice::playAudio(int channel, int videolayer, const QString& name, c
     if (useAuto)
         loadAudio(channel, videolayer, name, transition, duration, easing, direction, loop, useAuto);
     else
-        writeMessage(QString("PLAY %1-%2 \"%3\" %4 %5 %6 %7 %8")
-                     .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
-                     .arg(direction)
-                     .arg((loop == true) ? "LOOP" : ""));
+        writeMessage(beginCommand("PLAY").layer(channel, videolayer).quoted(name)
+                     .text(transition).number(duration).text(easing).text(direction)
+                     .option(loop, "LOOP"));
 }
 
 void CasparDevice::loadAudio(int channel, int videolayer, const QString& name, const QString& transition, int duration,
                              const QString& easing, const QString& direction, bool loop, bool useAuto)
 {
-    writeMessage(QString("LOADBG %1-%2 \"%3\" %4 %5 %6 %7 %8 %9")
-                 .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
-                 .arg(direction)
-                 .arg((loop == true) ? "LOOP" : "")
-                 .arg((useAuto == true) ? "AUTO" : ""));
+    writeMessage(beginCommand("LOADBG").layer(channel, videolayer).quoted(name)
+                 .text(transition).number(duration).text(easing).text(direction)
+                 .option(loop, "LOOP").option(useAuto, "AUTO"));
 }
 
 void CasparDevice::playColor(int channel, int videolayer, const QString& color, const QString &transition, int duration,
@@ -311,18 +309,16 @@ void CasparDevice::playColor(int channel, int videolayer, const QString& color,
     if (useAuto)
         loadColor(channel, videolayer, color, transition, duration, easing, direction, useAuto);
     else
-        writeMessage(QString("PLAY %1-%2 \"%3\" %4 %5 %6 %7")
-                     .arg(channel).arg(videolayer).arg(color).arg(transition).arg(duration).arg(easing)
-                     .arg(direction));
+        writeMessage(beginCommand("PLAY").layer(channel, videolayer).quoted(color)
+                     .text(transition).number(duration).text(easing).text(direction));
 }
 
 void CasparDevice::loadColor(int channel, int videolayer, const QString& color, const QString& transition, int duration,
                              const QString& easing, const QString& direction, bool useAuto)
 {
-    writeMessage(QString("LOADBG %1-%2 \"%3\" %4 %5 %6 %7 %8")
-                 .arg(channel).arg(videolayer).arg(color).arg(transition).arg(duration).arg(easing)
-                 .arg(direction)
-                 .arg((useAuto == true) ? "AUTO" : ""));
+    writeMessage(beginCommand("LOADBG").layer(channel, videolayer).quoted(color)
+                 .text(transition).number(duration).text(easing).text(direction)
+                 .option(useAuto, "AUTO"));
 }
 
 void CasparDevice::playStill(int channel, int videolayer, const QString& name, const QString& transition, int duration,
@@ -331,319 +327,383 @@ void CasparDevice::playStill(int channel, int videolayer, const QString& name, c
     if (useAuto)
         loadStill(channel, videolayer, name, transition, duration, easing, direction, useAuto);
     else
-        writeMessage(QString("PLAY %1-%2 \"%3\" %4 %5 %6 %7")
-                     .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
-                     .arg(direction));
+        writeMessage(beginCommand("PLAY").layer(channel, videolayer).quoted(name)
+                     .text(transition).number(duration).text(easing).text(direction));
 }
 
 void CasparDevice::loadStill(int channel, int videolayer, const QString& name, const QString& transition, int duration,
                              const QString& easing, const QString& direction, bool useAuto)
 {
-    writeMessage(QString("LOADBG %1-%2 \"%3\" %4 %5 %6 %7")
-                 .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
-                 .arg(direction)
-                 .arg((useAuto == true) ? "AUTO" : ""));
+    writeMessage(beginCommand("LOADBG").layer(channel, videolayer).quoted(name)
+                 .text(transition).number(duration).text(easing).text(direction)
+                 .option(useAuto, "AUTO"));
 }
 
 void CasparDevice::startFileRecorder(int channel, const QString& filename, const QString& preset, bool withAlpha)
 {
-    writeMessage(QString("ADD %1-%2 FILE \"%3\" %4 %5")
-                 .arg(channel)
-                 .arg(QString("%1").arg(qChecksum(filename.toUtf8())))
-                 .arg(filename)
-                 .arg((preset != "") ? preset : "")
-                 .arg((withAlpha == true) ? "SEPARATE_KEY" : ""));
+    writeMessage(beginCommand("ADD").layer(channel, qChecksum(filename.toUtf8())).keyword("FILE").quoted(filename)
+                 .text(preset)
+                 .option(withAlpha, "SEPARATE_KEY"));
 }
 
 void CasparDevice::stopFileRecorder(int channel, const QString& filename)
 {
-    writeMessage(QString("REMOVE %1-%2 FILE")
-                 .arg(channel)
-                 .arg(QString("%1").arg(qChecksum(filename.toUtf8()))));
+    writeMessage(beginCommand("REMOVE").layer(channel, qChecksum(filename.toUtf8())).keyword("FILE"));
 }
 
 void CasparDevice::startStream(int channel, int port, int quality, bool key, int width, int height)
 {
+    AmcpCommand& message = beginCommand("ADD").number(channel).keyword("STREAM").keyword("udp://<client_ip_address>:").append(port)
+                           .keyword("-format mpegts -codec:v libx264 -crf:v").number(quality)
+                           .keyword("-tune:v zerolatency -preset:v ultrafast");
     if (width > 0 && height > 0)
     {
-        //writeMessage(QString("ADD %1 STREAM udp://<client_ip_address>:%2 -format mpegts -codec:v libx264 -crf:v %3 -tune:v zerolatency -preset:v ultrafast -filter:v scale=%4:%5%6")
-          //           .arg(channel).arg(port).arg(quality).arg(width).arg(height).arg((key == true) ? ",alphaextract,format=pix_fmts=yuv422p" : ""));
-        writeMessage(QString("ADD %1 STREAM udp://<client_ip_address>:%2 -format mpegts -codec:v libx264 -crf:v %3 -tune:v zerolatency -preset:v ultrafast -filter:v %4scale=%5:%6")
-                             .arg(channel).arg(port).arg(quality)
-                             .arg((key == true) ? "alphaextract,format=pix_fmts=yuv422p," : "")
-                             .arg(width).arg(height));
+        if (key == true)
+            message.keyword("-filter:v alphaextract,format=pix_fmts=yuv422p,scale=");
+        else
+            message.keyword("-filter:v scale=");
+
+        message.append(width).append(":").append(height);
     }
     else
     {
-        writeMessage(QString("ADD %1 STREAM udp://<client_ip_address>:%2 -format mpegts -codec:v libx264 -crf:v %3 -tune:v zerolatency -preset:v ultrafast %4")
-                     .arg(channel).arg(port).arg(quality).arg((key == true) ? "-filter:v alphaextract" : ""));
+        message.option(key, "-filter:v alphaextract");
     }
+
+    writeMessage(message);
 }
 
 void CasparDevice::stopStream(int channel, int port)
 {
-    writeMessage(QString("REMOVE %1 STREAM udp://<client_ip_address>:%2").arg(channel).arg(port));
+    writeMessage(beginCommand("REMOVE").number(channel).keyword("STREAM").keyword("udp://<client_ip_address>:").append(port));
 }
 
 void CasparDevice::playDeviceInput(int channel, int videolayer, int device, const QString& format)
 {
-    writeMessage(QString("PLAY %1-%2 DECKLINK DEVICE %3 FORMAT %4")
-                 .arg(channel).arg(videolayer).arg(device).arg(format));
+    writeMessage(beginCommand("PLAY").layer(channel, videolayer).keyword("DECKLINK DEVICE").number(device)
+                 .keyword("FORMAT").text(format));
 }
 
 void CasparDevice::loadDeviceInput(int channel, int videolayer, int device, const QString& format)
 {
-    writeMessage(QString("LOADBG %1-%2 DECKLINK DEVICE %3 FORMAT %4")
-                 .arg(channel).arg(videolayer).arg(device).arg(format));
+    writeMessage(beginCommand("LOADBG").layer(channel, videolayer).keyword("DECKLINK DEVICE").number(device)
+                 .keyword("FORMAT").text(format));
 }
 
 void CasparDevice::playImageScroll(int channel, int videolayer, const QString& name, int blur, int speed,
                                    bool premultiply, bool progressive)
 {
-    writeMessage(QString("PLAY %1-%2 \"%3\" BLUR %4 SPEED %5 %6 %7")
-                 .arg(channel).arg(videolayer).arg(name).arg(blur).arg(speed)
-                 .arg((premultiply == true) ? "PREMULTIPLY" : "")
-                 .arg((progressive == true) ? "PROGRESSIVE" : ""));
+    writeMessage(beginCommand("PLAY").layer(channel, videolayer).quoted(name)
+                 .keyword("BLUR").number(blur).keyword("SPEED").number(speed)
+                 .option(premultiply, "PREMULTIPLY")
+                 .option(progressive, "PROGRESSIVE"));
 }
 
 void CasparDevice::loadImageScroll(int channel, int videolayer, const QString& name, int blur, int speed,
                                    bool premultiply, bool progressive)
 {
-    writeMessage(QString("LOADBG %1-%2 \"%3\" BLUR %4 SPEED %5 %6 %7")
-                 .arg(channel).arg(videolayer).arg(name).arg(blur).arg(speed)
-                 .arg((premultiply == true) ? "PREMULTIPLY" : "")
-                 .arg((progressive == true) ? "PROGRESSIVE" : ""));
+    writeMessage(beginCommand("LOADBG").layer(channel, videolayer).quoted(name)
+                 .keyword("BLUR").number(blur).keyword("SPEED").number(speed)
+                 .option(premultiply, "PREMULTIPLY")
+                 .option(progressive, "PROGRESSIVE"));
 }
 
 void CasparDevice::setReset(int channel, int videolayer)
 {
-    writeMessage(QString("MIXER %1-%2 CLEAR").arg(channel).arg(videolayer));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("CLEAR"));
 }
 
 void CasparDevice::setCommit(int channel)
 {
-    writeMessage(QString("MIXER %1 COMMIT").arg(channel));
+    writeMessage(beginCommand("MIXER").number(channel).keyword("COMMIT"));
 }
 
 void CasparDevice::setMasterVolume(int channel, float masterVolume)
 {
-    writeMessage(QString("MIXER %1 MASTERVOLUME %2").arg(channel).arg(masterVolume));
+    writeMessage(beginCommand("MIXER").number(channel).keyword("MASTERVOLUME").number(masterVolume));
 }
 
 void CasparDevice::setChroma(int channel, int videolayer, const QString& key, float threshold, float spread, float spill)
 {
-    writeMessage(QString("MIXER %1-%2 CHROMA %3 %4 %5 %6")
-                 .arg(channel).arg(videolayer).arg(key).arg(threshold).arg(spread).arg(spill));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("CHROMA").text(key)
+                 .number(threshold).number(spread).number(spill));
 }
 
 void CasparDevice::setBlendMode(int channel, int videolayer, const QString& blendMode)
 {
-    writeMessage(QString("MIXER %1-%2 BLEND %3")
-                 .arg(channel).arg(videolayer).arg(blendMode));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("BLEND").text(blendMode));
 }
 
 void CasparDevice::setGrid(int channel, int grid, int duration, const QString& easing, bool defer)
 {
-    writeMessage(QString("MIXER %1 GRID %2 %3 %4 %5")
-                 .arg(channel).arg(grid).arg(duration).arg(easing)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").number(channel).keyword("GRID").number(grid).number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setKeyer(int channel, int videolayer, int keyer, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 KEYER %3 %4")
-                 .arg(channel).arg(videolayer).arg(keyer)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("KEYER").number(keyer)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setVolume(int channel, int videolayer, float volume, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 VOLUME %3 %4")
-                 .arg(channel).arg(videolayer).arg(volume)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("VOLUME").number(volume)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setVolume(int channel, int videolayer, float volume, int duration, const QString& easing, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 VOLUME %3 %4 %5 %6")
-                 .arg(channel).arg(videolayer).arg(volume).arg(duration)
-                 .arg(easing).arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("VOLUME").number(volume)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setOpacity(int channel, int videolayer, float opacity, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 OPACITY %3 %4")
-                 .arg(channel).arg(videolayer).arg(opacity)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("OPACITY").number(opacity)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setOpacity(int channel, int videolayer, float opacity, int duration, const QString& easing, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 OPACITY %3 %4 %5 %6")
-                 .arg(channel).arg(videolayer).arg(opacity).arg(duration).arg(easing)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("OPACITY").number(opacity)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setBrightness(int channel, int videolayer, float brightness, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 BRIGHTNESS %3 %4")
-                 .arg(channel).arg(videolayer).arg(brightness)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("BRIGHTNESS").number(brightness)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setBrightness(int channel, int videolayer, float brightness, int duration, const QString& easing, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 BRIGHTNESS %3 %4 %5 %6")
-                .arg(channel).arg(videolayer).arg(brightness).arg(duration).arg(easing)
-                .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("BRIGHTNESS").number(brightness)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setContrast(int channel, int videolayer, float contrast, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 CONTRAST %3 %4")
-                 .arg(channel).arg(videolayer).arg(contrast)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("CONTRAST").number(contrast)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setContrast(int channel, int videolayer, float contrast, int duration, const QString& easing, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 CONTRAST %3 %4 %5 %6")
-                 .arg(channel).arg(videolayer).arg(contrast).arg(duration).arg(easing)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("CONTRAST").number(contrast)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setSaturation(int channel, int videolayer, float saturation, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 SATURATION %3 %4")
-                 .arg(channel).arg(videolayer).arg(saturation)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("SATURATION").number(saturation)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setSaturation(int channel, int videolayer, float saturation, int duration, const QString& easing, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 SATURATION %3 %4 %5 %6")
-                 .arg(channel).arg(videolayer).arg(saturation).arg(duration).arg(easing)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("SATURATION").number(saturation)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setLevels(int channel, int videolayer, float minIn, float maxIn, float gamma, float minOut, float maxOut,
                              bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 LEVELS %3 %4 %5 %6 %7 %8")
-                 .arg(channel).arg(videolayer).arg(minIn).arg(maxIn).arg(gamma).arg(minOut).arg(maxOut)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("LEVELS")
+                 .number(minIn).number(maxIn).number(gamma).number(minOut).number(maxOut)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setLevels(int channel, int videolayer, float minIn, float maxIn, float gamma, float minOut, float maxOut,
                              int duration, const QString& easing, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 LEVELS %3 %4 %5 %6 %7 %8 %9 %10")
-                 .arg(channel).arg(videolayer).arg(minIn).arg(maxIn).arg(gamma).arg(minOut).arg(maxOut)
-                 .arg(duration).arg(easing)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("LEVELS")
+                 .number(minIn).number(maxIn).number(gamma).number(minOut).number(maxOut)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setFill(int channel, int videolayer, float positionX, float positionY, float scaleX, float scaleY,
                            bool defer, bool useMipmap)
 {
-    writeMessage(QString("MIXER %1-%2 MIPMAP %3").arg(channel).arg(videolayer).arg((useMipmap == true) ? "1" : "0"));
-    writeMessage(QString("MIXER %1-%2 FILL %3 %4 %5 %6 %7")
-                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY).arg(scaleX).arg(scaleY)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("MIPMAP").number((useMipmap == true) ? 1 : 0));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("FILL")
+                 .number(positionX).number(positionY).number(scaleX).number(scaleY)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setFill(int channel, int videolayer, float positionX, float positionY, float scaleX, float scaleY,
                            int duration, const QString& easing, bool defer, bool useMipmap)
 {
-    writeMessage(QString("MIXER %1-%2 MIPMAP %3").arg(channel).arg(videolayer).arg((useMipmap == true) ? "1" : "0"));
-    writeMessage(QString("MIXER %1-%2 FILL %3 %4 %5 %6 %7 %8 %9")
-                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY).arg(scaleX).arg(scaleY)
-                 .arg(duration).arg(easing)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("MIPMAP").number((useMipmap == true) ? 1 : 0));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("FILL")
+                 .number(positionX).number(positionY).number(scaleX).number(scaleY)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setClipping(int channel, int videolayer, float positionX, float positionY, float scaleX, float scaleY,
                                bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 CLIP %3 %4 %5 %6 %7")
-                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY).arg(scaleX)
-                 .arg(scaleY).arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("CLIP")
+                 .number(positionX).number(positionY).number(scaleX).number(scaleY)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setClipping(int channel, int videolayer, float positionX, float positionY, float scaleX, float scaleY,
                                int duration, const QString& easing, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 CLIP %3 %4 %5 %6 %7 %8 %9")
-                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY).arg(scaleX).arg(scaleY)
-                 .arg(duration).arg(easing)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("CLIP")
+                 .number(positionX).number(positionY).number(scaleX).number(scaleY)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setCrop(int channel, int videolayer, float upperLeftX, float upperLeftY, float lowerRightX, float lowerRightY, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 CROP %3 %4 %5 %6 %7")
-                 .arg(channel).arg(videolayer).arg(upperLeftX).arg(upperLeftY).arg(lowerRightX).arg(lowerRightY)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("CROP")
+                 .number(upperLeftX).number(upperLeftY).number(lowerRightX).number(lowerRightY)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setCrop(int channel, int videolayer, float upperLeftX, float upperLeftY, float lowerRightX, float lowerRightY, int duration, const QString& easing, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 CROP %3 %4 %5 %6 %7 %8 %9")
-                 .arg(channel).arg(videolayer).arg(upperLeftX).arg(upperLeftY).arg(lowerRightX).arg(lowerRightY)
-                 .arg(duration).arg(easing)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("CROP")
+                 .number(upperLeftX).number(upperLeftY).number(lowerRightX).number(lowerRightY)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setPerspective(int channel, int videolayer, float upperLeftX, float upperLeftY, float upperRightX, float upperRightY,
                                   float lowerRightX, float lowerRightY, float lowerLeftX, float lowerLeftY, bool defer, bool useMipmap)
 {
-    writeMessage(QString("MIXER %1-%2 MIPMAP %3").arg(channel).arg(videolayer).arg((useMipmap == true) ? "1" : "0"));
-    writeMessage(QString("MIXER %1-%2 PERSPECTIVE %3 %4 %5 %6 %7 %8 %9 %10 %11")
-                 .arg(channel).arg(videolayer)
-                 .arg(upperLeftX).arg(upperLeftY).arg(upperRightX).arg(upperRightY)
-                 .arg(lowerRightX).arg(lowerRightY).arg(lowerLeftX).arg(lowerLeftY)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("MIPMAP").number((useMipmap == true) ? 1 : 0));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("PERSPECTIVE")
+                 .number(upperLeftX).number(upperLeftY).number(upperRightX).number(upperRightY)
+                 .number(lowerRightX).number(lowerRightY).number(lowerLeftX).number(lowerLeftY)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setPerspective(int channel, int videolayer, float upperLeftX, float upperLeftY, float upperRightX, float upperRightY,
                                   float lowerRightX, float lowerRightY, float lowerLeftX, float lowerLeftY, int duration, const QString& easing, bool defer, bool useMipmap)
 {
-    writeMessage(QString("MIXER %1-%2 MIPMAP %3").arg(channel).arg(videolayer).arg((useMipmap == true) ? "1" : "0"));
-    writeMessage(QString("MIXER %1-%2 PERSPECTIVE %3 %4 %5 %6 %7 %8 %9 %10 %11 %12 %13")
-                 .arg(channel).arg(videolayer)
-                 .arg(upperLeftX).arg(upperLeftY).arg(upperRightX).arg(upperRightY)
-                 .arg(lowerRightX).arg(lowerRightY).arg(lowerLeftX).arg(lowerLeftY)
-                 .arg(duration).arg(easing)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("MIPMAP").number((useMipmap == true) ? 1 : 0));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("PERSPECTIVE")
+                 .number(upperLeftX).number(upperLeftY).number(upperRightX).number(upperRightY)
+                 .number(lowerRightX).number(lowerRightY).number(lowerLeftX).number(lowerLeftY)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setRotation(int channel, int videolayer, float rotation, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 ROTATION %3 %4")
-                 .arg(channel).arg(videolayer).arg(rotation)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("ROTATION").number(rotation)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setRotation(int channel, int videolayer, float rotation, int duration, const QString& easing, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 ROTATION %3 %4 %5 %6")
-                .arg(channel).arg(videolayer).arg(rotation).arg(duration).arg(easing)
-                .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("ROTATION").number(rotation)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setAnchor(int channel, int videolayer, float positionX, float positionY, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 ANCHOR %3 %4 %5")
-                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("ANCHOR").number(positionX).number(positionY)
+                 .option(defer, "DEFER"));
 }
 
 void CasparDevice::setAnchor(int channel, int videolayer, float positionX, float positionY, int duration, const QString& easing, bool defer)
 {
-    writeMessage(QString("MIXER %1-%2 ANCHOR %3 %4 %5 %6 %7")
-                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY)
-                 .arg(duration).arg(easing)
-                 .arg((defer == true) ? "DEFER" : ""));
+    writeMessage(beginCommand("MIXER").layer(channel, videolayer).keyword("ANCHOR").number(positionX).number(positionY)
+                 .number(duration).text(easing)
+                 .option(defer, "DEFER"));
+}
+
+QString CasparDevice::parseItemName(const QString& line, QList<QStringView>& fields) const
+{
+    // Format: "NAME" FIELD FIELD ..., the fields are views into the line and are only valid as long as the line is.
+    qsizetype position = line.indexOf("\" ");
+
+    QString name = (position == -1) ? line : line.left(position);
+    name.replace("\\", "/");
+    if (name.startsWith("\""))
+        name.remove(0, 1);
+
+    if (name.endsWith("\""))
+        name.chop(1);
+
+    fields.clear();
+    if (position != -1)
+        fields = QStringView(line).mid(position + 2).trimmed().split(u' ');
+
+    return name;
+}
+
+bool CasparDevice::parseItem(const QString& line)
+{
+    // Listings are tokenized once per line while the reply is still streaming in.
+    QList<QStringView> fields;
+    switch (AmcpDevice::command)
+    {
+        case AmcpDevice::AmcpDeviceCommand::CLS:
+        {
+            QString name = parseItemName(line, fields);
+            QString type = (fields.count() > 0) ? fields.at(0).toString() : QString();
+
+            QString timecode;
+            if (fields.count() > 5)
+            {
+                // Format:
+                // "AMB"  MOVIE  6445960 20121101160514 643 1/60
+                // "CG1080I50"  MOVIE  6159792 20121101150514 264 1/25
+                // "GO1080P25"  MOVIE  16694084 20121101150514 445 1/25
+                // "WIPE"  MOVIE  1268784 20121101150514 31 1/25
+                // "HOOLOOVOO"  MOVIE  1111111 22222222222222 333 100/2997
+                int frames = fields.at(4).toInt();
+
+                qsizetype separator = fields.at(5).indexOf(u'/');
+                double fps = fields.at(5).mid(separator + 1).toDouble() / fields.at(5).left(separator).toDouble();
+
+                double time = frames * (1.0 / fps);
+                timecode = Timecode::fromTime(time, fps, false);
+            }
+
+            this->mediaItems.push_back(CasparMedia(name, type, timecode));
+
+            return true;
+        }
+        case AmcpDevice::AmcpDeviceCommand::TLS:
+        {
+            this->templateItems.push_back(CasparTemplate(parseItemName(line, fields)));
+
+            return true;
+        }
+        case AmcpDevice::AmcpDeviceCommand::DATALIST:
+        {
+            this->dataItems.push_back(CasparData(parseItemName(line, fields)));
+
+            return true;
+        }
+        case AmcpDevice::AmcpDeviceCommand::THUMBNAILLIST:
+        {
+            QString name = parseItemName(line, fields);
+            QString timestamp = (fields.count() > 0) ? fields.at(0).toString() : QString();
+            QString size = (fields.count() > 1) ? fields.at(1).toString() : QString();
+
+            this->thumbnailItems.push_back(CasparThumbnail(name, timestamp, size));
+
+            return true;
+        }
+        default:
+            return false;
+    }
 }
 
 void CasparDevice::sendNotification()
@@ -651,48 +711,17 @@ void CasparDevice::sendNotification()
     if (AmcpDevice::response.count() > 0)
         qDebug("Received message from %s:%d: %s\\r\\n", qPrintable(AmcpDevice::getAddress()), AmcpDevice::getPort(), qPrintable(AmcpDevice::response.at(0).trimmed()));
 
+    if (AmcpDevice::requestId > 0)
+        emit requestCompleted(AmcpDevice::requestId, AmcpDevice::response, *this);
+
     switch (AmcpDevice::command)
     {
         case AmcpDevice::AmcpDeviceCommand::CLS:
         {
             emit responseChanged(AmcpDevice::response.at(0), *this);
 
-            AmcpDevice::response.removeFirst(); // First post is the header, 200 CLS OK.
-
             QList<CasparMedia> items;
-            foreach (QString response, AmcpDevice::response)
-            {
-                QString name = response.split("\" ").at(0);
-                name.replace("\\", "/");
-                if (name.startsWith("\""))
-                    name.remove(0, 1);
-
-                if (name.endsWith("\""))
-                    name.remove(name.length() - 1, 1);
-
-                QString type = response.split("\" ").at(1).trimmed().split(" ").at(0);
-
-                QString timecode;
-                if (response.split("\" ").at(1).trimmed().split(" ").count() > 5)
-                {
-                    // Format:
-                    // "AMB"  MOVIE  6445960 20121101160514 643 1/60
-                    // "CG1080I50"  MOVIE  6159792 20121101150514 264 1/25
-                    // "GO1080P25"  MOVIE  16694084 20121101150514 445 1/25
-                    // "WIPE"  MOVIE  1268784 20121101150514 31 1/25
-                    // "HOOLOOVOO"  MOVIE  1111111 22222222222222 333 100/2997
-                    QString totalFrames = response.split("\" ").at(1).trimmed().split(" ").at(4);
-                    QStringList timebase = response.split("\" ").at(1).trimmed().split(" ").at(5).split("/");
-
-                    int frames = totalFrames.toInt();
-                    double fps = timebase.at(1).toDouble() / timebase.at(0).toDouble();
-
-                    double time = frames * (1.0 / fps);
-                    timecode = Timecode::fromTime(time, fps, false);
-                }
-
-                items.push_back(CasparMedia(name, type, timecode));
-            }
+            items.swap(this->mediaItems);
 
             emit mediaChanged(items, *this);
 
@@ -702,21 +731,8 @@ void CasparDevice::sendNotification()
         {
             emit responseChanged(AmcpDevice::response.at(0), *this);
 
-            AmcpDevice::response.removeFirst(); // First post is the header, 200 TLS OK.
-
             QList<CasparTemplate> items;
-            foreach (QString response, AmcpDevice::response)
-            {
-                QString name = response.split("\" ").at(0);
-                name.replace("\\", "/");
-                if (name.startsWith("\""))
-                    name.remove(0, 1);
-
-                if (name.endsWith("\""))
-                    name.remove(name.length() - 1, 1);
-
-                items.push_back(CasparTemplate(name));
-            }
+            items.swap(this->templateItems);
 
             emit templateChanged(items, *this);
 
@@ -741,21 +757,8 @@ void CasparDevice::sendNotification()
         {
             emit responseChanged(AmcpDevice::response.at(0), *this);
 
-            AmcpDevice::response.removeFirst(); // First post is the header, 200 DATA LIST OK.
-
             QList<CasparData> items;
-            foreach (QString response, AmcpDevice::response)
-            {
-                QString name = response.split("\" ").at(0);
-                name.replace("\\", "/");
-                if (name.startsWith("\""))
-                    name.remove(0, 1);
-
-                if (name.endsWith("\""))
-                    name.remove(name.length() - 1, 1);
-
-                items.push_back(CasparData(name));
-            }
+            items.swap(this->dataItems);
 
             emit dataChanged(items, *this);
 
@@ -765,24 +768,8 @@ void CasparDevice::sendNotification()
         {
             emit responseChanged(AmcpDevice::response.at(0), *this);
 
-            AmcpDevice::response.removeFirst(); // First post is the header, 200 THUMBNAIL LIST OK.
-
             QList<CasparThumbnail> items;
-            foreach (QString response, AmcpDevice::response)
-            {
-                QString name = response.split("\" ").at(0);
-                name.replace("\\", "/");
-                if (name.startsWith("\""))
-                    name.remove(0, 1);
-
-                if (name.endsWith("\""))
-                    name.remove(name.length() - 1, 1);
-
-                QString timestamp = response.split("\" ").at(1).trimmed().split(" ").at(0);
-                QString size = response.split("\" ").at(1).trimmed().split(" ").at(1);
-
-                items.push_back(CasparThumbnail(name, timestamp, size));
-            }
+            items.swap(this->thumbnailItems);
 
             emit thumbnailChanged(items, *this);
 
@@ -806,6 +793,12 @@ void CasparDevice::sendNotification()
         }
         case AmcpDevice::AmcpDeviceCommand::CONNECTIONSTATE:
         {
+            // Drop any listing that was cut off by the connection change.
+            this->mediaItems.clear();
+            this->templateItems.clear();
+            this->dataItems.clear();
+            this->thumbnailItems.clear();
+
             emit connectionStateChanged(*this);
 
             break;
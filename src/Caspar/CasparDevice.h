@@ -19,6 +19,8 @@ class CASPAR_EXPORT CasparDevice : public AmcpDevice
 
         const QString resolveIpAddress() const;
 
+        static bool supportsPipelining(const QString& version);
+
         void refreshData();
         void refreshMedia();
         void refreshTemplate();
@@ -29,9 +31,9 @@ class CASPAR_EXPORT CasparDevice : public AmcpDevice
         void refreshServerVersion();
         void refreshTemplateHostVersion();
 
-        void retrieveThumbnail(const QString& name);
+        quint64 retrieveThumbnail(const QString& name);
 
-        void sendCommand(const QString& command);
+        quint64 sendCommand(const QString& command);
 
         void clearChannel(int channel);
         void clearMixerChannel(int channel);
@@ -135,7 +137,17 @@ class CASPAR_EXPORT CasparDevice : public AmcpDevice
         Q_SIGNAL void responseChanged(const QString&, CasparDevice&);
         Q_SIGNAL void thumbnailChanged(const QList<CasparThumbnail>&, CasparDevice&);
         Q_SIGNAL void thumbnailRetrieveChanged(const QString& data, CasparDevice&);
+        Q_SIGNAL void requestCompleted(quint64 requestId, const QList<QString>&, CasparDevice&);
 
     protected:
         void sendNotification();
+        bool parseItem(const QString& line);
+
+    private:
+        QList<CasparMedia> mediaItems;
+        QList<CasparTemplate> templateItems;
+        QList<CasparData> dataItems;
+        QList<CasparThumbnail> thumbnailItems;
+
+        QString parseItemName(const QString& line, QList<QStringView>& fields) const;
 };
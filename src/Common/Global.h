@@ -30,6 +30,17 @@ namespace Repository
     static const int DEFAULT_PORT = 8250;
 }
 
+namespace Dns
+{
+    static const int CACHE_TTL = 300000; // 5 minutes.
+}
+
+namespace Database
+{
+    static const int DELETE_CHUNK_SIZE = 500; // Below the 999 host parameter limit of older SQLite builds.
+    static const int PAGE_CACHE_SIZE = 16384; // KiB.
+}
+
 namespace Osc
 {
     static const bool DEFAULT_USE_BUNDLE = false;
@@ -347,6 +358,17 @@ namespace Library
     static const int MOVIE_PAGE_INDEX = 4;
     static const int DATA_PAGE_INDEX = 5;
     static const int PRESET_PAGE_INDEX = 6;
+    static const int INCREMENTAL_UPDATE_LIMIT = 100;
+    static const int FILTER_DELAY = 250;
+}
+
+namespace Thumbnail
+{
+    static const int CACHE_SIZE = 32768; // KiB.
+    static const int DECODE_THREAD_COUNT = 2;
+    static const int WRITE_BATCH_SIZE = 25;
+    static const int WRITE_DELAY = 1000;
+    static const int RETRIEVE_TIMEOUT = 10000;
 }
 
 namespace Print
@@ -409,6 +431,9 @@ namespace Rundown
     static const QString ROUTECHANNEL = "ROUTECHANNEL";
     static const QString ROUTEVIDEOLAYER = "ROUTEVIDEOLAYER";
     static const int MAX_NUMBER_OF_RUNDONWS = 10;
+    static const int MAX_NUMBER_OF_CACHED_RUNDOWNS = 50;
+    static const int FIRST_READ_BATCH_SIZE = 50;
+    static const int READ_BATCH_SIZE = 500;
     static const QString DEFAULT_NAME = "New Rundown";
     static const QString DEFAULT_AUDIO_NAME = "Audio";
     static const QString DEFAULT_STILL_NAME = "Image";
@@ -426,6 +451,15 @@ namespace Rundown
     static const int COMPACT_THUMBNAIL_WIDTH = 28;
     static const int COMPACT_THUMBNAIL_HEIGHT = 16;
     static const int GROUP_INDENTION = 65;
+    static const int ITEM_MARGIN = 4;
+    static const int TYPE_ROLE = Qt::UserRole + 1;
+    static const int LABEL_ROLE = Qt::UserRole + 2;
+    static const int DEVICENAME_ROLE = Qt::UserRole + 3;
+    static const int NAME_ROLE = Qt::UserRole + 4;
+    static const int COLOR_ROLE = Qt::UserRole + 5;
+    static const int USED_ROLE = Qt::UserRole + 6;
+    static const int EXECUTED_ROLE = Qt::UserRole + 7;
+    static const int RECORD_ROLE = Qt::UserRole + 8;
 }
 
 namespace Panel
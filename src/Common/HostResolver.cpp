@@ -0,0 +1,100 @@
+#include "HostResolver.h"
+
+#include "Global.h"
+
+#include <QtNetwork/QHostAddress>
+#include <QtNetwork/QHostInfo>
+
+Q_GLOBAL_STATIC(HostResolver, hostResolver)
+
+HostResolver::HostResolver()
+{
+}
+
+HostResolver& HostResolver::getInstance()
+{
+    return *hostResolver();
+}
+
+bool HostResolver::parseAddress(const QString& hostName, QString& address) const
+{
+    if (hostName == "localhost")
+    {
+        address = "127.0.0.1";
+        return true;
+    }
+
+    if (!QHostAddress(hostName).isNull())
+    {
+        address = hostName; // The ip address is valid.
+        return true;
+    }
+
+    return false;
+}
+
+void HostResolver::prefetch(const QString& hostName)
+{
+    QString address;
+    if (parseAddress(hostName, address) || this->entries.contains(hostName))
+        return;
+
+    this->entries.insert(hostName, HostResolverEntry());
+
+    lookup(hostName);
+}
+
+const QString HostResolver::resolve(const QString& hostName)
+{
+    QString address;
+    if (parseAddress(hostName, address))
+        return address;
+
+    // Never block the caller. The cached address is served, empty until the first lookup succeeds,
+    // and hostResolved() is emitted once the lookup started here or by prefetch() has an address.
+    HostResolverEntry& entry = this->entries[hostName];
+    if (!entry.pending && (!entry.resolved || entry.timer.hasExpired(Dns::CACHE_TTL)))
+        lookup(hostName);
+
+    return entry.address;
+}
+
+void HostResolver::lookup(const QString& hostName)
+{
+    this->entries[hostName].pending = true;
+
+    int id = QHostInfo::lookupHost(hostName, this, SLOT(lookedUp(QHostInfo)));
+    this->lookups.insert(id, hostName);
+}
+
+void HostResolver::lookedUp(const QHostInfo& hostInfo)
+{
+    if (!this->lookups.contains(hostInfo.lookupId()))
+        return;
+
+    const QString hostName = this->lookups.take(hostInfo.lookupId());
+
+    HostResolverEntry& entry = this->entries[hostName];
+    entry.pending = false;
+    entry.timer.start();
+
+    // Keep the previous address if the lookup failed, it is retried when the ttl expires again.
+    // A host that never resolved stays unresolved, the next resolve() looks it up again.
+    if (hostInfo.error() != QHostInfo::NoError || hostInfo.addresses().isEmpty())
+    {
+        qWarning("Failed to resolve host %s: %s", qPrintable(hostName), qPrintable(hostInfo.errorString()));
+
+        entry.resolved = !entry.address.isEmpty();
+
+        return;
+    }
+
+    QString address = hostInfo.addresses().at(0).toString();
+    bool changed = (address != entry.address);
+
+    entry.address = address;
+    entry.resolved = true;
+
+    if (changed)
+        emit hostResolved(hostName, address);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Shared.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+class QHostInfo;
+
+class COMMON_EXPORT HostResolver : public QObject
+{
+    Q_OBJECT
+
+    public:
+        explicit HostResolver();
+
+        static HostResolver& getInstance();
+
+        void prefetch(const QString& hostName);
+        const QString resolve(const QString& hostName);
+
+        Q_SIGNAL void hostResolved(const QString&, const QString&);
+
+    private:
+        struct HostResolverEntry
+        {
+            QString address;
+            QElapsedTimer timer;
+            bool resolved = false;
+            bool pending = false;
+        };
+
+        QHash<QString, HostResolverEntry> entries;
+        QHash<int, QString> lookups;
+
+        bool parseAddress(const QString& hostName, QString& address) const;
+        void lookup(const QString& hostName);
+
+        Q_SLOT void lookedUp(const QHostInfo& hostInfo);
+};
@@ -1,10 +1,14 @@
 #include "DatabaseManager.h"
 
+#include "Global.h"
 #include "Version.h"
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
 #include <QtCore/QTime>
 #include <QtCore/QVariant>
 
@@ -32,6 +36,67 @@ void DatabaseManager::initialize()
         createDatabase();
     else
         upgradeDatabase();
+
+    createSearchIndex();
+}
+
+bool DatabaseManager::isInMemory()
+{
+    QMutexLocker locker(&mutex);
+
+    return QSqlDatabase::database().databaseName() == ":memory:";
+}
+
+void DatabaseManager::createSearchIndex()
+{
+    QElapsedTimer time;
+    time.start();
+
+    // The index lives in the temp schema and is rebuilt on startup, the database file never depends on FTS5 being available.
+    // The library is filtered from the snapshots of LibraryStore, only presets are filtered in the database.
+    QSqlQuery sql;
+    if (!sql.exec("CREATE VIRTUAL TABLE temp.PresetSearch USING fts5(Name, tokenize = 'trigram')"))
+    {
+        qDebug("Full text search not available, filtering without index: %s", qPrintable(sql.lastError().text()));
+        return;
+    }
+
+    QStringList queries;
+    queries << "INSERT INTO temp.PresetSearch (rowid, Name) SELECT Id, Name FROM main.Preset"
+            << "CREATE TEMP TRIGGER PresetSearchInsert AFTER INSERT ON main.Preset BEGIN INSERT INTO PresetSearch (rowid, Name) VALUES (new.Id, new.Name); END"
+            << "CREATE TEMP TRIGGER PresetSearchDelete AFTER DELETE ON main.Preset BEGIN DELETE FROM PresetSearch WHERE rowid = old.Id; END"
+            << "CREATE TEMP TRIGGER PresetSearchUpdate AFTER UPDATE OF Name ON main.Preset BEGIN UPDATE PresetSearch SET Name = new.Name WHERE rowid = new.Id; END";
+
+    foreach (const QString& query, queries)
+    {
+        if (!sql.exec(query))
+        {
+            qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+            return;
+        }
+    }
+
+    this->fullTextSearch = true;
+
+    qDebug("DatabaseManager::createSearchIndex %lld msec", time.elapsed());
+}
+
+QString DatabaseManager::getSearchCondition(const QString& alias, const QString& index, const QString& filter) const
+{
+    // Trigrams need at least three characters, shorter filters scan the table.
+    if (this->fullTextSearch && filter.length() >= 3)
+        return QString("%1.Id IN (SELECT rowid FROM %2 WHERE %2 MATCH :Name)").arg(alias).arg(index);
+
+    return QString("%1.Name LIKE :Name").arg(alias);
+}
+
+QString DatabaseManager::getSearchValue(const QString& filter) const
+{
+    // The filter is matched as one quoted string, a substring match like the LIKE fallback.
+    if (this->fullTextSearch && filter.length() >= 3)
+        return QString("\"%1\"").arg(QString(filter).replace("\"", "\"\""));
+
+    return QString("%%1%").arg(filter);
 }
 
 void DatabaseManager::createDatabase()
@@ -269,9 +334,10 @@ QList<PresetModel> DatabaseManager::getPresetByFilter(const QString& filter)
 
     QSqlQuery sql;
     sql.prepare("SELECT p.Id, p.Name, p.Value FROM Preset p "
-                "WHERE p.Name LIKE :Name "
-                "ORDER BY p.Name, p.Id");
-    sql.bindValue(":Name", QString("%%1%").arg(filter));
+                "WHERE " + getSearchCondition("p", "PresetSearch", filter) + " "
+                "ORDER BY p.Name LIKE :Prefix DESC, p.Name, p.Id");
+    sql.bindValue(":Name", getSearchValue(filter));
+    sql.bindValue(":Prefix", QString("%1%").arg(filter));
 
     if (!sql.exec())
        qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
@@ -683,6 +749,8 @@ void DatabaseManager::insertDevice(const DeviceModel& model)
 {
     QMutexLocker locker(&mutex);
 
+    this->deviceIds.clear();
+
     QSqlDatabase::database().transaction();
 
     QSqlQuery sql;
@@ -711,6 +779,8 @@ void DatabaseManager::updateDevice(const DeviceModel& model)
 {
     QMutexLocker locker(&mutex);
 
+    this->deviceIds.clear();
+
     QSqlDatabase::database().transaction();
 
     QSqlQuery sql;
@@ -794,6 +864,8 @@ void DatabaseManager::deleteDevice(int id)
 {
     QMutexLocker locker(&mutex);
 
+    this->deviceIds.clear();
+
     QSqlDatabase::database().transaction();
 
     QSqlQuery sql;
@@ -872,123 +944,6 @@ QList<LibraryModel> DatabaseManager::getLibraryData()
     return models;
 }
 
-QList<LibraryModel> DatabaseManager::getLibraryMediaByFilter(const QString& filter, QList<QString> devices)
-{
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-
-    if (!filter.isEmpty() && devices.isEmpty()) // Filter on all devices.
-    {    
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND (l.TypeId = 1 OR l.TypeId = 3 OR l.TypeId = 4) AND l.Name LIKE :Name "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (!filter.isEmpty() && !devices.isEmpty()) // Filter specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND (l.TypeId = 1 OR l.TypeId = 3 OR l.TypeId = 4) AND l.Name LIKE :Name AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (filter.isEmpty() && !devices.isEmpty()) // All on specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND (l.TypeId = 1 OR l.TypeId = 3 OR l.TypeId = 4) AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-    }
-
-    if (!sql.exec())
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<LibraryModel> models;
-    while (sql.next())
-        models.push_back(LibraryModel(sql.value("Id").toInt(), sql.value(1).toString(), sql.value(1).toString(),
-                                      sql.value(2).toString(), sql.value("Value").toString(), sql.value("ThumbnailId").toInt(),
-                                      sql.value("Timecode").toString()));
-
-    return models;
-}
-
-QList<LibraryModel> DatabaseManager::getLibraryTemplateByFilter(const QString& filter, QList<QString> devices)
-{
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-
-    if (!filter.isEmpty() && devices.isEmpty()) // Filter on all devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 5 AND l.Name LIKE :Name "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (!filter.isEmpty() && !devices.isEmpty()) // Filter specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 5 AND l.Name LIKE :Name AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (filter.isEmpty() && !devices.isEmpty()) // All on specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 5 AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-    }
-
-    if (!sql.exec())
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<LibraryModel> models;
-    while (sql.next())
-        models.push_back(LibraryModel(sql.value("Id").toInt(), sql.value(1).toString(), sql.value(1).toString(),
-                                      sql.value(2).toString(), sql.value("Value").toString(), sql.value("ThumbnailId").toInt(),
-                                      sql.value("Timecode").toString()));
-
-    return models;
-}
-
-QList<LibraryModel> DatabaseManager::getLibraryDataByFilter(const QString& filter, QList<QString> devices)
-{
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-
-    if (!filter.isEmpty() && devices.isEmpty()) // Filter on all devices.
-    {  
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 2 AND l.Name LIKE :Name "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (!filter.isEmpty() && !devices.isEmpty()) // Filter specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 2 AND l.Name LIKE :Name AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (filter.isEmpty() && !devices.isEmpty()) // All on specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 2 AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-    }
-
-    if (!sql.exec())
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<LibraryModel> models;
-    while (sql.next())
-        models.push_back(LibraryModel(sql.value("Id").toInt(), sql.value(1).toString(), sql.value(1).toString(),
-                                      sql.value(2).toString(), sql.value("Value").toString(), sql.value("ThumbnailId").toInt(),
-                                      sql.value("Timecode").toString()));
-
-    return models;
-}
-
 QList<LibraryModel> DatabaseManager::getLibraryByDeviceId(int deviceId)
 {
     QMutexLocker locker(&mutex);
@@ -1011,40 +966,6 @@ QList<LibraryModel> DatabaseManager::getLibraryByDeviceId(int deviceId)
     return models;
 }
 
-QList<LibraryModel> DatabaseManager::getLibraryByDeviceIdAndFilter(int deviceId, const QString& filter)
-{
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-
-    if (filter.isEmpty())
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND d.Id = :Id "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Id", deviceId);
-    }
-    else // Filter.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND d.Id = :Id AND l.Name LIKE :Name "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Id", deviceId);
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-
-    if (!sql.exec())
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<LibraryModel> models;
-    while (sql.next())
-        models.push_back(LibraryModel(sql.value("Id").toInt(), sql.value(1).toString(), sql.value(1).toString(),
-                                      sql.value(2).toString(), sql.value("Value").toString(), sql.value("ThumbnailId").toInt(),
-                                      sql.value("Timecode").toString()));
-
-    return models;
-}
-
 QList<LibraryModel> DatabaseManager::getLibraryMediaByDeviceAddress(const QString& address)
 {
     QMutexLocker locker(&mutex);
@@ -1133,154 +1054,175 @@ QList<LibraryModel> DatabaseManager::getLibraryByNameAndDeviceId(const QString&
     return models;
 }
 
-void DatabaseManager::updateLibraryMedia(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels)
+void DatabaseManager::updateLibraryMedia(const QString& address, LibraryChangeSet& changeSet)
 {
     QMutexLocker locker(&mutex);
 
-    int deviceId = getDeviceByAddress(address).getId();
-    QList<TypeModel> typeModels = getType();
+    int deviceId = getDeviceIdByAddress(address);
 
     QSqlDatabase::database().transaction();
 
-    QSqlQuery sql;
-
-    if (deleteModels.count() > 0)
-    {
-        for (int i = 0; i < deleteModels.count(); i++)
-        { 
-            sql.prepare("DELETE FROM Library "
-                        "WHERE Id = :Id");
-            sql.bindValue(":Id", deleteModels.at(i).getId());
+    QList<int> deleteIds;
+    deleteIds.reserve(changeSet.getDeleteModels().count());
+    foreach (const LibraryModel& model, changeSet.getDeleteModels())
+        deleteIds.push_back(model.getId());
 
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-        }
-    }
+    deleteByIds("DELETE FROM Library WHERE Id IN (%1)", deleteIds);
+    insertLibrary(deviceId, changeSet);
 
-    if (insertModels.count() > 0)
+    const QList<LibraryModel>& updateModels = changeSet.getUpdateModels();
+    if (updateModels.count() > 0)
     {
-        int typeId;
-        for (int i = 0; i < insertModels.count(); i++)
+        QVariantList typeIds, timecodes, ids;
+        foreach (const LibraryModel& model, updateModels)
         {
-            if (insertModels.at(i).getType() == Rundown::AUDIO)
-                typeId = std::find_if(typeModels.begin(), typeModels.end(), TypeModel::ByName(Rundown::AUDIO))->getId();
-            else if (insertModels.at(i).getType() == Rundown::MOVIE)
-                typeId = std::find_if(typeModels.begin(), typeModels.end(), TypeModel::ByName(Rundown::MOVIE))->getId();
-            else if (insertModels.at(i).getType() == Rundown::STILL)
-                typeId = std::find_if(typeModels.begin(), typeModels.end(), TypeModel::ByName(Rundown::STILL))->getId();
-
-            sql.prepare("INSERT INTO Library (Name, DeviceId, TypeId, ThumbnailId, Timecode) "
-                        "VALUES(:Name, :DeviceId, :TypeId, :ThumbnailId, :Timecode)");
-            sql.bindValue(":Name", insertModels.at(i).getName());
-            sql.bindValue(":DeviceId", deviceId);
-            sql.bindValue(":TypeId", typeId);
-            sql.bindValue(":ThumbnailId", insertModels.at(i).getThumbnailId());
-            sql.bindValue(":Timecode", insertModels.at(i).getTimecode());
-
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+            typeIds.push_back(getTypeId(model.getType()));
+            timecodes.push_back(model.getTimecode());
+            ids.push_back(model.getId());
         }
+
+        QSqlQuery sql;
+        sql.prepare("UPDATE Library SET TypeId = ?, Timecode = ? "
+                    "WHERE Id = ?");
+        sql.addBindValue(typeIds);
+        sql.addBindValue(timecodes);
+        sql.addBindValue(ids);
+
+        if (!sql.execBatch())
+           qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
     }
 
     QSqlDatabase::database().commit();
 }
 
-void DatabaseManager::updateLibraryTemplate(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels)
+void DatabaseManager::updateLibraryTemplate(const QString& address, LibraryChangeSet& changeSet)
 {
     QMutexLocker locker(&mutex);
 
-    int deviceId = getDeviceByAddress(address).getId();
-    QList<TypeModel> typeModels = getType();
-    int typeId = std::find_if(typeModels.begin(), typeModels.end(), TypeModel::ByName(Rundown::TEMPLATE))->getId();
+    int deviceId = getDeviceIdByAddress(address);
 
     QSqlDatabase::database().transaction();
 
-    QSqlQuery sql;
-    if (deleteModels.count() > 0)
-    {
-        for (int i = 0; i < deleteModels.count(); i++)
-        {
-            sql.prepare("DELETE FROM Library "
-                        "WHERE Id = :Id");
-            sql.bindValue(":Id", deleteModels.at(i).getId());
+    QList<int> deleteIds;
+    deleteIds.reserve(changeSet.getDeleteModels().count());
+    foreach (const LibraryModel& model, changeSet.getDeleteModels())
+        deleteIds.push_back(model.getId());
 
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-        }
-    }
+    deleteByIds("DELETE FROM Library WHERE Id IN (%1)", deleteIds);
+    insertLibrary(deviceId, changeSet);
 
-    if (insertModels.count() > 0)
-    {
-        for (int i = 0; i < insertModels.count(); i++)
-        {
-            sql.prepare("INSERT INTO Library (Name, DeviceId, TypeId, ThumbnailId, Timecode) "
-                        "VALUES(:Name, :DeviceId, :TypeId, :ThumbnailId, :Timecode)");
-            sql.bindValue(":Name", insertModels.at(i).getName());
-            sql.bindValue(":DeviceId", deviceId);
-            sql.bindValue(":TypeId", typeId);
-            sql.bindValue(":ThumbnailId", insertModels.at(i).getThumbnailId());
-            sql.bindValue(":Timecode", insertModels.at(i).getTimecode());
+    QSqlDatabase::database().commit();
+}
 
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-        }
+void DatabaseManager::updateLibraryData(const QString& address, LibraryChangeSet& changeSet)
+{
+    QMutexLocker locker(&mutex);
+
+    int deviceId = getDeviceIdByAddress(address);
+
+    QSqlDatabase::database().transaction();
+
+    QList<int> deleteIds;
+    QList<int> deleteThumbnailIds;
+    deleteIds.reserve(changeSet.getDeleteModels().count());
+    deleteThumbnailIds.reserve(changeSet.getDeleteModels().count());
+    foreach (const LibraryModel& model, changeSet.getDeleteModels())
+    {
+        deleteIds.push_back(model.getId());
+        deleteThumbnailIds.push_back(model.getThumbnailId());
     }
 
+    deleteByIds("DELETE FROM Thumbnail WHERE Id IN (%1)", deleteThumbnailIds);
+    deleteByIds("DELETE FROM Library WHERE TypeId = 2 AND Id IN (%1)", deleteIds);
+    insertLibrary(deviceId, changeSet);
+
     QSqlDatabase::database().commit();
 }
 
-void DatabaseManager::updateLibraryData(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels)
+void DatabaseManager::insertLibrary(int deviceId, LibraryChangeSet& changeSet)
 {
-    QMutexLocker locker(&mutex);
+    if (changeSet.getInsertModels().isEmpty())
+        return;
 
-    int deviceId = getDeviceByAddress(address).getId();
-    QList<TypeModel> typeModels = getType();
+    QSqlQuery sql;
+    if (!sql.exec("SELECT IFNULL(MAX(l.Id), 0) + 1 FROM Library l"))
+       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
-    QSqlDatabase::database().transaction();
+    sql.first();
+    changeSet.assignIds(sql.value(0).toInt());
+
+    // One prepared statement for all rows, bound column wise.
+    QVariantList ids, names, deviceIds, typeIds, thumbnailIds, timecodes;
+    foreach (const LibraryModel& model, changeSet.getInsertModels())
+    {
+        ids.push_back(model.getId());
+        names.push_back(model.getName());
+        deviceIds.push_back(deviceId);
+        typeIds.push_back(getTypeId(model.getType()));
+        thumbnailIds.push_back(model.getThumbnailId());
+        timecodes.push_back(model.getTimecode());
+    }
+
+    sql.prepare("INSERT INTO Library (Id, Name, DeviceId, TypeId, ThumbnailId, Timecode) "
+                "VALUES(?, ?, ?, ?, ?, ?)");
+    sql.addBindValue(ids);
+    sql.addBindValue(names);
+    sql.addBindValue(deviceIds);
+    sql.addBindValue(typeIds);
+    sql.addBindValue(thumbnailIds);
+    sql.addBindValue(timecodes);
+
+    if (!sql.execBatch())
+       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+}
 
+void DatabaseManager::deleteByIds(const QString& statement, const QList<int>& ids)
+{
+    // Chunked to stay below the host parameter limit of SQLite, every full chunk reuses the same statement.
     QSqlQuery sql;
-    if (deleteModels.count() > 0)
+    int preparedCount = 0;
+    for (int offset = 0; offset < ids.count(); offset += Database::DELETE_CHUNK_SIZE)
     {
-        for (int i = 0; i < deleteModels.count(); i++)
+        int count = qMin(Database::DELETE_CHUNK_SIZE, static_cast<int>(ids.count()) - offset);
+        if (count != preparedCount)
         {
-            sql.prepare("DELETE FROM Thumbnail "
-                        "WHERE Id = :Id");
-            sql.bindValue(":Id", deleteModels.at(i).getThumbnailId());
+            QString placeholders = QString("?,").repeated(count);
+            placeholders.chop(1);
 
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+            sql.prepare(statement.arg(placeholders));
+            preparedCount = count;
+        }
 
-            sql.prepare("DELETE FROM Library "
-                        "WHERE Id = :Id AND TypeId = 2");
-            sql.bindValue(":Id", deleteModels.at(i).getId());
+        for (int i = 0; i < count; i++)
+            sql.bindValue(i, ids.at(offset + i));
 
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-        }
+        if (!sql.exec())
+           qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
     }
+}
 
-    if (insertModels.count() > 0)
+int DatabaseManager::getTypeId(const QString& value)
+{
+    // The Type table is static, it is only read once.
+    if (this->typeIds.isEmpty())
     {
-        int typeId;
-        for (int i = 0; i < insertModels.count(); i++)
-        {
-            if (insertModels.at(i).getType() == "DATA")
-                typeId = std::find_if(typeModels.begin(), typeModels.end(), TypeModel::ByName("DATA"))->getId();
+        foreach (const TypeModel& model, getType())
+            this->typeIds.insert(model.getName(), model.getId());
+    }
 
-            sql.prepare("INSERT INTO Library (Name, DeviceId, TypeId, ThumbnailId, Timecode) "
-                        "VALUES(:Name, :DeviceId, :TypeId, :ThumbnailId, :Timecode)");
-            sql.bindValue(":Name", insertModels.at(i).getName());
-            sql.bindValue(":DeviceId", deviceId);
-            sql.bindValue(":TypeId", typeId);
-            sql.bindValue(":ThumbnailId", insertModels.at(i).getThumbnailId());
-            sql.bindValue(":Timecode", insertModels.at(i).getTimecode());
+    return this->typeIds.value(value);
+}
 
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-        }
-    }
+int DatabaseManager::getDeviceIdByAddress(const QString& address)
+{
+    QHash<QString, int>::const_iterator iterator = this->deviceIds.constFind(address);
+    if (iterator != this->deviceIds.constEnd())
+        return iterator.value();
 
-    QSqlDatabase::database().commit();
+    int deviceId = getDeviceByAddress(address).getId();
+    this->deviceIds.insert(address, deviceId);
+
+    return deviceId;
 }
 
 void DatabaseManager::deleteLibrary(int deviceId)
@@ -1305,7 +1247,8 @@ QList<ThumbnailModel> DatabaseManager::getThumbnailByDeviceAddress(const QString
     QMutexLocker locker(&mutex);
 
     QSqlQuery sql;
-    sql.prepare("SELECT t.Id, t.Data, t.Timestamp, t.Size, l.Name, d.Address FROM Thumbnail t, Library l, Device d "
+    // Only used to compare timestamps, the image data is left out.
+    sql.prepare("SELECT t.Id, t.Timestamp, t.Size, l.Name, d.Address FROM Thumbnail t, Library l, Device d "
                 "WHERE d.Address = :Address AND l.DeviceId = d.Id AND l.ThumbnailId = t.Id");
     sql.bindValue(":Address", address);
 
@@ -1314,7 +1257,7 @@ QList<ThumbnailModel> DatabaseManager::getThumbnailByDeviceAddress(const QString
 
     QList<ThumbnailModel> models;
     while (sql.next())
-        models.push_back(ThumbnailModel(sql.value("Id").toInt(), sql.value("Data").toString(), sql.value("Timestamp").toString(),
+        models.push_back(ThumbnailModel(sql.value("Id").toInt(), QByteArray(), sql.value("Timestamp").toString(),
                                         sql.value("Size").toString(), sql.value("Name").toString(), sql.value("Address").toString()));
 
     return models;
@@ -1322,11 +1265,13 @@ QList<ThumbnailModel> DatabaseManager::getThumbnailByDeviceAddress(const QString
 
 ThumbnailModel DatabaseManager::getThumbnailByNameAndDeviceName(const QString& name, const QString& deviceName)
 {
-    QMutexLocker locker(&mutex);
+    // The thumbnail cache reads on its decode threads, they have connections of their own and do not need the lock.
+    bool mainThread = (QThread::currentThread() == QCoreApplication::instance()->thread());
+    QMutexLocker locker(mainThread ? &mutex : nullptr);
 
-    QSqlQuery sql;
+    QSqlQuery sql(mainThread ? QSqlDatabase::database() : getThreadDatabase());
     sql.prepare("SELECT t.Id, t.Data, t.Timestamp, t.Size, l.Name, d.Name, d.Address FROM Thumbnail t, Library l, Device d "
-                "WHERE l.Name = :Name AND d.Name = :DeviceName AND l.ThumbnailId = t.Id");
+                "WHERE l.Name = :Name AND d.Name = :DeviceName AND l.DeviceId = d.Id AND l.ThumbnailId = t.Id");
     sql.bindValue(":Name", name);
     sql.bindValue(":DeviceName", deviceName);
 
@@ -1335,61 +1280,96 @@ ThumbnailModel DatabaseManager::getThumbnailByNameAndDeviceName(const QString& n
 
     sql.first();
 
-    return ThumbnailModel(sql.value("Id").toInt(), sql.value("Data").toString(), sql.value("Timestamp").toString(),
+    return ThumbnailModel(sql.value("Id").toInt(), getThumbnailData(sql.value("Data")), sql.value("Timestamp").toString(),
                           sql.value("Size").toString(), sql.value("Name").toString(), sql.value("Address").toString());
 }
 
-void DatabaseManager::updateThumbnail(const ThumbnailModel& model)
+QList<int> DatabaseManager::updateThumbnails(const QList<ThumbnailModel>& models)
 {
     QMutexLocker locker(&mutex);
 
-    int deviceId = getDeviceByAddress(model.getAddress()).getId();
-    const QList<LibraryModel>& libraryModels = getLibraryByNameAndDeviceId(model.getName(), deviceId);
-
     QSqlDatabase::database().transaction();
 
-    QSqlQuery sql;
-    if (libraryModels.count() > 0)
+    // Retrieved thumbnails are written in batches, the statements are prepared once per batch.
+    QSqlQuery updateSql;
+    updateSql.prepare("UPDATE Thumbnail SET Data = :Data, Timestamp = :Timestamp, Size = :Size "
+                      "WHERE Id = :Id");
+
+    QSqlQuery insertSql;
+    insertSql.prepare("INSERT INTO Thumbnail (Data, Timestamp, Size) "
+                      "VALUES(:Data, :Timestamp, :Size)");
+
+    QSqlQuery librarySql;
+    librarySql.prepare("UPDATE Library SET ThumbnailId = :ThumbnailId "
+                       "WHERE Id = :Id");
+
+    QList<int> thumbnailIds;
+    foreach (const ThumbnailModel& model, models)
     {
-        for (int i = 0; i < libraryModels.count(); i++)
+        int thumbnailId = 0;
+
+        const QList<LibraryModel>& libraryModels = getLibraryByNameAndDeviceId(model.getName(), getDeviceIdByAddress(model.getAddress()));
+        foreach (const LibraryModel& libraryModel, libraryModels)
         {
-            const LibraryModel& libraryModel = libraryModels.at(i);
             if (libraryModel.getThumbnailId() > 0)
             {
-                sql.prepare("UPDATE Thumbnail SET Data = :Data, Timestamp = :Timestamp, Size = :Size "
-                            "WHERE Id = :Id");
-                sql.bindValue(":Data", model.getData());
-                sql.bindValue(":Timestamp", model.getTimestamp());
-                sql.bindValue(":Size", model.getSize());
-                sql.bindValue(":Id", libraryModel.getThumbnailId());
-
-                if (!sql.exec())
-                   qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+                thumbnailId = libraryModel.getThumbnailId();
+
+                updateSql.bindValue(":Data", model.getData());
+                updateSql.bindValue(":Timestamp", model.getTimestamp());
+                updateSql.bindValue(":Size", model.getSize());
+                updateSql.bindValue(":Id", libraryModel.getThumbnailId());
+
+                if (!updateSql.exec())
+                   qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(updateSql.lastQuery()), qPrintable(updateSql.lastError().text()));
             }
             else
             {
-                sql.prepare("INSERT INTO Thumbnail (Data, Timestamp, Size) "
-                            "VALUES(:Data, :Timestamp, :Size)");
-                sql.bindValue(":Data", model.getData());
-                sql.bindValue(":Timestamp", model.getTimestamp());
-                sql.bindValue(":Size", model.getSize());
-
-                if (!sql.exec())
-                   qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-                int lastInsertId = sql.lastInsertId().toInt();
-                sql.prepare("UPDATE Library SET ThumbnailId = :ThumbnailId "
-                            "WHERE Id = :Id");
-                sql.bindValue(":ThumbnailId", lastInsertId);
-                sql.bindValue(":Id", libraryModel.getId());
-
-                if (!sql.exec())
-                   qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+                insertSql.bindValue(":Data", model.getData());
+                insertSql.bindValue(":Timestamp", model.getTimestamp());
+                insertSql.bindValue(":Size", model.getSize());
+
+                if (!insertSql.exec())
+                   qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(insertSql.lastQuery()), qPrintable(insertSql.lastError().text()));
+
+                thumbnailId = insertSql.lastInsertId().toInt();
+                librarySql.bindValue(":ThumbnailId", thumbnailId);
+                librarySql.bindValue(":Id", libraryModel.getId());
+
+                if (!librarySql.exec())
+                   qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(librarySql.lastQuery()), qPrintable(librarySql.lastError().text()));
             }
         }
+
+        thumbnailIds.push_back(thumbnailId);
     }
 
     QSqlDatabase::database().commit();
+
+    return thumbnailIds;
+}
+
+QByteArray DatabaseManager::getThumbnailData(const QVariant& value) const
+{
+    // Thumbnails stored before ChangeScript-221 are base64 encoded text, they are replaced with binary data once retrieved again.
+    if (value.typeId() == QMetaType::QString)
+        return QByteArray::fromBase64(value.toString().toLatin1());
+
+    return value.toByteArray();
+}
+
+QSqlDatabase DatabaseManager::getThreadDatabase() const
+{
+    // A connection can only be used by the thread that opened it, each worker thread opens its own to the same file.
+    QString connectionName = QString("Thread%1").arg(reinterpret_cast<quintptr>(QThread::currentThread()));
+    if (QSqlDatabase::contains(connectionName))
+        return QSqlDatabase::database(connectionName);
+
+    QSqlDatabase database = QSqlDatabase::cloneDatabase(QSqlDatabase::defaultConnection, connectionName);
+    if (!database.open())
+        qCritical("Unable to open database, Error: %s", qPrintable(database.lastError().text()));
+
+    return database;
 }
 
 void DatabaseManager::deleteThumbnails()
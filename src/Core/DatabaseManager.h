@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Shared.h"
+#include "LibraryChangeSet.h"
 #include "Models/BlendModeModel.h"
 #include "Models/ConfigurationModel.h"
 #include "Models/ChromaModel.h"
@@ -20,8 +21,13 @@
 #include "Models/PresetModel.h"
 #include "Models/OscOutputModel.h"
 
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
 #include <QtCore/QRecursiveMutex>
 #include <QtCore/QObject>
+#include <QtCore/QVariant>
+
+#include <QtSql/QSqlDatabase>
 
 class CORE_EXPORT DatabaseManager
 {
@@ -33,6 +39,8 @@ class CORE_EXPORT DatabaseManager
         void initialize();
         void uninitialize() {}
 
+        bool isInMemory();
+
         ConfigurationModel getConfigurationByName(const QString& name);
         void updateConfiguration(const ConfigurationModel& model);
 
@@ -84,28 +92,38 @@ class CORE_EXPORT DatabaseManager
         QList<LibraryModel> getLibraryMedia();
         QList<LibraryModel> getLibraryTemplate();
         QList<LibraryModel> getLibraryData();
-        QList<LibraryModel> getLibraryMediaByFilter(const QString& filter, QList<QString> devices);
-        QList<LibraryModel> getLibraryTemplateByFilter(const QString& filter, QList<QString> devices);
-        QList<LibraryModel> getLibraryDataByFilter(const QString& filter, QList<QString> devices);
         QList<LibraryModel> getLibraryByDeviceId(int deviceId);
-        QList<LibraryModel> getLibraryByDeviceIdAndFilter(int deviceId, const QString& filter);
         QList<LibraryModel> getLibraryMediaByDeviceAddress(const QString& address);
         QList<LibraryModel> getLibraryTemplateByDeviceAddress(const QString& address);
         QList<LibraryModel> getLibraryDataByDeviceAddress(const QString& address);
         QList<LibraryModel> getLibraryByNameAndDeviceId(const QString& name, int deviceId);
-        void updateLibraryMedia(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels);
-        void updateLibraryTemplate(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels);
-        void updateLibraryData(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels);
+        void updateLibraryMedia(const QString& address, LibraryChangeSet& changeSet);
+        void updateLibraryTemplate(const QString& address, LibraryChangeSet& changeSet);
+        void updateLibraryData(const QString& address, LibraryChangeSet& changeSet);
         void deleteLibrary(int deviceId);
 
         QList<ThumbnailModel> getThumbnailByDeviceAddress(const QString& address);
         ThumbnailModel getThumbnailByNameAndDeviceName(const QString& name, const QString& deviceName);
-        void updateThumbnail(const ThumbnailModel& model);
+        QList<int> updateThumbnails(const QList<ThumbnailModel>& models);
         void deleteThumbnails();
 
     private:
         QRecursiveMutex mutex;
+        QHash<QString, int> typeIds;
+        QHash<QString, int> deviceIds;
+        bool fullTextSearch = false;
 
         void createDatabase();
         void upgradeDatabase();
+        void createSearchIndex();
+
+        QString getSearchCondition(const QString& alias, const QString& index, const QString& filter) const;
+        QString getSearchValue(const QString& filter) const;
+        QByteArray getThumbnailData(const QVariant& value) const;
+        QSqlDatabase getThreadDatabase() const;
+
+        void insertLibrary(int deviceId, LibraryChangeSet& changeSet);
+        void deleteByIds(const QString& statement, const QList<int>& ids);
+        int getTypeId(const QString& value);
+        int getDeviceIdByAddress(const QString& address);
 };
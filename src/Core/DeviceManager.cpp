@@ -28,10 +28,15 @@ DeviceManager& DeviceManager::getInstance()
 
 void DeviceManager::initialize()
 {
+    this->useQueryConnection = (DatabaseManager::getInstance().getConfigurationByName("UseQueryConnection").getValue() == "true") ? true : false;
+    this->batchWrites = (DatabaseManager::getInstance().getConfigurationByName("BatchAmcpWrites").getValue() == "true") ? true : false;
+
     QList<DeviceModel> models = DatabaseManager::getInstance().getDevice();
     foreach (const DeviceModel& model, models)
     {
         QSharedPointer<CasparDevice> device(new CasparDevice(model.getAddress(), model.getPort()));
+        device->setPipelined(CasparDevice::supportsPipelining(model.getVersion()));
+        device->setBatchWrites(this->batchWrites);
 
         this->deviceModels.insert(model.getName(), model);
         this->devices.insert(model.getName(), device);
@@ -39,7 +44,11 @@ void DeviceManager::initialize()
         emit deviceAdded(*device);
 
         device->connectDevice();
+
+        addQueryDevice(model);
     }
+
+    updateShadowDevices();
 }
 
 void DeviceManager::uninitialize()
@@ -49,6 +58,28 @@ void DeviceManager::uninitialize()
         QSharedPointer<CasparDevice>& device = this->devices[key];
         device->disconnectDevice();
     }
+
+    foreach (const QString& key, this->queryDevices.keys())
+    {
+        QSharedPointer<CasparDevice>& device = this->queryDevices[key];
+        device->disconnectDevice();
+    }
+}
+
+void DeviceManager::addQueryDevice(const DeviceModel& model)
+{
+    // Library, thumbnail and info queries get their own connection so they never queue up in front of playout commands.
+    if (!this->useQueryConnection || model.getShadow() == "Yes")
+        return;
+
+    QSharedPointer<CasparDevice> device(new CasparDevice(model.getAddress(), model.getPort()));
+    device->setPipelined(CasparDevice::supportsPipelining(model.getVersion()));
+
+    this->queryDevices.insert(model.getName(), device);
+
+    emit queryDeviceAdded(*device);
+
+    device->connectDevice();
 }
 
 void DeviceManager::refresh()
@@ -74,6 +105,9 @@ void DeviceManager::refresh()
         {
             device->disconnectDevice();
 
+            if (this->queryDevices.contains(key))
+                this->queryDevices.take(key)->disconnectDevice();
+
             this->devices.remove(key);
             this->deviceModels.remove(key);
 
@@ -87,6 +121,8 @@ void DeviceManager::refresh()
         if (!this->devices.contains(model.getName()))
         {
             QSharedPointer<CasparDevice> device(new CasparDevice(model.getAddress(), model.getPort()));
+            device->setPipelined(CasparDevice::supportsPipelining(model.getVersion()));
+            device->setBatchWrites(this->batchWrites);
 
             this->deviceModels.insert(model.getName(), model);
             this->devices.insert(model.getName(), device);
@@ -94,8 +130,32 @@ void DeviceManager::refresh()
             emit deviceAdded(*device);
 
             device->connectDevice();
+
+            addQueryDevice(model);
         }
     }
+
+    updateShadowDevices();
+}
+
+void DeviceManager::updateShadowDevices()
+{
+    // The shadow servers mirror every primary server, resolve them once instead of on every playout command.
+    this->shadowDeviceModels.clear();
+    this->shadowDevices.clear();
+
+    foreach (const DeviceModel& model, this->deviceModels)
+    {
+        if (model.getShadow() == "No")
+            continue;
+
+        this->shadowDeviceModels.push_back(model);
+        this->shadowDevices.push_back(this->devices.value(model.getName()));
+    }
+
+    // Playout devices share a dispatch round with the shadow servers, so the skew between them is recorded.
+    foreach (const QString& key, this->devices.keys())
+        this->devices[key]->setFanOut(!this->shadowDevices.isEmpty(), this->deviceModels[key].getShadow() != "No");
 }
 
 QList<DeviceModel> DeviceManager::getDeviceModels() const
@@ -138,7 +198,32 @@ int DeviceManager::getDeviceCount() const
     return this->devices.count();
 }
 
+bool DeviceManager::usesQueryConnection() const
+{
+    return this->useQueryConnection;
+}
+
 const QSharedPointer<CasparDevice> DeviceManager::getDeviceByName(const QString& name) const
 {
     return this->devices.value(name);
 }
+
+const QList<DeviceModel>& DeviceManager::getShadowDeviceModels() const
+{
+    return this->shadowDeviceModels;
+}
+
+const QList<QSharedPointer<CasparDevice>>& DeviceManager::getShadowDevices() const
+{
+    return this->shadowDevices;
+}
+
+const QSharedPointer<CasparDevice> DeviceManager::getQueryDeviceByName(const QString& name) const
+{
+    // Fall back to the playout connection until the query connection is up.
+    const QSharedPointer<CasparDevice> device = this->queryDevices.value(name);
+    if (device != NULL && device->isConnected())
+        return device;
+
+    return this->devices.value(name);
+}
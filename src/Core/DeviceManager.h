@@ -5,6 +5,7 @@
 
 #include "CasparDevice.h"
 
+#include <QtCore/QList>
 #include <QtCore/QMap>
 #include <QtCore/QObject>
 #include <QtCore/QSharedPointer>
@@ -27,13 +28,28 @@ class CORE_EXPORT DeviceManager : public QObject
         const QSharedPointer<DeviceModel> getDeviceModelByAddress(const QString& address) const;
 
         int getDeviceCount() const;
+        bool usesQueryConnection() const;
         const QSharedPointer<CasparDevice> getDeviceByName(const QString& name) const;
+        const QSharedPointer<CasparDevice> getQueryDeviceByName(const QString& name) const;
+        const QList<DeviceModel>& getShadowDeviceModels() const;
+        const QList<QSharedPointer<CasparDevice>>& getShadowDevices() const;
 
         Q_SIGNAL void deviceRemoved();
         Q_SIGNAL void deviceAdded(CasparDevice&);
+        Q_SIGNAL void queryDeviceAdded(CasparDevice&);
 
     private:
+        bool useQueryConnection = false;
+        bool batchWrites = false;
+
         QMap<QString, DeviceModel> deviceModels;
         QMap<QString, QSharedPointer<CasparDevice>> devices;
+        QMap<QString, QSharedPointer<CasparDevice>> queryDevices;
+
+        QList<DeviceModel> shadowDeviceModels;
+        QList<QSharedPointer<CasparDevice>> shadowDevices;
+
+        void addQueryDevice(const DeviceModel& model);
+        void updateShadowDevices();
 };
 
@@ -0,0 +1,68 @@
+#include "LibraryChangeSet.h"
+
+#include <QtCore/QHash>
+
+LibraryChangeSet::LibraryChangeSet(const QList<LibraryModel>& libraryModels, const QList<LibraryModel>& serverModels)
+{
+    // Index the library by name, a duplicate name is never matched and gets deleted below.
+    QHash<QString, int> index;
+    index.reserve(libraryModels.count());
+    for (int i = 0; i < libraryModels.count(); i++)
+        index.insert(libraryModels.at(i).getName(), i);
+
+    QList<bool> matched(libraryModels.count(), false);
+    foreach (const LibraryModel& serverModel, serverModels)
+    {
+        QHash<QString, int>::const_iterator iterator = index.constFind(serverModel.getName());
+        if (iterator == index.constEnd())
+        {
+            this->insertModels.push_back(serverModel);
+            continue;
+        }
+
+        matched[iterator.value()] = true;
+
+        // Same name, but the file may have been replaced on the server.
+        const LibraryModel& libraryModel = libraryModels.at(iterator.value());
+        if (libraryModel.getType() != serverModel.getType() || libraryModel.getTimecode() != serverModel.getTimecode())
+            this->updateModels.push_back(LibraryModel(libraryModel.getId(), libraryModel.getLabel(), libraryModel.getName(), libraryModel.getDeviceName(),
+                                                      serverModel.getType(), libraryModel.getThumbnailId(), serverModel.getTimecode()));
+    }
+
+    for (int i = 0; i < libraryModels.count(); i++)
+    {
+        if (!matched.at(i))
+            this->deleteModels.push_back(libraryModels.at(i));
+    }
+}
+
+bool LibraryChangeSet::isEmpty() const
+{
+    return this->deleteModels.isEmpty() && this->insertModels.isEmpty() && this->updateModels.isEmpty();
+}
+
+void LibraryChangeSet::assignIds(int firstId)
+{
+    // The database hands out the ids up front, so the rows can be applied in memory without reading them back.
+    for (int i = 0; i < this->insertModels.count(); i++)
+    {
+        const LibraryModel& model = this->insertModels.at(i);
+        this->insertModels[i] = LibraryModel(firstId + i, model.getLabel(), model.getName(), model.getDeviceName(), model.getType(),
+                                             model.getThumbnailId(), model.getTimecode());
+    }
+}
+
+const QList<LibraryModel>& LibraryChangeSet::getDeleteModels() const
+{
+    return this->deleteModels;
+}
+
+const QList<LibraryModel>& LibraryChangeSet::getInsertModels() const
+{
+    return this->insertModels;
+}
+
+const QList<LibraryModel>& LibraryChangeSet::getUpdateModels() const
+{
+    return this->updateModels;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Shared.h"
+
+#include "Models/LibraryModel.h"
+
+#include <QtCore/QList>
+
+class CORE_EXPORT LibraryChangeSet
+{
+    public:
+        explicit LibraryChangeSet() { }
+        explicit LibraryChangeSet(const QList<LibraryModel>& libraryModels, const QList<LibraryModel>& serverModels);
+
+        bool isEmpty() const;
+        void assignIds(int firstId);
+
+        const QList<LibraryModel>& getDeleteModels() const;
+        const QList<LibraryModel>& getInsertModels() const;
+        const QList<LibraryModel>& getUpdateModels() const;
+
+    private:
+        QList<LibraryModel> deleteModels;
+        QList<LibraryModel> insertModels;
+        QList<LibraryModel> updateModels;
+};
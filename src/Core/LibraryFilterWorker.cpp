@@ -0,0 +1,101 @@
+#include "LibraryFilterWorker.h"
+#include "LibraryStore.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMetaObject>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSharedPointer>
+
+LibraryFilterWorker::LibraryFilterWorker(QObject* parent)
+    : QObject(parent), mutex(), generation(0)
+{
+}
+
+void LibraryFilterWorker::filter(const QString& filter, const QList<QString>& devices)
+{
+    QMutexLocker locker(&mutex);
+
+    // Only the latest request is kept, a search still running for an older one gives up.
+    this->generation.fetch_add(1, std::memory_order_relaxed);
+    this->pendingFilter = filter;
+    this->pendingDevices = devices;
+
+    if (this->pending)
+        return;
+
+    this->pending = true;
+    QMetaObject::invokeMethod(this, "run", Qt::QueuedConnection);
+}
+
+bool LibraryFilterWorker::takeResult(quint64& version, QString& filter, QList<QString>& devices, QList<LibraryModel>& media, QList<LibraryModel>& templates, QList<LibraryModel>& data)
+{
+    QMutexLocker locker(&mutex);
+
+    if (this->resultGeneration == 0 || this->resultGeneration != this->generation.load(std::memory_order_relaxed))
+        return false;
+
+    version = this->resultVersion;
+    filter = this->resultFilter;
+    devices = this->resultDevices;
+    media.swap(this->resultMedia);
+    templates.swap(this->resultTemplates);
+    data.swap(this->resultData);
+
+    this->resultGeneration = 0;
+
+    return true;
+}
+
+bool LibraryFilterWorker::isCancelled(quint64 generation) const
+{
+    return generation != this->generation.load(std::memory_order_relaxed);
+}
+
+void LibraryFilterWorker::run()
+{
+    QElapsedTimer time;
+    time.start();
+
+    quint64 generation;
+    QString filter;
+    QList<QString> devices;
+    {
+        QMutexLocker locker(&mutex);
+
+        generation = this->generation.load(std::memory_order_relaxed);
+        filter = this->pendingFilter;
+        devices = this->pendingDevices;
+
+        this->pending = false;
+    }
+
+    const QSharedPointer<const LibrarySnapshot> snapshot = LibraryStore::getInstance().getSnapshot();
+
+    QList<LibraryModel> media = snapshot->getMedia(filter, devices);
+    if (isCancelled(generation))
+        return;
+
+    QList<LibraryModel> templates = snapshot->getTemplate(filter, devices);
+    if (isCancelled(generation))
+        return;
+
+    QList<LibraryModel> data = snapshot->getData(filter, devices);
+    if (isCancelled(generation))
+        return;
+
+    {
+        QMutexLocker locker(&mutex);
+
+        this->resultGeneration = generation;
+        this->resultVersion = snapshot->getVersion();
+        this->resultFilter = filter;
+        this->resultDevices = devices;
+        this->resultMedia.swap(media);
+        this->resultTemplates.swap(templates);
+        this->resultData.swap(data);
+    }
+
+    qDebug("LibraryFilterWorker::run %lld msec", time.elapsed());
+
+    emit filtered();
+}
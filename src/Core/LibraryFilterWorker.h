@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Shared.h"
+
+#include "Models/LibraryModel.h"
+
+#include <atomic>
+
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+class CORE_EXPORT LibraryFilterWorker : public QObject
+{
+    Q_OBJECT
+
+    public:
+        explicit LibraryFilterWorker(QObject* parent = 0);
+
+        void filter(const QString& filter, const QList<QString>& devices);
+        bool takeResult(quint64& version, QString& filter, QList<QString>& devices, QList<LibraryModel>& media, QList<LibraryModel>& templates, QList<LibraryModel>& data);
+
+        Q_SIGNAL void filtered();
+
+    private:
+        QMutex mutex;
+
+        std::atomic<quint64> generation;
+
+        bool pending = false;
+        QString pendingFilter;
+        QList<QString> pendingDevices;
+
+        quint64 resultGeneration = 0;
+        quint64 resultVersion = 0;
+        QString resultFilter;
+        QList<QString> resultDevices;
+        QList<LibraryModel> resultMedia;
+        QList<LibraryModel> resultTemplates;
+        QList<LibraryModel> resultData;
+
+        bool isCancelled(quint64 generation) const;
+
+        Q_SLOT void run();
+};
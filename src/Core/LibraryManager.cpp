@@ -1,4 +1,6 @@
 #include "LibraryManager.h"
+#include "LibraryChangeSet.h"
+#include "LibraryStore.h"
 #include "DatabaseManager.h"
 #include "DeviceManager.h"
 #include "EventManager.h"
@@ -8,8 +10,12 @@
 #include "Events/Inspector/TemplateChangedEvent.h"
 #include "Models/DeviceModel.h"
 
+#include "AmcpDispatchRound.h"
+
+#include <QtCore/QHash>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QLoggingCategory>
 #include <QtCore/QTimer>
 #include <QtCore/QStringList>
 
@@ -17,12 +23,16 @@
 
 Q_GLOBAL_STATIC(LibraryManager, libraryManager)
 
+// Logged on every refresh, enable with QT_LOGGING_RULES="casparcg.connection.debug=true".
+Q_LOGGING_CATEGORY(connectionStatistics, "casparcg.connection", QtInfoMsg)
+
 LibraryManager::LibraryManager(QObject* parent)
     : QObject(parent)
 {
     QObject::connect(&this->refreshTimer, SIGNAL(timeout()), this, SLOT(refresh()));
     QObject::connect(&DeviceManager::getInstance(), SIGNAL(deviceRemoved()), this, SLOT(deviceRemoved()));
     QObject::connect(&DeviceManager::getInstance(), SIGNAL(deviceAdded(CasparDevice&)), this, SLOT(deviceAdded(CasparDevice&)));
+    QObject::connect(&DeviceManager::getInstance(), SIGNAL(queryDeviceAdded(CasparDevice&)), this, SLOT(deviceAdded(CasparDevice&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(autoRefreshLibrary(const AutoRefreshLibraryEvent&)), this, SLOT(autoRefreshLibrary(const AutoRefreshLibraryEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(refreshLibrary(const RefreshLibraryEvent&)), this, SLOT(refreshLibrary(const RefreshLibraryEvent&)));
 }
@@ -64,9 +74,6 @@ void LibraryManager::autoRefreshLibrary(const AutoRefreshLibraryEvent& event)
 
 void LibraryManager::refresh()
 {
-    // Clear out all thumbnail workers.
-    this->thumbnailWorkers.clear();
-
     DeviceManager::getInstance().refresh();
 
     if (DeviceManager::getInstance().getDeviceCount() == 0)
@@ -80,7 +87,28 @@ void LibraryManager::refresh()
         if (model.getShadow() == "Yes")
             continue;
 
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(model.getName());
+        const QSharedPointer<CasparDevice> playoutDevice = DeviceManager::getInstance().getDeviceByName(model.getName());
+        if (playoutDevice != NULL)
+        {
+            qCDebug(connectionStatistics, "Playout connection %s:%d, commands %d, queue depth %d, bytes written %lld, bytes read %lld",
+                                          qPrintable(playoutDevice->getAddress()), playoutDevice->getPort(), playoutDevice->getCommandCount(),
+                                          playoutDevice->getQueueDepth(), playoutDevice->getBytesWritten(), playoutDevice->getBytesRead());
+            qCDebug(connectionStatistics, "Playout connection %s:%d, writes %lld, commands per write %.1f, write latency %lld usec (max %lld usec)",
+                                          qPrintable(playoutDevice->getAddress()), playoutDevice->getPort(), playoutDevice->getWriteCount(), playoutDevice->getCommandsPerWrite(),
+                                          playoutDevice->getAverageWriteLatency(), playoutDevice->getMaxWriteLatency());
+        }
+
+        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getQueryDeviceByName(model.getName());
+        if (device != NULL && device != playoutDevice)
+        {
+            qCDebug(connectionStatistics, "Query connection %s:%d, commands %d, queue depth %d, bytes written %lld, bytes read %lld",
+                                          qPrintable(device->getAddress()), device->getPort(), device->getCommandCount(),
+                                          device->getQueueDepth(), device->getBytesWritten(), device->getBytesRead());
+            qCDebug(connectionStatistics, "Query connection %s:%d, writes %lld, commands per write %.1f, write latency %lld usec (max %lld usec)",
+                                          qPrintable(device->getAddress()), device->getPort(), device->getWriteCount(), device->getCommandsPerWrite(),
+                                          device->getAverageWriteLatency(), device->getMaxWriteLatency());
+        }
+
         if (device != NULL && device->isConnected())
         {
             device->refreshServerVersion();
@@ -92,11 +120,23 @@ void LibraryManager::refresh()
         }
     }
 
+    if (!DeviceManager::getInstance().getShadowDevices().isEmpty())
+        qCDebug(connectionStatistics, "Shadow fan-out rounds %lld, skew %lld usec (max %lld usec)",
+                                      AmcpDispatchRound::getRoundCount(), AmcpDispatchRound::getAverageSkew(), AmcpDispatchRound::getMaxSkew());
+
     this->refreshTimer.setInterval(DatabaseManager::getInstance().getConfigurationByName("RefreshLibraryInterval").getValue().toInt() * 1000);
 }
 
 void LibraryManager::deviceRemoved()
 {
+    foreach (const QString& address, this->thumbnailWorkers.keys())
+    {
+        if (DeviceManager::getInstance().getDeviceModelByAddress(address) == NULL)
+            this->thumbnailWorkers.remove(address);
+    }
+
+    LibraryStore::getInstance().load();
+
     EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
     EventManager::getInstance().fireTemplateChangedEvent(TemplateChangedEvent());
     EventManager::getInstance().fireDataChangedEvent(DataChangedEvent());
@@ -115,6 +155,13 @@ void LibraryManager::deviceAdded(CasparDevice& device)
 
 void LibraryManager::versionChanged(const QString& version, CasparDevice& device)
 {
+    device.setPipelined(CasparDevice::supportsPipelining(version));
+
+    // The version is queried on the query connection when there is one, the playout connection shares the server.
+    const QSharedPointer<DeviceModel> model = DeviceManager::getInstance().getDeviceModelByAddress(device.getAddress());
+    if (model != NULL && DeviceManager::getInstance().getDeviceByName(model->getName()) != NULL)
+        DeviceManager::getInstance().getDeviceByName(model->getName())->setPipelined(CasparDevice::supportsPipelining(version));
+
     DatabaseManager::getInstance().updateDeviceVersion(DeviceModel(0, "", device.getAddress(), 0, "", "", "", version, "", 0, "", 0, 0));
 }
 
@@ -137,6 +184,11 @@ void LibraryManager::connectionStateChanged(CasparDevice& device)
         if (model == NULL || model->getShadow() == "Yes")
             return;
 
+        // With a query connection the library is refreshed when that connection comes up.
+        bool isQueryDevice = (DeviceManager::getInstance().getDeviceByName(model->getName()).data() != &device);
+        if (DeviceManager::getInstance().usesQueryConnection() != isQueryDevice)
+            return;
+
         device.refreshServerVersion();
         device.refreshChannels();
         device.refreshMedia();
@@ -151,45 +203,22 @@ void LibraryManager::mediaChanged(const QList<CasparMedia>& mediaItems, CasparDe
     QElapsedTimer time;
     time.start();
 
-    QList<LibraryModel> insertModels;
-    QList<LibraryModel> deleteModels;
-    QList<LibraryModel> libraryModels = DatabaseManager::getInstance().getLibraryMediaByDeviceAddress(device.getAddress());
+    QList<LibraryModel> serverModels;
+    serverModels.reserve(mediaItems.count());
+    foreach (const CasparMedia& mediaItem, mediaItems)
+        serverModels.push_back(LibraryModel(0, mediaItem.getName(), mediaItem.getName(), "", mediaItem.getType(), 0, mediaItem.getTimecode()));
 
-    // Find library items to delete.
-    foreach (const LibraryModel& libraryModel, libraryModels)
+    LibraryChangeSet changeSet(LibraryStore::getInstance().getSnapshot()->getMediaByDeviceAddress(device.getAddress()), serverModels);
+    if (!changeSet.isEmpty())
     {
-        bool found = false;
-        foreach (CasparMedia mediaItem, mediaItems)
-        {
-            if (mediaItem.getName() == libraryModel.getName())
-                found = true;
-        }
-
-        if (!found)
-            deleteModels.push_back(libraryModel);
-    }
-
-    // Find library items to insert.
-    foreach (CasparMedia mediaItem, mediaItems)
-    {
-        bool found = false;
-        foreach (const LibraryModel& libraryModel, libraryModels)
-        {
-            if (libraryModel.getName() == mediaItem.getName())
-                found = true;
-        }
-
-        if (!found)
-            insertModels.push_back(LibraryModel(0, mediaItem.getName(), mediaItem.getName(), "", mediaItem.getType(), 0, mediaItem.getTimecode()));
-    }
-
-    if (deleteModels.count() > 0 || insertModels.count() > 0)
-    {
-        DatabaseManager::getInstance().updateLibraryMedia(device.getAddress(), deleteModels, insertModels);
+        DatabaseManager::getInstance().updateLibraryMedia(device.getAddress(), changeSet);
+        LibraryStore::getInstance().updateMedia(device.getAddress(), changeSet);
         EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
     }
 
-    qDebug("LibraryManager::mediaChanged %lld msec", time.elapsed());
+    qDebug("LibraryManager::mediaChanged %lld msec (%d items, %d inserted, %d updated, %d deleted)", time.elapsed(),
+           static_cast<int>(mediaItems.count()), static_cast<int>(changeSet.getInsertModels().count()),
+           static_cast<int>(changeSet.getUpdateModels().count()), static_cast<int>(changeSet.getDeleteModels().count()));
 }
 
 void LibraryManager::templateChanged(const QList<CasparTemplate>& templateItems, CasparDevice& device)
@@ -197,45 +226,22 @@ void LibraryManager::templateChanged(const QList<CasparTemplate>& templateItems,
     QElapsedTimer time;
     time.start();
 
-    QList<LibraryModel> insertModels;
-    QList<LibraryModel> deleteModels;
-    QList<LibraryModel> libraryModels = DatabaseManager::getInstance().getLibraryTemplateByDeviceAddress(device.getAddress());
-
-    // Find library items to delete.
-    foreach (const LibraryModel& libraryModel, libraryModels)
-    {
-        bool found = false;
-        foreach (CasparTemplate templateItem, templateItems)
-        {
-            if (templateItem.getName() == libraryModel.getName())
-                found = true;
-        }
-
-        if (!found)
-            deleteModels.push_back(libraryModel);
-    }
+    QList<LibraryModel> serverModels;
+    serverModels.reserve(templateItems.count());
+    foreach (const CasparTemplate& templateItem, templateItems)
+        serverModels.push_back(LibraryModel(0, templateItem.getName(), templateItem.getName(), "", "TEMPLATE", 0, ""));
 
-    // Find library items to insert.
-    foreach (CasparTemplate templateItem, templateItems)
+    LibraryChangeSet changeSet(LibraryStore::getInstance().getSnapshot()->getTemplateByDeviceAddress(device.getAddress()), serverModels);
+    if (!changeSet.isEmpty())
     {
-        bool found = false;
-        foreach (const LibraryModel& libraryModel, libraryModels)
-        {
-            if (libraryModel.getName() == templateItem.getName())
-                found = true;
-        }
-
-        if (!found)
-            insertModels.push_back(LibraryModel(0, templateItem.getName(), templateItem.getName(), "", "TEMPLATE", 0, ""));
-    }
-
-    if (deleteModels.count() > 0 || insertModels.count() > 0)
-    {
-        DatabaseManager::getInstance().updateLibraryTemplate(device.getAddress(), deleteModels, insertModels);
+        DatabaseManager::getInstance().updateLibraryTemplate(device.getAddress(), changeSet);
+        LibraryStore::getInstance().updateTemplate(device.getAddress(), changeSet);
         EventManager::getInstance().fireTemplateChangedEvent(TemplateChangedEvent());
     }
 
-    qDebug("LibraryManager::templateChanged %lld msec", time.elapsed());
+    qDebug("LibraryManager::templateChanged %lld msec (%d items, %d inserted, %d updated, %d deleted)", time.elapsed(),
+           static_cast<int>(templateItems.count()), static_cast<int>(changeSet.getInsertModels().count()),
+           static_cast<int>(changeSet.getUpdateModels().count()), static_cast<int>(changeSet.getDeleteModels().count()));
 }
 
 void LibraryManager::dataChanged(const QList<CasparData>& dataItems, CasparDevice& device)
@@ -243,45 +249,22 @@ void LibraryManager::dataChanged(const QList<CasparData>& dataItems, CasparDevic
     QElapsedTimer time;
     time.start();
 
-    QList<LibraryModel> insertModels;
-    QList<LibraryModel> deleteModels;
-    QList<LibraryModel> libraryModels = DatabaseManager::getInstance().getLibraryDataByDeviceAddress(device.getAddress());
-
-    // Find library items to delete.
-    foreach (const LibraryModel& libraryModel, libraryModels)
-    {
-        bool found = false;
-        foreach (CasparData dataItem, dataItems)
-        {
-            if (dataItem.getName() == libraryModel.getName())
-                found = true;
-        }
-
-        if (!found)
-            deleteModels.push_back(libraryModel);
-    }
-
-    // Find library items to insert.
-    foreach (CasparData dataItem, dataItems)
-    {
-        bool found = false;
-        foreach (const LibraryModel& libraryModel, libraryModels)
-        {
-            if (libraryModel.getName() == dataItem.getName())
-                found = true;
-        }
-
-        if (!found)
-            insertModels.push_back(LibraryModel(0, dataItem.getName(), dataItem.getName(), "", "DATA", 0, ""));
-    }
+    QList<LibraryModel> serverModels;
+    serverModels.reserve(dataItems.count());
+    foreach (const CasparData& dataItem, dataItems)
+        serverModels.push_back(LibraryModel(0, dataItem.getName(), dataItem.getName(), "", "DATA", 0, ""));
 
-    if (deleteModels.count() > 0 || insertModels.count() > 0)
+    LibraryChangeSet changeSet(LibraryStore::getInstance().getSnapshot()->getDataByDeviceAddress(device.getAddress()), serverModels);
+    if (!changeSet.isEmpty())
     {
-        DatabaseManager::getInstance().updateLibraryData(device.getAddress(), deleteModels, insertModels);
+        DatabaseManager::getInstance().updateLibraryData(device.getAddress(), changeSet);
+        LibraryStore::getInstance().updateData(device.getAddress(), changeSet);
         EventManager::getInstance().fireDataChangedEvent(DataChangedEvent());
     }
 
-    qDebug("LibraryManager::dataChanged %lld msec", time.elapsed());
+    qDebug("LibraryManager::dataChanged %lld msec (%d items, %d inserted, %d updated, %d deleted)", time.elapsed(),
+           static_cast<int>(dataItems.count()), static_cast<int>(changeSet.getInsertModels().count()),
+           static_cast<int>(changeSet.getUpdateModels().count()), static_cast<int>(changeSet.getDeleteModels().count()));
 }
 
 void LibraryManager::thumbnailChanged(const QList<CasparThumbnail>& thumbnailItems, CasparDevice& device)
@@ -289,29 +272,44 @@ void LibraryManager::thumbnailChanged(const QList<CasparThumbnail>& thumbnailIte
     QList<ThumbnailModel> processModels;
     QList<ThumbnailModel> thumbnailModels = DatabaseManager::getInstance().getThumbnailByDeviceAddress(device.getAddress());
 
+    QHash<QString, const ThumbnailModel*> thumbnailIndex;
+    thumbnailIndex.reserve(thumbnailModels.count());
+    foreach (const ThumbnailModel& thumbnailModel, thumbnailModels)
+        thumbnailIndex.insert(thumbnailModel.getName(), &thumbnailModel);
+
     // Find thumbnail items to process.
-    foreach (CasparThumbnail thumbnailItem, thumbnailItems)
+    foreach (const CasparThumbnail& thumbnailItem, thumbnailItems)
     {
-        bool found = false;
-        foreach (const ThumbnailModel& thumbnailModel, thumbnailModels)
-        {
-            if (thumbnailModel.getName() == thumbnailItem.getName() &&
-                thumbnailModel.getTimestamp() == thumbnailItem.getTimestamp() &&
-                thumbnailModel.getSize() == thumbnailItem.getSize())
-                found = true;
-        }
-
-        if (!found)
-            processModels.push_back(ThumbnailModel(0, "", thumbnailItem.getTimestamp(), thumbnailItem.getSize(),
+        const ThumbnailModel* thumbnailModel = thumbnailIndex.value(thumbnailItem.getName());
+        if (thumbnailModel == nullptr ||
+            thumbnailModel->getTimestamp() != thumbnailItem.getTimestamp() ||
+            thumbnailModel->getSize() != thumbnailItem.getSize())
+            processModels.push_back(ThumbnailModel(0, QByteArray(), thumbnailItem.getTimestamp(), thumbnailItem.getSize(),
                                                    thumbnailItem.getName(), device.getAddress()));
     }
 
     bool storeThumbnailsInDatabase = (DatabaseManager::getInstance().getConfigurationByName("StoreThumbnailsInDatabase").getValue() == "true") ? true : false;
     if (storeThumbnailsInDatabase)
     {
-        QSharedPointer<ThumbnailWorker> thumbnailWorker(new ThumbnailWorker(processModels));
-        thumbnailWorker->start();
-
-        this->thumbnailWorkers.push_back(thumbnailWorker);
+        // One worker per server, it outlives refreshes and reconnects so retrieval continues where it left off.
+        getThumbnailWorker(device.getAddress())->enqueue(processModels);
     }
 }
+
+void LibraryManager::prioritizeThumbnail(const QString& name, const QString& deviceName)
+{
+    const QSharedPointer<DeviceModel> model = DeviceManager::getInstance().getDeviceModelByName(deviceName);
+    if (model == NULL)
+        return;
+
+    // The worker may not exist yet when a rundown is opened before the server listed its thumbnails.
+    getThumbnailWorker(model->getAddress())->prioritize(name);
+}
+
+const QSharedPointer<ThumbnailWorker> LibraryManager::getThumbnailWorker(const QString& address)
+{
+    if (!this->thumbnailWorkers.contains(address))
+        this->thumbnailWorkers.insert(address, QSharedPointer<ThumbnailWorker>(new ThumbnailWorker(address)));
+
+    return this->thumbnailWorkers.value(address);
+}
@@ -14,6 +14,7 @@
 #include "Models/CasparTemplate.h"
 #include "Models/CasparThumbnail.h"
 
+#include <QtCore/QMap>
 #include <QtCore/QObject>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QTimer>
@@ -29,10 +30,13 @@ class CORE_EXPORT LibraryManager : public QObject
 
         void initialize();
         void uninitialize();
+        void prioritizeThumbnail(const QString& name, const QString& deviceName);
 
     private:
         QTimer refreshTimer;
-        QList<QSharedPointer<ThumbnailWorker>> thumbnailWorkers;
+        QMap<QString, QSharedPointer<ThumbnailWorker>> thumbnailWorkers;
+
+        const QSharedPointer<ThumbnailWorker> getThumbnailWorker(const QString& address);
 
         Q_SLOT void refresh();
         Q_SLOT void deviceRemoved();
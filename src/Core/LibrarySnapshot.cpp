@@ -0,0 +1,120 @@
+#include "LibrarySnapshot.h"
+
+#include <algorithm>
+#include <iterator>
+
+LibrarySnapshot::LibrarySnapshot(quint64 version, const QMap<QString, QList<LibraryModel>>& media, const QMap<QString, QList<LibraryModel>>& templates,
+                                 const QMap<QString, QList<LibraryModel>>& data)
+    : version(version), media(media), templates(templates), data(data)
+{
+}
+
+quint64 LibrarySnapshot::getVersion() const
+{
+    return this->version;
+}
+
+QList<LibraryModel> LibrarySnapshot::getMedia(const QString& filter, const QList<QString>& devices) const
+{
+    QList<LibraryModel> prefixModels;
+    QList<LibraryModel> otherModels;
+    collect(this->media, filter, devices, prefixModels, otherModels);
+
+    return prefixModels + otherModels;
+}
+
+QList<LibraryModel> LibrarySnapshot::getTemplate(const QString& filter, const QList<QString>& devices) const
+{
+    QList<LibraryModel> prefixModels;
+    QList<LibraryModel> otherModels;
+    collect(this->templates, filter, devices, prefixModels, otherModels);
+
+    return prefixModels + otherModels;
+}
+
+QList<LibraryModel> LibrarySnapshot::getData(const QString& filter, const QList<QString>& devices) const
+{
+    QList<LibraryModel> prefixModels;
+    QList<LibraryModel> otherModels;
+    collect(this->data, filter, devices, prefixModels, otherModels);
+
+    return prefixModels + otherModels;
+}
+
+QList<LibraryModel> LibrarySnapshot::getByDeviceAddress(const QString& address, const QString& filter) const
+{
+    QList<QString> devices;
+    devices.push_back(address);
+
+    QList<LibraryModel> prefixModels;
+    QList<LibraryModel> otherModels;
+    collect(this->media, filter, devices, prefixModels, otherModels);
+    collect(this->templates, filter, devices, prefixModels, otherModels);
+    collect(this->data, filter, devices, prefixModels, otherModels);
+
+    return prefixModels + otherModels;
+}
+
+const QList<LibraryModel> LibrarySnapshot::getMediaByDeviceAddress(const QString& address) const
+{
+    return this->media.value(address);
+}
+
+const QList<LibraryModel> LibrarySnapshot::getTemplateByDeviceAddress(const QString& address) const
+{
+    return this->templates.value(address);
+}
+
+const QList<LibraryModel> LibrarySnapshot::getDataByDeviceAddress(const QString& address) const
+{
+    return this->data.value(address);
+}
+
+void LibrarySnapshot::collect(const QMap<QString, QList<LibraryModel>>& items, const QString& filter, const QList<QString>& devices,
+                              QList<LibraryModel>& prefixModels, QList<LibraryModel>& otherModels) const
+{
+    for (QMap<QString, QList<LibraryModel>>::const_iterator iterator = items.constBegin(); iterator != items.constEnd(); ++iterator)
+    {
+        if (!devices.isEmpty() && !devices.contains(iterator.key()))
+            continue;
+
+        if (filter.isEmpty())
+        {
+            merge(prefixModels, iterator.value());
+            continue;
+        }
+
+        // Prefix matches rank first, the same order as the database search.
+        QList<LibraryModel> prefix;
+        QList<LibraryModel> other;
+        foreach (const LibraryModel& model, iterator.value())
+        {
+            if (model.getName().startsWith(filter, Qt::CaseInsensitive))
+                prefix.push_back(model);
+            else if (model.getName().contains(filter, Qt::CaseInsensitive))
+                other.push_back(model);
+        }
+
+        merge(prefixModels, prefix);
+        merge(otherModels, other);
+    }
+}
+
+void LibrarySnapshot::merge(QList<LibraryModel>& models, const QList<LibraryModel>& other)
+{
+    // Every device list is already sorted by name, so devices are merged instead of sorting the result.
+    if (other.isEmpty())
+        return;
+
+    if (models.isEmpty())
+    {
+        models = other;
+        return;
+    }
+
+    QList<LibraryModel> merged;
+    merged.reserve(models.count() + other.count());
+    std::merge(models.constBegin(), models.constEnd(), other.constBegin(), other.constEnd(), std::back_inserter(merged), LibraryModel::LessByName());
+
+    models = merged;
+}
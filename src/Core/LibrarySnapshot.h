@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Shared.h"
+
+#include "Models/LibraryModel.h"
+
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+
+class CORE_EXPORT LibrarySnapshot
+{
+    public:
+        explicit LibrarySnapshot(quint64 version, const QMap<QString, QList<LibraryModel>>& media, const QMap<QString, QList<LibraryModel>>& templates,
+                                 const QMap<QString, QList<LibraryModel>>& data);
+
+        quint64 getVersion() const;
+
+        QList<LibraryModel> getMedia(const QString& filter = "", const QList<QString>& devices = QList<QString>()) const;
+        QList<LibraryModel> getTemplate(const QString& filter = "", const QList<QString>& devices = QList<QString>()) const;
+        QList<LibraryModel> getData(const QString& filter = "", const QList<QString>& devices = QList<QString>()) const;
+        QList<LibraryModel> getByDeviceAddress(const QString& address, const QString& filter = "") const;
+
+        const QList<LibraryModel> getMediaByDeviceAddress(const QString& address) const;
+        const QList<LibraryModel> getTemplateByDeviceAddress(const QString& address) const;
+        const QList<LibraryModel> getDataByDeviceAddress(const QString& address) const;
+
+    private:
+        quint64 version;
+
+        QMap<QString, QList<LibraryModel>> media;
+        QMap<QString, QList<LibraryModel>> templates;
+        QMap<QString, QList<LibraryModel>> data;
+
+        void collect(const QMap<QString, QList<LibraryModel>>& items, const QString& filter, const QList<QString>& devices,
+                     QList<LibraryModel>& prefixModels, QList<LibraryModel>& otherModels) const;
+
+        static void merge(QList<LibraryModel>& models, const QList<LibraryModel>& other);
+};
@@ -0,0 +1,176 @@
+#include "LibraryStore.h"
+#include "DatabaseManager.h"
+#include "DeviceManager.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSet>
+
+Q_GLOBAL_STATIC(LibraryStore, libraryStore)
+
+LibraryStore::LibraryStore()
+    : mutex()
+{
+}
+
+LibraryStore& LibraryStore::getInstance()
+{
+    return *libraryStore();
+}
+
+void LibraryStore::load()
+{
+    QElapsedTimer time;
+    time.start();
+
+    QMap<QString, QList<LibraryModel>> media;
+    QMap<QString, QList<LibraryModel>> templates;
+    QMap<QString, QList<LibraryModel>> data;
+    foreach (const DeviceModel& model, DatabaseManager::getInstance().getDevice())
+    {
+        media.insert(model.getAddress(), loadItems(DatabaseManager::getInstance().getLibraryMediaByDeviceAddress(model.getAddress())));
+        templates.insert(model.getAddress(), loadItems(DatabaseManager::getInstance().getLibraryTemplateByDeviceAddress(model.getAddress())));
+        data.insert(model.getAddress(), loadItems(DatabaseManager::getInstance().getLibraryDataByDeviceAddress(model.getAddress())));
+    }
+
+    QMutexLocker locker(&mutex);
+
+    this->media.swap(media);
+    this->templates.swap(templates);
+    this->data.swap(data);
+    this->changed = true;
+
+    qDebug("LibraryStore::load %lld msec", time.elapsed());
+}
+
+QList<LibraryModel> LibraryStore::loadItems(const QList<LibraryModel>& models)
+{
+    QMutexLocker locker(&mutex);
+
+    QList<LibraryModel> items;
+    items.reserve(models.count());
+    foreach (const LibraryModel& model, models)
+        items.push_back(intern(model, model.getDeviceName()));
+
+    std::sort(items.begin(), items.end(), LibraryModel::LessByName());
+
+    return items;
+}
+
+void LibraryStore::updateMedia(const QString& address, const LibraryChangeSet& changeSet)
+{
+    update(this->media, address, changeSet);
+}
+
+void LibraryStore::updateTemplate(const QString& address, const LibraryChangeSet& changeSet)
+{
+    update(this->templates, address, changeSet);
+}
+
+void LibraryStore::updateData(const QString& address, const LibraryChangeSet& changeSet)
+{
+    update(this->data, address, changeSet);
+}
+
+void LibraryStore::updateThumbnail(const QString& address, const QString& name, int thumbnailId)
+{
+    QMutexLocker locker(&mutex);
+
+    if (!this->media.contains(address))
+        return;
+
+    QList<LibraryModel>& items = this->media[address];
+    QList<LibraryModel>::iterator iterator = std::lower_bound(items.begin(), items.end(), name, LibraryModel::LessByName());
+    for (; iterator != items.end() && iterator->getName() == name; ++iterator)
+    {
+        if (iterator->getThumbnailId() == thumbnailId)
+            continue;
+
+        *iterator = LibraryModel(iterator->getId(), iterator->getLabel(), iterator->getName(), iterator->getDeviceName(), iterator->getType(),
+                                 thumbnailId, iterator->getTimecode());
+        this->changed = true;
+    }
+}
+
+QSharedPointer<const LibrarySnapshot> LibraryStore::getSnapshot()
+{
+    QMutexLocker locker(&mutex);
+
+    // Published on demand, a burst of updates between two reads only costs one snapshot.
+    if (this->changed)
+    {
+        this->snapshot = QSharedPointer<const LibrarySnapshot>(new LibrarySnapshot(++this->version, this->media, this->templates, this->data));
+        this->changed = false;
+    }
+
+    return this->snapshot;
+}
+
+void LibraryStore::update(QMap<QString, QList<LibraryModel>>& items, const QString& address, const LibraryChangeSet& changeSet)
+{
+    if (changeSet.isEmpty())
+        return;
+
+    const QSharedPointer<DeviceModel> device = DeviceManager::getInstance().getDeviceModelByAddress(address);
+    QString deviceName = (device != NULL) ? device->getName() : "";
+
+    QSet<int> deleteIds;
+    foreach (const LibraryModel& model, changeSet.getDeleteModels())
+        deleteIds.insert(model.getId());
+
+    QHash<int, LibraryModel> updateModels;
+    foreach (const LibraryModel& model, changeSet.getUpdateModels())
+        updateModels.insert(model.getId(), model);
+
+    QMutexLocker locker(&mutex);
+
+    const QList<LibraryModel>& models = items.value(address);
+
+    // Updates never change the name, the remaining rows stay sorted.
+    QList<LibraryModel> remaining;
+    remaining.reserve(models.count());
+    foreach (const LibraryModel& model, models)
+    {
+        if (deleteIds.contains(model.getId()))
+            continue;
+
+        if (updateModels.contains(model.getId()))
+            remaining.push_back(intern(updateModels.value(model.getId()), model.getDeviceName()));
+        else
+            remaining.push_back(model);
+    }
+
+    QList<LibraryModel> insertModels;
+    insertModels.reserve(changeSet.getInsertModels().count());
+    foreach (const LibraryModel& model, changeSet.getInsertModels())
+        insertModels.push_back(intern(model, deviceName));
+
+    std::sort(insertModels.begin(), insertModels.end(), LibraryModel::LessByName());
+
+    QList<LibraryModel> merged;
+    merged.reserve(remaining.count() + insertModels.count());
+    std::merge(remaining.constBegin(), remaining.constEnd(), insertModels.constBegin(), insertModels.constEnd(), std::back_inserter(merged), LibraryModel::LessByName());
+
+    items.insert(address, merged);
+    this->changed = true;
+}
+
+QString LibraryStore::intern(const QString& value)
+{
+    // Device names and types repeat on every row, all rows share one copy of each.
+    QHash<QString, QString>::const_iterator iterator = this->strings.constFind(value);
+    if (iterator != this->strings.constEnd())
+        return iterator.value();
+
+    this->strings.insert(value, value);
+
+    return value;
+}
+
+LibraryModel LibraryStore::intern(const LibraryModel& model, const QString& deviceName)
+{
+    return LibraryModel(model.getId(), model.getName(), model.getName(), intern(deviceName), intern(model.getType()), model.getThumbnailId(), model.getTimecode());
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Shared.h"
+
+#include "LibraryChangeSet.h"
+#include "LibrarySnapshot.h"
+
+#include "Models/LibraryModel.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+
+class CORE_EXPORT LibraryStore
+{
+    public:
+        explicit LibraryStore();
+
+        static LibraryStore& getInstance();
+
+        void load();
+
+        void updateMedia(const QString& address, const LibraryChangeSet& changeSet);
+        void updateTemplate(const QString& address, const LibraryChangeSet& changeSet);
+        void updateData(const QString& address, const LibraryChangeSet& changeSet);
+        void updateThumbnail(const QString& address, const QString& name, int thumbnailId);
+
+        QSharedPointer<const LibrarySnapshot> getSnapshot();
+
+    private:
+        QMutex mutex;
+
+        quint64 version = 0;
+        bool changed = true;
+
+        QMap<QString, QList<LibraryModel>> media;
+        QMap<QString, QList<LibraryModel>> templates;
+        QMap<QString, QList<LibraryModel>> data;
+
+        QHash<QString, QString> strings;
+
+        QSharedPointer<const LibrarySnapshot> snapshot;
+
+        QString intern(const QString& value);
+        LibraryModel intern(const LibraryModel& model, const QString& deviceName);
+        QList<LibraryModel> loadItems(const QList<LibraryModel>& models);
+        void update(QMap<QString, QList<LibraryModel>>& items, const QString& address, const LibraryChangeSet& changeSet);
+};
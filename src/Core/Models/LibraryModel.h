@@ -24,6 +24,13 @@ class CORE_EXPORT LibraryModel
         void setDeviceName(const QString& deviceName);
         void setTimecode(const QString& timecode);
 
+        class LessByName
+        {
+            public:
+                bool operator()(const LibraryModel& left, const LibraryModel& right) const { return left.getName() < right.getName(); }
+                bool operator()(const LibraryModel& model, const QString& name) const { return model.getName() < name; }
+        };
+
     private:
         int id;
         QString label;
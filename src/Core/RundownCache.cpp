@@ -0,0 +1,196 @@
+#include "RundownCache.h"
+
+#include "Global.h"
+#include "RundownReader.h"
+#include "Version.h"
+
+#include <cstring>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+
+// Bump when the layout below changes, older cache files are then ignored and rewritten.
+static const quint32 CACHE_FORMAT = 1;
+static const char CACHE_MAGIC[4] = { 'C', 'G', 'R', 'C' };
+
+static const quint32 FLAG_HAS_ALLOW_REMOTE_TRIGGERING = 0x1;
+static const quint32 FLAG_ALLOW_REMOTE_TRIGGERING = 0x2;
+
+RundownCache::RundownCache(const QString& hash)
+    : hash(hash)
+{
+    this->path = QString("%1/.CasparCG/Client/Cache/Rundowns/%2.cache").arg(QDir::homePath()).arg(hash);
+}
+
+bool RundownCache::read(RundownReader& reader) const
+{
+    reader.clear();
+
+    QFile file(this->path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    if (file.size() < static_cast<qint64>(sizeof(RundownCacheHeader)))
+        return false;
+
+    // The file is mapped, strings are converted straight from the mapping without an intermediate copy.
+    const uchar* data = file.map(0, file.size());
+    if (data == NULL)
+        return false;
+
+    RundownCacheHeader header;
+    std::memcpy(&header, data, sizeof(RundownCacheHeader));
+
+    QByteArray version = QByteArray(RC_VERSION).left(sizeof(header.version) - 1);
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.format != CACHE_FORMAT ||
+        qstrncmp(header.version, version.constData(), sizeof(header.version)) != 0 ||
+        QString::fromLatin1(header.hash, qstrnlen(header.hash, sizeof(header.hash))) != this->hash)
+        return false;
+
+    qint64 size = sizeof(RundownCacheHeader) + static_cast<qint64>(header.nodeCount) * sizeof(RundownCacheNode) + static_cast<qint64>(header.stringSize) * sizeof(char16_t);
+    if (size != file.size())
+    {
+        qCritical("Failed to read rundown cache %s: Unexpected size", qPrintable(this->path));
+        return false;
+    }
+
+    const RundownCacheNode* nodes = reinterpret_cast<const RundownCacheNode*>(data + sizeof(RundownCacheHeader));
+    const char16_t* strings = reinterpret_cast<const char16_t*>(nodes + header.nodeCount);
+
+    quint32 index = 0;
+    for (quint32 i = 0; i < header.itemCount; i++)
+    {
+        reader.getItems().append(boost::property_tree::wptree());
+        if (!readNode(nodes, header.nodeCount, index, strings, header.stringSize, reader.getItems().last()))
+        {
+            qCritical("Failed to read rundown cache %s: Invalid node", qPrintable(this->path));
+            reader.clear();
+
+            return false;
+        }
+    }
+
+    if (header.flags & FLAG_HAS_ALLOW_REMOTE_TRIGGERING)
+        reader.setAllowRemoteTriggering(header.flags & FLAG_ALLOW_REMOTE_TRIGGERING);
+
+    return true;
+}
+
+bool RundownCache::readNode(const RundownCacheNode* nodes, quint32 nodeCount, quint32& index, const char16_t* strings, quint32 stringSize, boost::property_tree::wptree& pt) const
+{
+    if (index >= nodeCount)
+        return false;
+
+    const RundownCacheNode& node = nodes[index++];
+    if (static_cast<quint64>(node.value) + node.valueSize > stringSize)
+        return false;
+
+    if (node.valueSize > 0)
+        pt.put_value(QString::fromRawData(reinterpret_cast<const QChar*>(strings + node.value), node.valueSize).toStdWString());
+
+    for (quint32 i = 0; i < node.childCount; i++)
+    {
+        if (index >= nodeCount)
+            return false;
+
+        const RundownCacheNode& child = nodes[index];
+        if (static_cast<quint64>(child.key) + child.keySize > stringSize)
+            return false;
+
+        std::wstring key = QString::fromRawData(reinterpret_cast<const QChar*>(strings + child.key), child.keySize).toStdWString();
+        if (!readNode(nodes, nodeCount, index, strings, stringSize, pt.push_back(std::make_pair(key, boost::property_tree::wptree()))->second))
+            return false;
+    }
+
+    return true;
+}
+
+bool RundownCache::write(const RundownReader& reader) const
+{
+    // Nodes are stored in pre order with their child count, keys and values point into one shared
+    // UTF-16 string table. Element names repeat for every item so each distinct string is stored once.
+    QVector<RundownCacheNode> nodes;
+    QString strings;
+    QHash<QString, quint32> offsets;
+    foreach (const boost::property_tree::wptree& pt, reader.getItems())
+        writeNode(L"item", pt, nodes, strings, offsets);
+
+    RundownCacheHeader header;
+    std::memset(&header, 0, sizeof(RundownCacheHeader));
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.format = CACHE_FORMAT;
+    qstrncpy(header.version, RC_VERSION, sizeof(header.version));
+    QByteArray hash = this->hash.toLatin1().left(sizeof(header.hash));
+    std::memcpy(header.hash, hash.constData(), hash.size());
+    header.flags = (reader.hasAllowRemoteTriggering() ? FLAG_HAS_ALLOW_REMOTE_TRIGGERING : 0) |
+                   (reader.getAllowRemoteTriggering() ? FLAG_ALLOW_REMOTE_TRIGGERING : 0);
+    header.itemCount = reader.getItems().count();
+    header.nodeCount = nodes.count();
+    header.stringSize = strings.size();
+
+    QDir directory(QFileInfo(this->path).absolutePath());
+    if (!directory.exists())
+        directory.mkpath(".");
+
+    QSaveFile file(this->path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCritical("Failed to write rundown cache %s: %s", qPrintable(this->path), qPrintable(file.errorString()));
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(RundownCacheHeader));
+    file.write(reinterpret_cast<const char*>(nodes.constData()), nodes.count() * sizeof(RundownCacheNode));
+    file.write(reinterpret_cast<const char*>(strings.constData()), strings.size() * sizeof(char16_t));
+
+    if (!file.commit())
+    {
+        qCritical("Failed to write rundown cache %s: %s", qPrintable(this->path), qPrintable(file.errorString()));
+        return false;
+    }
+
+    prune();
+
+    return true;
+}
+
+void RundownCache::writeNode(const std::wstring& key, const boost::property_tree::wptree& pt, QVector<RundownCacheNode>& nodes, QString& strings, QHash<QString, quint32>& offsets) const
+{
+    RundownCacheNode node;
+    node.childCount = pt.size();
+
+    QString keyString = QString::fromStdWString(key);
+    QString valueString = QString::fromStdWString(pt.data());
+
+    node.keySize = keyString.size();
+    node.key = offsets.value(keyString, strings.size());
+    if (node.key == static_cast<quint32>(strings.size()))
+    {
+        offsets.insert(keyString, node.key);
+        strings.append(keyString);
+    }
+
+    node.valueSize = valueString.size();
+    node.value = offsets.value(valueString, strings.size());
+    if (node.value == static_cast<quint32>(strings.size()))
+    {
+        offsets.insert(valueString, node.value);
+        strings.append(valueString);
+    }
+
+    nodes.append(node);
+
+    for (boost::property_tree::wptree::const_iterator it = pt.begin(); it != pt.end(); ++it)
+        writeNode(it->first, it->second, nodes, strings, offsets);
+}
+
+void RundownCache::prune() const
+{
+    // Keep the most recently written files, the cache is only a shortcut and can always be rebuilt.
+    QDir directory(QFileInfo(this->path).absolutePath());
+    QFileInfoList files = directory.entryInfoList(QStringList() << "*.cache", QDir::Files, QDir::Time);
+    for (int i = Rundown::MAX_NUMBER_OF_CACHED_RUNDOWNS; i < files.count(); i++)
+        QFile::remove(files.at(i).absoluteFilePath());
+}
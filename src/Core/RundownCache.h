@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Shared.h"
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+class RundownReader;
+
+class CORE_EXPORT RundownCache
+{
+    public:
+        explicit RundownCache(const QString& hash);
+
+        bool read(RundownReader& reader) const;
+        bool write(const RundownReader& reader) const;
+
+    private:
+        struct RundownCacheHeader
+        {
+            char magic[4];
+            quint32 format;
+            char version[64];
+            char hash[32];
+            quint32 flags;
+            quint32 itemCount;
+            quint32 nodeCount;
+            quint32 stringSize;
+        };
+
+        struct RundownCacheNode
+        {
+            quint32 key;
+            quint32 keySize;
+            quint32 value;
+            quint32 valueSize;
+            quint32 childCount;
+        };
+
+        QString hash;
+        QString path;
+
+        void prune() const;
+        void writeNode(const std::wstring& key, const boost::property_tree::wptree& pt, QVector<RundownCacheNode>& nodes, QString& strings, QHash<QString, quint32>& offsets) const;
+        bool readNode(const RundownCacheNode* nodes, quint32 nodeCount, quint32& index, const char16_t* strings, quint32 stringSize, boost::property_tree::wptree& pt) const;
+};
@@ -0,0 +1,191 @@
+#include "RundownReadWorker.h"
+#include "RundownCache.h"
+#include "RundownReader.h"
+
+#include "Global.h"
+
+#include <utility>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMetaObject>
+#include <QtCore/QMutexLocker>
+
+RundownReadWorker::RundownReadWorker(QObject* parent)
+    : QObject(parent), mutex(), generation(0)
+{
+}
+
+void RundownReadWorker::read(const QByteArray& data, const QString& hash, bool useCache)
+{
+    QMutexLocker locker(&mutex);
+
+    // Only the latest rundown is kept, a read still running for an older one gives up.
+    this->pendingGeneration = this->generation.fetch_add(1, std::memory_order_relaxed) + 1;
+    this->pendingData = data;
+    this->pendingHash = hash;
+    this->pendingUseCache = useCache;
+
+    clearResult();
+
+    if (this->pending)
+        return;
+
+    this->pending = true;
+    QMetaObject::invokeMethod(this, "run", Qt::QueuedConnection);
+}
+
+void RundownReadWorker::cancel()
+{
+    QMutexLocker locker(&mutex);
+
+    this->generation.fetch_add(1, std::memory_order_relaxed);
+    this->pendingData.clear();
+
+    clearResult();
+}
+
+bool RundownReadWorker::takeItems(QList<boost::property_tree::wptree>& items, bool& hasAllowRemoteTriggering, bool& allowRemoteTriggering, bool& finished, bool& failed)
+{
+    QMutexLocker locker(&mutex);
+
+    if (!this->resultPending)
+        return false;
+
+    items.swap(this->resultItems);
+    hasAllowRemoteTriggering = this->resultHasAllowRemoteTriggering;
+    allowRemoteTriggering = this->resultAllowRemoteTriggering;
+    finished = this->resultFinished;
+    failed = this->resultFailed;
+
+    clearResult();
+
+    return true;
+}
+
+void RundownReadWorker::clearResult()
+{
+    this->resultPending = false;
+    this->resultItems.clear();
+    this->resultHasAllowRemoteTriggering = false;
+    this->resultAllowRemoteTriggering = false;
+    this->resultFinished = false;
+    this->resultFailed = false;
+}
+
+bool RundownReadWorker::isCancelled(quint64 generation) const
+{
+    return generation != this->generation.load(std::memory_order_relaxed);
+}
+
+bool RundownReadWorker::appendResult(quint64 generation, QList<boost::property_tree::wptree>& items, bool hasAllowRemoteTriggering, bool allowRemoteTriggering, bool finished, bool failed)
+{
+    bool notify;
+    {
+        QMutexLocker locker(&mutex);
+
+        if (isCancelled(generation))
+            return false;
+
+        // Batches the GUI thread has not taken yet are merged, it is only woken up once for them.
+        notify = !this->resultPending;
+
+        this->resultPending = true;
+        this->resultItems.append(std::move(items));
+        if (hasAllowRemoteTriggering)
+        {
+            this->resultHasAllowRemoteTriggering = true;
+            this->resultAllowRemoteTriggering = allowRemoteTriggering;
+        }
+        this->resultFinished = finished;
+        this->resultFailed = failed;
+    }
+
+    items.clear();
+
+    if (notify)
+        emit itemsRead();
+
+    return true;
+}
+
+void RundownReadWorker::run()
+{
+    QElapsedTimer time;
+    time.start();
+
+    quint64 generation;
+    QByteArray data;
+    QString hash;
+    bool useCache;
+    {
+        QMutexLocker locker(&mutex);
+
+        generation = this->pendingGeneration;
+        data.swap(this->pendingData);
+        hash = this->pendingHash;
+        useCache = this->pendingUseCache;
+
+        this->pending = false;
+    }
+
+    if (isCancelled(generation))
+        return; // Closed before the read started.
+
+    RundownReader reader;
+    RundownCache cache(hash);
+    if (useCache && cache.read(reader))
+    {
+        appendResult(generation, reader.getItems(), reader.hasAllowRemoteTriggering(), reader.getAllowRemoteTriggering(), true, false);
+
+        qDebug("RundownReadWorker::run %lld msec (cached)", time.elapsed());
+
+        return;
+    }
+
+    if (!reader.begin(data))
+    {
+        qCritical("Failed to read rundown: %s", qPrintable(reader.getErrorString()));
+        appendResult(generation, reader.getItems(), false, false, true, true);
+
+        return;
+    }
+
+    // The first batch only has to fill the view, it is handed over as soon as it is read. The rest
+    // follows in larger batches so the GUI thread is not woken up for every few items.
+    QList<boost::property_tree::wptree> items;
+    bool hasAllowRemoteTriggering = false;
+    int count = Rundown::FIRST_READ_BATCH_SIZE;
+    while (!reader.atEnd())
+    {
+        if (isCancelled(generation))
+            return;
+
+        if (!reader.readItems(count))
+        {
+            qCritical("Failed to read rundown: %s", qPrintable(reader.getErrorString()));
+            appendResult(generation, reader.getItems(), false, false, true, true);
+
+            return;
+        }
+
+        if (useCache)
+            items.append(reader.getItems());
+
+        // The remote triggering flag precedes the items, it is passed on with the first batch only.
+        bool allowRemoteTriggeringRead = (reader.hasAllowRemoteTriggering() && !hasAllowRemoteTriggering);
+        hasAllowRemoteTriggering = reader.hasAllowRemoteTriggering();
+
+        if (!appendResult(generation, reader.getItems(), allowRemoteTriggeringRead, reader.getAllowRemoteTriggering(), reader.atEnd(), false))
+            return;
+
+        count = Rundown::READ_BATCH_SIZE;
+    }
+
+    if (useCache)
+    {
+        reader.getItems().swap(items);
+        cache.write(reader);
+    }
+
+    qDebug("RundownReadWorker::run %lld msec", time.elapsed());
+}
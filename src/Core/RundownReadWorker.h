@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Shared.h"
+
+#include <atomic>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+class CORE_EXPORT RundownReadWorker : public QObject
+{
+    Q_OBJECT
+
+    public:
+        explicit RundownReadWorker(QObject* parent = 0);
+
+        void read(const QByteArray& data, const QString& hash, bool useCache);
+        void cancel();
+        bool takeItems(QList<boost::property_tree::wptree>& items, bool& hasAllowRemoteTriggering, bool& allowRemoteTriggering, bool& finished, bool& failed);
+
+        Q_SIGNAL void itemsRead();
+
+    private:
+        QMutex mutex;
+
+        std::atomic<quint64> generation;
+
+        bool pending = false;
+        quint64 pendingGeneration = 0;
+        QByteArray pendingData;
+        QString pendingHash;
+        bool pendingUseCache = false;
+
+        bool resultPending = false;
+        QList<boost::property_tree::wptree> resultItems;
+        bool resultHasAllowRemoteTriggering = false;
+        bool resultAllowRemoteTriggering = false;
+        bool resultFinished = false;
+        bool resultFailed = false;
+
+        void clearResult();
+        bool isCancelled(quint64 generation) const;
+        bool appendResult(quint64 generation, QList<boost::property_tree::wptree>& items, bool hasAllowRemoteTriggering, bool allowRemoteTriggering, bool finished, bool failed);
+
+        Q_SLOT void run();
+};
@@ -0,0 +1,138 @@
+#include "RundownReader.h"
+
+#include <limits>
+
+RundownReader::RundownReader()
+    : allowRemoteTriggeringSet(false), allowRemoteTriggering(false), finished(false)
+{
+}
+
+void RundownReader::clear()
+{
+    this->allowRemoteTriggeringSet = false;
+    this->allowRemoteTriggering = false;
+    this->finished = false;
+    this->errorString.clear();
+    this->items.clear();
+    this->xml.clear();
+}
+
+bool RundownReader::read(const QByteArray& data)
+{
+    return begin(data) && readItems(std::numeric_limits<int>::max());
+}
+
+bool RundownReader::begin(const QByteArray& data)
+{
+    clear();
+
+    this->xml.addData(data);
+    if (!this->xml.readNextStartElement() || this->xml.name() != QLatin1String("items"))
+    {
+        this->errorString = this->xml.hasError() ? this->xml.errorString() : QString("Missing items element");
+        return false;
+    }
+
+    return true;
+}
+
+bool RundownReader::readItems(int count)
+{
+    // One pass over the document, every item gets its own property tree so the widgets can keep reading them as before.
+    // Items read are appended, the caller can take them in between calls to hand them on in batches.
+    int read = 0;
+    while (read < count)
+    {
+        if (!this->xml.readNextStartElement())
+        {
+            this->finished = true;
+            break;
+        }
+
+        if (this->xml.name() == QLatin1String("item"))
+        {
+            this->items.append(boost::property_tree::wptree());
+            readElement(this->xml, this->items.last());
+
+            read++;
+        }
+        else if (this->xml.name() == QLatin1String("allowremotetriggering"))
+        {
+            this->allowRemoteTriggeringSet = true;
+            this->allowRemoteTriggering = (this->xml.readElementText().trimmed() == QLatin1String("true"));
+        }
+        else
+            this->xml.skipCurrentElement();
+    }
+
+    if (this->xml.hasError())
+    {
+        this->errorString = this->xml.errorString();
+        this->items.clear();
+
+        return false;
+    }
+
+    return true;
+}
+
+bool RundownReader::atEnd() const
+{
+    return this->finished;
+}
+
+void RundownReader::readElement(QXmlStreamReader& reader, boost::property_tree::wptree& pt)
+{
+    // Leaf elements hold their text, elements with children hold a subtree. This matches what read_xml produced.
+    QString text;
+    bool hasChildren = false;
+    while (!reader.atEnd())
+    {
+        QXmlStreamReader::TokenType token = reader.readNext();
+        if (token == QXmlStreamReader::StartElement)
+        {
+            hasChildren = true;
+
+            boost::property_tree::wptree& child = pt.push_back(std::make_pair(reader.name().toString().toStdWString(), boost::property_tree::wptree()))->second;
+            readElement(reader, child);
+        }
+        else if (token == QXmlStreamReader::Characters)
+            text.append(reader.text());
+        else if (token == QXmlStreamReader::EndElement)
+            break;
+    }
+
+    if (!hasChildren && !text.isEmpty())
+        pt.put_value(text.toStdWString());
+}
+
+bool RundownReader::hasAllowRemoteTriggering() const
+{
+    return this->allowRemoteTriggeringSet;
+}
+
+bool RundownReader::getAllowRemoteTriggering() const
+{
+    return this->allowRemoteTriggering;
+}
+
+const QString& RundownReader::getErrorString() const
+{
+    return this->errorString;
+}
+
+QList<boost::property_tree::wptree>& RundownReader::getItems()
+{
+    return this->items;
+}
+
+const QList<boost::property_tree::wptree>& RundownReader::getItems() const
+{
+    return this->items;
+}
+
+void RundownReader::setAllowRemoteTriggering(bool allowRemoteTriggering)
+{
+    this->allowRemoteTriggeringSet = true;
+    this->allowRemoteTriggering = allowRemoteTriggering;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Shared.h"
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QXmlStreamReader>
+
+class CORE_EXPORT RundownReader
+{
+    public:
+        explicit RundownReader();
+
+        bool read(const QByteArray& data);
+        bool begin(const QByteArray& data);
+        bool readItems(int count);
+        bool atEnd() const;
+        void clear();
+
+        bool hasAllowRemoteTriggering() const;
+        bool getAllowRemoteTriggering() const;
+        const QString& getErrorString() const;
+        QList<boost::property_tree::wptree>& getItems();
+        const QList<boost::property_tree::wptree>& getItems() const;
+
+        void setAllowRemoteTriggering(bool allowRemoteTriggering);
+
+    private:
+        bool allowRemoteTriggeringSet;
+        bool allowRemoteTriggering;
+        bool finished;
+        QString errorString;
+        QList<boost::property_tree::wptree> items;
+        QXmlStreamReader xml;
+
+        void readElement(QXmlStreamReader& reader, boost::property_tree::wptree& pt);
+};
@@ -0,0 +1 @@
+INSERT INTO Configuration (Name, Value) VALUES('BatchAmcpWrites', 'false');
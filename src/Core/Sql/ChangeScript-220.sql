@@ -0,0 +1,4 @@
+CREATE INDEX LibraryDeviceTypeName ON Library (DeviceId, TypeId, Name);
+CREATE INDEX LibraryThumbnail ON Library (ThumbnailId);
+CREATE INDEX DeviceAddress ON Device (Address);
+CREATE INDEX DeviceName ON Device (Name);
@@ -0,0 +1,4 @@
+CREATE TABLE ThumbnailBlob (Id INTEGER PRIMARY KEY, Data BLOB, Timestamp TEXT, Size TEXT);
+INSERT INTO ThumbnailBlob (Id, Data, Timestamp, Size) SELECT Id, Data, Timestamp, Size FROM Thumbnail;
+DROP TABLE Thumbnail;
+ALTER TABLE ThumbnailBlob RENAME TO Thumbnail;
@@ -9,7 +9,7 @@ CREATE TABLE GpoPort (Id INTEGER PRIMARY KEY, RisingEdge INTEGER, PulseLengthMil
 CREATE TABLE Library (Id INTEGER PRIMARY KEY, Name TEXT, DeviceId INTEGER, TypeId INTEGER, ThumbnailId INTEGER, Timecode TEXT);
 CREATE TABLE OpenRecent (Id INTEGER PRIMARY KEY, Value VARCHAR(255) UNIQUE);
 CREATE TABLE Preset (Id INTEGER PRIMARY KEY, Name TEXT, Value TEXT);
-CREATE TABLE Thumbnail (Id INTEGER PRIMARY KEY, Data TEXT, Timestamp TEXT, Size TEXT);
+CREATE TABLE Thumbnail (Id INTEGER PRIMARY KEY, Data BLOB, Timestamp TEXT, Size TEXT);
 CREATE TABLE Transition (Id INTEGER PRIMARY KEY, Value TEXT);
 CREATE TABLE Tween (Id INTEGER PRIMARY KEY, Value TEXT);
 CREATE TABLE Type (Id INTEGER PRIMARY KEY, Value TEXT);
@@ -33,6 +33,11 @@ CREATE TABLE TriCasterSource (Id INTEGER PRIMARY KEY, Name TEXT, Value TEXT, Pro
 CREATE TABLE TriCasterSwitcher (Id INTEGER PRIMARY KEY, Name TEXT, Value TEXT, Products TEXT);
 CREATE TABLE TriCasterNetworkTarget (Id INTEGER PRIMARY KEY, Name TEXT, Value TEXT, Products TEXT);
 
+CREATE INDEX LibraryDeviceTypeName ON Library (DeviceId, TypeId, Name);
+CREATE INDEX LibraryThumbnail ON Library (ThumbnailId);
+CREATE INDEX DeviceAddress ON Device (Address);
+CREATE INDEX DeviceName ON Device (Name);
+
 INSERT INTO BlendMode (Value) VALUES('Normal');
 INSERT INTO BlendMode (Value) VALUES('Lighten');
 INSERT INTO BlendMode (Value) VALUES('Darken');
@@ -100,6 +105,10 @@ INSERT INTO Configuration (Name, Value) VALUES('StreamPort', '9250');
 INSERT INTO Configuration (Name, Value) VALUES('LogLevel', '-1');
 INSERT INTO Configuration (Name, Value) VALUES('UseDropFrameNotation', 'false');
 INSERT INTO Configuration (Name, Value) VALUES('OpenRecent', '10');
+INSERT INTO Configuration (Name, Value) VALUES('UseQueryConnection', 'false');
+INSERT INTO Configuration (Name, Value) VALUES('BatchAmcpWrites', 'false');
+INSERT INTO Configuration (Name, Value) VALUES('ThumbnailRetrieveLimit', '4');
+INSERT INTO Configuration (Name, Value) VALUES('UseRundownCache', 'false');
 INSERT INTO Configuration (Name, Value) VALUES('DatabaseVersion', '216');
 
 INSERT INTO Chroma (Value) VALUES('None');
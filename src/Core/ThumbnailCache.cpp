@@ -0,0 +1,219 @@
+#include "ThumbnailCache.h"
+#include "DatabaseManager.h"
+#include "LibraryManager.h"
+
+#include "Global.h"
+
+#include <QtCore/QMetaObject>
+#include <QtCore/QMutexLocker>
+
+Q_GLOBAL_STATIC(ThumbnailCache, thumbnailCache)
+
+ThumbnailCache::ThumbnailCache(QObject* parent)
+    : QObject(parent),
+      entries(Thumbnail::CACHE_SIZE * 1024)
+{
+    this->pool.setMaxThreadCount(Thumbnail::DECODE_THREAD_COUNT);
+    this->pool.setExpiryTimeout(-1); // Each thread keeps its database connection.
+
+    this->empty.loaded = true;
+}
+
+ThumbnailCache& ThumbnailCache::getInstance()
+{
+    return *thumbnailCache();
+}
+
+QPixmap ThumbnailCache::getPixmap(const QString& name, const QString& deviceName, const QSize& size, qreal devicePixelRatio, bool alpha)
+{
+    ThumbnailCacheEntry* entry = getEntry(name, deviceName);
+    if (!entry->loaded && !entry->loading && DatabaseManager::getInstance().isInMemory())
+        entry = load(entry, name, deviceName); // A second connection to an in memory database would open an empty one.
+
+    if ((entry->loaded && entry->data.isEmpty()) || entry->failed)
+        return QPixmap();
+
+    QString variant = QString("%1x%2@%3%4").arg(size.width()).arg(size.height()).arg(devicePixelRatio).arg(alpha ? "a" : "");
+    if (entry->pixmaps.contains(variant))
+        return entry->pixmaps.value(variant);
+
+    // Read and decoded in the background, thumbnailChanged() is emitted once the pixmap is ready.
+    // Other variants asked for while the data is read are decoded when they are asked for again.
+    if (!entry->loading && !entry->decoding.contains(variant))
+    {
+        entry->loading = !entry->loaded;
+        entry->decoding.insert(variant);
+        decode(name, deviceName, *entry, variant, size, devicePixelRatio, alpha);
+    }
+
+    return QPixmap();
+}
+
+QString ThumbnailCache::getToolTip(const QString& name, const QString& deviceName)
+{
+    // A tooltip is shown for a single item, its data is read right away.
+    ThumbnailCacheEntry* entry = getEntry(name, deviceName);
+    if (!entry->loaded && !entry->loading)
+        entry = load(entry, name, deviceName);
+
+    if (entry->data.isEmpty())
+        return QString();
+
+    return QString("<img src=\"data:image/png;base64,%1 \"/>").arg(QString::fromLatin1(entry->data.toBase64()));
+}
+
+void ThumbnailCache::remove(const QString& name, const QString& deviceName)
+{
+    this->entries.remove(QString("%1/%2").arg(deviceName).arg(name));
+
+    emit thumbnailChanged(name, deviceName);
+}
+
+void ThumbnailCache::clear()
+{
+    this->entries.clear();
+}
+
+ThumbnailCache::ThumbnailCacheEntry* ThumbnailCache::getEntry(const QString& name, const QString& deviceName)
+{
+    QString key = QString("%1/%2").arg(deviceName).arg(name);
+
+    ThumbnailCacheEntry* entry = this->entries.object(key);
+    if (entry != nullptr)
+        return entry;
+
+    // The data is read along with the first decode, the entry is inserted again once it is known.
+    entry = new ThumbnailCacheEntry();
+    entry->serial = ++this->serial;
+
+    qsizetype cost = getCost(*entry);
+    if (!this->entries.insert(key, entry, cost))
+        return &this->empty;
+
+    return entry;
+}
+
+ThumbnailCache::ThumbnailCacheEntry* ThumbnailCache::load(ThumbnailCacheEntry* entry, const QString& name, const QString& deviceName)
+{
+    entry->loaded = true;
+    entry->data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(name, deviceName).getData();
+
+    // Missing thumbnails are cached as well, they are removed once the thumbnail is retrieved.
+    if (entry->data.isEmpty())
+        LibraryManager::getInstance().prioritizeThumbnail(name, deviceName);
+
+    // An entry larger than the whole cache is deleted right away by QCache.
+    QString key = QString("%1/%2").arg(deviceName).arg(name);
+    if (!this->entries.insert(key, this->entries.take(key), getCost(*entry)))
+        return &this->empty;
+
+    return entry;
+}
+
+qsizetype ThumbnailCache::getCost(const ThumbnailCacheEntry& entry) const
+{
+    qsizetype cost = entry.data.size();
+    foreach (const QPixmap& pixmap, entry.pixmaps)
+        cost += static_cast<qsizetype>(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+
+    return qMax<qsizetype>(cost, 1);
+}
+
+void ThumbnailCache::decode(const QString& name, const QString& deviceName, const ThumbnailCacheEntry& entry, const QString& variant,
+                            const QSize& size, qreal devicePixelRatio, bool alpha)
+{
+    ThumbnailCacheImage decodedImage;
+    decodedImage.name = name;
+    decodedImage.deviceName = deviceName;
+    decodedImage.serial = entry.serial;
+    decodedImage.variant = variant;
+    decodedImage.devicePixelRatio = devicePixelRatio;
+    decodedImage.readData = !entry.loaded;
+
+    QByteArray data = entry.data;
+    this->pool.start([this, decodedImage, data, size, alpha]() mutable
+    {
+        // The data is read here as well the first time, only pixmaps are created on the GUI thread.
+        if (decodedImage.readData)
+        {
+            data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(decodedImage.name, decodedImage.deviceName).getData();
+            decodedImage.data = data;
+        }
+
+        QImage image;
+        if (!data.isEmpty() && image.loadFromData(data, "PNG"))
+        {
+            image = image.scaled(size * decodedImage.devicePixelRatio, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+            if (alpha)
+                image = image.convertToFormat(QImage::Format_Alpha8);
+        }
+
+        decodedImage.image = image;
+
+        QMutexLocker locker(&this->mutex);
+
+        this->decodedImages.push_back(decodedImage);
+        if (this->decodedImages.count() == 1)
+            QMetaObject::invokeMethod(this, "applyDecoded", Qt::QueuedConnection);
+    });
+}
+
+void ThumbnailCache::applyDecoded()
+{
+    QList<ThumbnailCacheImage> decodedImages;
+    {
+        QMutexLocker locker(&this->mutex);
+        decodedImages.swap(this->decodedImages);
+    }
+
+    foreach (const ThumbnailCacheImage& decodedImage, decodedImages)
+    {
+        // The entry was evicted or replaced by a newer thumbnail while decoding.
+        QString key = QString("%1/%2").arg(decodedImage.deviceName).arg(decodedImage.name);
+        ThumbnailCacheEntry* entry = this->entries.take(key);
+        if (entry == nullptr)
+            continue;
+
+        bool current = (entry->serial == decodedImage.serial);
+        if (current && decodedImage.readData)
+        {
+            entry->loaded = true;
+            entry->loading = false;
+            entry->data = decodedImage.data;
+
+            if (entry->data.isEmpty())
+            {
+                // Missing thumbnails are cached as well, they are removed once the thumbnail is retrieved.
+                LibraryManager::getInstance().prioritizeThumbnail(decodedImage.name, decodedImage.deviceName);
+
+                entry->decoding.remove(decodedImage.variant);
+                current = false;
+            }
+        }
+
+        if (current && decodedImage.image.isNull())
+        {
+            // The data is not a valid image, it is not decoded again until the thumbnail is retrieved again.
+            qDebug("Failed to decode thumbnail %s on %s", qPrintable(decodedImage.name), qPrintable(decodedImage.deviceName));
+
+            entry->decoding.remove(decodedImage.variant);
+            entry->failed = true;
+            current = false;
+        }
+        else if (current)
+        {
+            QPixmap pixmap = QPixmap::fromImage(decodedImage.image);
+            pixmap.setDevicePixelRatio(decodedImage.devicePixelRatio);
+
+            entry->decoding.remove(decodedImage.variant);
+            entry->pixmaps.insert(decodedImage.variant, pixmap);
+        }
+
+        // The cost grows with each variant, the entry is inserted again to account for it.
+        qsizetype cost = getCost(*entry);
+        this->entries.insert(key, entry, cost);
+
+        if (current)
+            emit thumbnailChanged(decodedImage.name, decodedImage.deviceName);
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Shared.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QCache>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QSize>
+#include <QtCore/QString>
+#include <QtCore/QThreadPool>
+
+#include <QtGui/QImage>
+#include <QtGui/QPixmap>
+
+class CORE_EXPORT ThumbnailCache : public QObject
+{
+    Q_OBJECT
+
+    public:
+        explicit ThumbnailCache(QObject* parent = 0);
+
+        static ThumbnailCache& getInstance();
+
+        QPixmap getPixmap(const QString& name, const QString& deviceName, const QSize& size, qreal devicePixelRatio = 1.0, bool alpha = false);
+        QString getToolTip(const QString& name, const QString& deviceName);
+
+        void remove(const QString& name, const QString& deviceName);
+        void clear();
+
+        Q_SIGNAL void thumbnailChanged(const QString& name, const QString& deviceName);
+
+    private:
+        struct ThumbnailCacheEntry
+        {
+            quint64 serial = 0;
+            bool loaded = false;
+            bool loading = false;
+            bool failed = false;
+            QByteArray data;
+            QHash<QString, QPixmap> pixmaps;
+            QSet<QString> decoding;
+        };
+
+        struct ThumbnailCacheImage
+        {
+            QString name;
+            QString deviceName;
+            quint64 serial = 0;
+            QString variant;
+            qreal devicePixelRatio = 1.0;
+            bool readData = false;
+            QByteArray data;
+            QImage image;
+        };
+
+        quint64 serial = 0;
+
+        ThumbnailCacheEntry empty;
+        QCache<QString, ThumbnailCacheEntry> entries;
+
+        QMutex mutex;
+        QList<ThumbnailCacheImage> decodedImages;
+
+        QThreadPool pool;
+
+        ThumbnailCacheEntry* getEntry(const QString& name, const QString& deviceName);
+        ThumbnailCacheEntry* load(ThumbnailCacheEntry* entry, const QString& name, const QString& deviceName);
+        qsizetype getCost(const ThumbnailCacheEntry& entry) const;
+        void decode(const QString& name, const QString& deviceName, const ThumbnailCacheEntry& entry, const QString& variant,
+                    const QSize& size, qreal devicePixelRatio, bool alpha);
+
+        Q_SLOT void applyDecoded();
+};
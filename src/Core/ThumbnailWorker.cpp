@@ -2,69 +2,327 @@
 #include "DatabaseManager.h"
 #include "DeviceManager.h"
 #include "EventManager.h"
+#include "LibraryStore.h"
+#include "ThumbnailCache.h"
 #include "Events/MediaChangedEvent.h"
 #include "Events/StatusbarEvent.h"
 
 #include "Global.h"
 
-#include "CasparDevice.h"
+ThumbnailWorker::ThumbnailWorker(const QString& address, QObject* parent)
+    : QObject(parent),
+      address(address)
+{
+    this->retrieveLimit = qMax(1, DatabaseManager::getInstance().getConfigurationByName("ThumbnailRetrieveLimit").getValue().toInt());
 
-#include <QtCore/QTimer>
+    this->writeTimer.setSingleShot(true);
+    this->writeTimer.setInterval(Thumbnail::WRITE_DELAY);
+    this->timeoutTimer.setSingleShot(true);
+    this->timeoutTimer.setInterval(Thumbnail::RETRIEVE_TIMEOUT);
 
-#include <QtWidgets/QApplication>
+    QObject::connect(&this->writeTimer, SIGNAL(timeout()), this, SLOT(write()));
+    QObject::connect(&this->timeoutTimer, SIGNAL(timeout()), this, SLOT(timeout()));
+}
 
-ThumbnailWorker::ThumbnailWorker(const QList<ThumbnailModel>& thumbnailModels, QObject* parent)
-    : QObject(parent),
-      thumbnailModels(thumbnailModels)
+void ThumbnailWorker::enqueue(const QList<ThumbnailModel>& thumbnailModels)
 {
-    QObject::connect(&this->thumbnailTimer, SIGNAL(timeout()), this, SLOT(process()));
+    // Thumbnails still waiting from an earlier refresh keep their place in the queue.
+    foreach (const ThumbnailModel& model, thumbnailModels)
+    {
+        bool pending = this->pendingModels.contains(model.getName());
+        this->pendingModels.insert(model.getName(), model);
+
+        if (pending)
+            continue;
+
+        if (this->priorityNames.remove(model.getName()))
+            this->priorityQueue.push_back(model.getName());
+        else
+            this->queue.push_back(model.getName());
+    }
+
+    process();
 }
 
-void ThumbnailWorker::start()
+void ThumbnailWorker::prioritize(const QString& name)
 {
-    this->thumbnailTimer.setInterval(2000); // Settings?
-    this->thumbnailTimer.start();
+    // Thumbnails someone is waiting for go first, even when they are not listed by the server yet.
+    if (this->pendingModels.contains(name))
+        this->priorityQueue.push_back(name);
+    else
+        this->priorityNames.insert(name);
 }
 
-void ThumbnailWorker::process()
+bool ThumbnailWorker::takeNext(ThumbnailModel& model)
 {
-    if (this->thumbnailModels.count() == 0)
+    // Names taken through the priority queue are left behind in the regular queue, they are skipped here.
+    while (!this->priorityQueue.isEmpty())
     {
-        this->thumbnailTimer.stop();
-        EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
+        QString name = this->priorityQueue.takeFirst();
+        if (this->pendingModels.contains(name))
+        {
+            model = this->pendingModels.take(name);
+            return true;
+        }
+    }
 
-        return;
+    while (!this->queue.isEmpty())
+    {
+        QString name = this->queue.takeFirst();
+        if (this->pendingModels.contains(name))
+        {
+            model = this->pendingModels.take(name);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ThumbnailWorker::takeRequest(quint64 id, ThumbnailModel& model)
+{
+    // Pipelined requests are matched by their id, the others by their position among the unpipelined ones.
+    for (int i = 0; i < this->requests.count(); i++)
+    {
+        if (this->requests.at(i).id == id)
+        {
+            model = this->requests.takeAt(i).model;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ThumbnailWorker::drainReply()
+{
+    if (this->staleReplies == 0)
+        return false;
+
+    // A reply to a request that was given up on, nothing is sent until the last of them is in.
+    this->staleReplies--;
+    if (this->staleReplies == 0)
+    {
+        this->timeoutTimer.stop();
+        process();
+    }
+    else
+        this->timeoutTimer.start();
+
+    return true;
+}
+
+void ThumbnailWorker::requeue()
+{
+    this->timeoutTimer.stop();
+    this->staleReplies = 0;
+
+    // Requests lost with the connection are retried first, in their original order.
+    for (int i = this->requests.count() - 1; i >= 0; i--)
+    {
+        const ThumbnailModel& model = this->requests.at(i).model;
+        if (!this->pendingModels.contains(model.getName()))
+            this->pendingModels.insert(model.getName(), model);
+
+        this->priorityQueue.push_front(model.getName());
     }
 
-    this->currentName = this->thumbnailModels.at(0).getName();
-    this->currentAddress = this->thumbnailModels.at(0).getAddress();
-    this->currentTimestamp= this->thumbnailModels.at(0).getTimestamp();
-    this->currentSize= this->thumbnailModels.at(0).getSize();
+    this->requests.clear();
+}
+
+void ThumbnailWorker::setDevice(const QSharedPointer<CasparDevice>& device)
+{
+    if (this->device != NULL)
+    {
+        QObject::disconnect(this->device.data(), SIGNAL(connectionStateChanged(CasparDevice&)), this, SLOT(connectionStateChanged(CasparDevice&)));
+        QObject::disconnect(this->device.data(), SIGNAL(responseChanged(const QString&, CasparDevice&)), this, SLOT(responseChanged(const QString&, CasparDevice&)));
+        QObject::disconnect(this->device.data(), SIGNAL(thumbnailRetrieveChanged(const QString&, CasparDevice&)), this, SLOT(thumbnailRetrieveChanged(const QString&, CasparDevice&)));
+        QObject::disconnect(this->device.data(), SIGNAL(requestCompleted(quint64, const QList<QString>&, CasparDevice&)), this, SLOT(requestCompleted(quint64, const QList<QString>&, CasparDevice&)));
+    }
+
+    requeue();
+
+    this->device = device;
 
-    const QSharedPointer<DeviceModel> model = DeviceManager::getInstance().getDeviceModelByAddress(this->currentAddress);
+    QObject::connect(this->device.data(), SIGNAL(connectionStateChanged(CasparDevice&)), this, SLOT(connectionStateChanged(CasparDevice&)));
+    QObject::connect(this->device.data(), SIGNAL(responseChanged(const QString&, CasparDevice&)), this, SLOT(responseChanged(const QString&, CasparDevice&)));
+    QObject::connect(this->device.data(), SIGNAL(thumbnailRetrieveChanged(const QString&, CasparDevice&)), this, SLOT(thumbnailRetrieveChanged(const QString&, CasparDevice&)));
+    QObject::connect(this->device.data(), SIGNAL(requestCompleted(quint64, const QList<QString>&, CasparDevice&)), this, SLOT(requestCompleted(quint64, const QList<QString>&, CasparDevice&)));
+}
+
+void ThumbnailWorker::process()
+{
+    const QSharedPointer<DeviceModel> model = DeviceManager::getInstance().getDeviceModelByAddress(this->address);
     if (model == NULL || model->getShadow() == "Yes")
         return;
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(model->getName());
-    if (!device->isConnected())
+    // The device is looked up every time, a refresh of the device manager replaces it.
+    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getQueryDeviceByName(model->getName());
+    if (device == NULL)
+        return;
+
+    if (device != this->device)
+        setDevice(device);
+
+    if (!this->device->isConnected())
+        return;
+
+    // Keep a few requests in flight, the server answers them in order while the next ones are on their way.
+    ThumbnailModel thumbnailModel;
+    while (this->staleReplies == 0 && this->requests.count() < this->retrieveLimit && takeNext(thumbnailModel))
     {
-        this->thumbnailTimer.stop();
+        qDebug("Retrieving thumbnail %s", qPrintable(thumbnailModel.getName()));
+
+        ThumbnailRequest request;
+        request.id = this->device->retrieveThumbnail(thumbnailModel.getName());
+        request.model = thumbnailModel;
+        this->requests.push_back(request);
+
+        this->timeoutTimer.start();
+    }
+
+    if (!this->requests.isEmpty())
+        EventManager::getInstance().fireStatusbarEvent(StatusbarEvent(QString("Retrieving thumbnails, %1 remaining...").arg(this->pendingModels.count() + this->requests.count())));
+}
+
+void ThumbnailWorker::completeRequest()
+{
+    if (this->requests.isEmpty())
+        this->timeoutTimer.stop();
+    else
+        this->timeoutTimer.start();
+
+    process();
+
+    if (this->requests.isEmpty() && this->pendingModels.isEmpty())
+    {
+        write();
+
+        EventManager::getInstance().fireStatusbarEvent(StatusbarEvent(""));
         EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
+    }
+}
+
+void ThumbnailWorker::write()
+{
+    this->writeTimer.stop();
 
+    if (this->retrievedModels.isEmpty())
         return;
+
+    const QList<int> thumbnailIds = DatabaseManager::getInstance().updateThumbnails(this->retrievedModels);
+
+    const QSharedPointer<DeviceModel> model = DeviceManager::getInstance().getDeviceModelByAddress(this->address);
+    for (int i = 0; i < this->retrievedModels.count(); i++)
+    {
+        const ThumbnailModel& thumbnailModel = this->retrievedModels.at(i);
+
+        LibraryStore::getInstance().updateThumbnail(this->address, thumbnailModel.getName(), thumbnailIds.at(i));
+        if (model != NULL)
+            ThumbnailCache::getInstance().remove(thumbnailModel.getName(), model->getName());
     }
 
-    EventManager::getInstance().fireStatusbarEvent(StatusbarEvent(QString("Retrieving thumbnail %1...").arg(this->currentName)));
-    qDebug("Retrieving thumbnail %s", qPrintable(this->currentName));
+    this->retrievedModels.clear();
+}
+
+void ThumbnailWorker::timeout()
+{
+    qDebug("Timeout while retrieving %d thumbnails from %s", static_cast<int>(this->requests.count()), qPrintable(this->address));
+
+    // Replies to unpipelined requests can still arrive and would be taken for the requests sent next.
+    // They are drained first, unless nothing arrived while draining, then they are considered lost.
+    int staleReplies = 0;
+    foreach (const ThumbnailRequest& request, this->requests)
+    {
+        if (request.id == 0)
+            staleReplies++;
+    }
+
+    requeue();
 
-    QObject::connect(device.data(), SIGNAL(thumbnailRetrieveChanged(const QString&, CasparDevice&)), this, SLOT(thumbnailRetrieveChanged(const QString&, CasparDevice&)));
-    device->retrieveThumbnail(this->currentName);
+    this->staleReplies = staleReplies;
+    if (this->staleReplies > 0)
+        this->timeoutTimer.start();
+    else
+        process();
+}
 
-    this->thumbnailModels.removeAt(0);
+void ThumbnailWorker::connectionStateChanged(CasparDevice& device)
+{
+    // Nothing is lost on a reconnect, whatever was in flight is sent again once the device is back.
+    if (device.isConnected())
+        process();
+    else
+        requeue();
+}
+
+void ThumbnailWorker::responseChanged(const QString& response, CasparDevice& device)
+{
+    // Pipelined replies are matched by requestCompleted.
+    if (device.isPipelined())
+        return;
+
+    // Failed retrievals have no reply of their own, they are recognized by the error code.
+    if (!response.contains("THUMBNAIL RETRIEVE") || response.left(3).toInt() < 400)
+        return;
+
+    if (drainReply())
+        return;
+
+    ThumbnailModel model;
+    if (!takeRequest(0, model))
+        return;
+
+    qDebug("Failed to retrieve thumbnail %s: %s", qPrintable(model.getName()), qPrintable(response));
+
+    completeRequest();
 }
 
 void ThumbnailWorker::thumbnailRetrieveChanged(const QString& data, CasparDevice& device)
 {
-    QObject::disconnect(&device, SIGNAL(thumbnailRetrieveChanged(const QString&, CasparDevice&)), this, SLOT(thumbnailRetrieveChanged(const QString&, CasparDevice&)));
-    DatabaseManager::getInstance().updateThumbnail(ThumbnailModel(0, data, this->currentTimestamp, this->currentSize, this->currentName, this->currentAddress));
+    if (device.isPipelined())
+        return;
+
+    if (drainReply())
+        return;
+
+    ThumbnailModel model;
+    if (!takeRequest(0, model))
+        return;
+
+    retrieved(model, data);
+
+    completeRequest();
+}
+
+void ThumbnailWorker::requestCompleted(quint64 requestId, const QList<QString>& response, CasparDevice& device)
+{
+    Q_UNUSED(device);
+
+    // Replies to other commands, or to requests given up on after a timeout, have no request here.
+    ThumbnailModel model;
+    if (response.isEmpty() || !takeRequest(requestId, model))
+        return;
+
+    if (response.at(0).left(3).toInt() == 201 && response.count() > 1)
+        retrieved(model, response.at(1));
+    else
+        qDebug("Failed to retrieve thumbnail %s: %s", qPrintable(model.getName()), qPrintable(response.at(0)));
+
+    completeRequest();
+}
+
+void ThumbnailWorker::retrieved(const ThumbnailModel& model, const QString& data)
+{
+    // The server sends base64, it is decoded once and stored as binary.
+    QByteArray image = QByteArray::fromBase64(data.toLatin1());
+    if (!image.startsWith("\x89PNG"))
+        return;
+
+    this->retrievedModels.push_back(ThumbnailModel(0, image, model.getTimestamp(), model.getSize(), model.getName(), model.getAddress()));
+
+    if (this->retrievedModels.count() >= Thumbnail::WRITE_BATCH_SIZE)
+        write();
+    else if (!this->writeTimer.isActive())
+        this->writeTimer.start();
 }
@@ -2,15 +2,16 @@
 
 #include "Shared.h"
 
-#include "Models/CasparData.h"
 #include "CasparDevice.h"
-#include "Models/CasparMedia.h"
-#include "Models/CasparTemplate.h"
-#include "Models/CasparThumbnail.h"
 
 #include "Models/ThumbnailModel.h"
 
+#include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
 #include <QtCore/QTimer>
 
 class CORE_EXPORT ThumbnailWorker : public QObject
@@ -18,20 +19,48 @@ class CORE_EXPORT ThumbnailWorker : public QObject
     Q_OBJECT
 
     public:
-        explicit ThumbnailWorker(const QList<ThumbnailModel>& thumbnailModels, QObject* parent = 0);
+        explicit ThumbnailWorker(const QString& address, QObject* parent = 0);
 
-        void start();
+        void enqueue(const QList<ThumbnailModel>& thumbnailModels);
+        void prioritize(const QString& name);
 
     private:
-        QTimer thumbnailTimer;
+        struct ThumbnailRequest
+        {
+            quint64 id;
+            ThumbnailModel model;
+        };
 
-        QString currentName;
-        QString currentTimestamp;
-        QString currentSize;
-        QString currentAddress;
+        QString address;
+        int retrieveLimit;
+        int staleReplies = 0;
 
-        QList<ThumbnailModel> thumbnailModels;
+        QSharedPointer<CasparDevice> device;
+
+        QHash<QString, ThumbnailModel> pendingModels;
+        QList<QString> priorityQueue;
+        QList<QString> queue;
+        QSet<QString> priorityNames;
+
+        QList<ThumbnailRequest> requests;
+        QList<ThumbnailModel> retrievedModels;
+
+        QTimer writeTimer;
+        QTimer timeoutTimer;
+
+        bool takeNext(ThumbnailModel& model);
+        bool takeRequest(quint64 id, ThumbnailModel& model);
+        bool drainReply();
+        void requeue();
+        void setDevice(const QSharedPointer<CasparDevice>& device);
+        void retrieved(const ThumbnailModel& model, const QString& data);
+        void completeRequest();
 
         Q_SLOT void process();
+        Q_SLOT void write();
+        Q_SLOT void timeout();
+        Q_SLOT void connectionStateChanged(CasparDevice& device);
+        Q_SLOT void responseChanged(const QString& response, CasparDevice& device);
         Q_SLOT void thumbnailRetrieveChanged(const QString& data, CasparDevice& device);
+        Q_SLOT void requestCompleted(quint64 requestId, const QList<QString>& response, CasparDevice& device);
 };
@@ -7,6 +7,7 @@
 #include "../Core/EventManager.h"
 #include "../Core/GpiManager.h"
 #include "../Core/LibraryManager.h"
+#include "../Core/LibraryStore.h"
 #include "../Core/DeviceManager.h"
 #include "../Core/OscDeviceManager.h"
 #include "../Core/OscWebSocketManager.h"
@@ -34,6 +35,7 @@
 #include <QtWidgets/QStyleFactory>
 
 #include <QtSql/QSqlDatabase>
+#include <QtSql/QSqlQuery>
 
 struct CommandLineArgs
 {
@@ -129,7 +131,21 @@ void loadDatabase(CommandLineArgs* args)
     }
 
     if (!database.open())
+    {
         qCritical("Unable to open database");
+        return;
+    }
+
+    // Readers no longer block on the writer in WAL mode, a sync per checkpoint is enough for a cache of the servers.
+    QSqlQuery sql(database);
+    if (!args->dbmemory)
+    {
+        sql.exec("PRAGMA journal_mode = WAL");
+        sql.exec("PRAGMA synchronous = NORMAL");
+    }
+
+    sql.exec("PRAGMA temp_store = MEMORY");
+    sql.exec(QString("PRAGMA cache_size = -%1").arg(Database::PAGE_CACHE_SIZE));
 }
 
 void loadStyleSheets(QApplication& application)
@@ -289,6 +305,7 @@ int main(int argc, char* argv[])
 
     loadDatabase(&args);
     DatabaseManager::getInstance().initialize();
+    LibraryStore::getInstance().load();
 
     loadStyleSheets(application);
     loadFonts(application);
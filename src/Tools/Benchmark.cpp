@@ -0,0 +1,446 @@
+#include "Benchmark.h"
+#include "MockCasparServer.h"
+
+#include "Global.h"
+
+#include "AmcpLineParser.h"
+
+#include "DatabaseManager.h"
+#include "DeviceManager.h"
+#include "LibraryManager.h"
+#include "LibraryStore.h"
+#include "RundownReader.h"
+#include "Models/ConfigurationModel.h"
+#include "Models/DeviceModel.h"
+
+#include "OscMonitorListener.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QMetaObject>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
+#include <QtCore/QXmlStreamWriter>
+
+#include <QtSql/QSqlDatabase>
+
+#include <QtCore5Compat/QTextCodec>
+
+Benchmark::Benchmark(QObject* parent)
+    : QObject(parent)
+{
+}
+
+Benchmark::~Benchmark()
+{
+    this->serverThread.quit();
+    this->serverThread.wait();
+}
+
+bool Benchmark::start()
+{
+    // The server gets its own thread, the client side is measured on this one as the GUI thread would be.
+    this->server = new MockCasparServer();
+    this->server->moveToThread(&this->serverThread);
+
+    QObject::connect(&this->serverThread, SIGNAL(finished()), this->server, SLOT(deleteLater()));
+    QObject::connect(this->server, SIGNAL(commandReceived(const QString&, qint64)), this, SLOT(commandReceived(const QString&, qint64)));
+
+    this->serverThread.setObjectName("Mock server");
+    this->serverThread.start();
+
+    bool started = false;
+    QMetaObject::invokeMethod(this->server, "start", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, started), Q_ARG(int, 0));
+    if (!started)
+        return false;
+
+    this->port = this->server->serverPort();
+
+    return true;
+}
+
+bool Benchmark::wait(int timeout)
+{
+    if (this->done)
+        return true;
+
+    QTimer timer;
+    timer.setSingleShot(true);
+    QObject::connect(&timer, SIGNAL(timeout()), &this->loop, SLOT(quit()));
+    timer.start(timeout);
+
+    this->loop.exec();
+
+    return this->done;
+}
+
+void Benchmark::finish()
+{
+    this->done = true;
+    this->loop.quit();
+}
+
+void Benchmark::commandReceived(const QString& command, qint64 timestamp)
+{
+    if (this->expectedCommand.isEmpty() || !command.startsWith(this->expectedCommand))
+        return;
+
+    this->commandTimestamp = timestamp;
+    if (this->responseTimestamp != 0)
+        finish();
+}
+
+void Benchmark::responseChanged(const QString& response, CasparDevice& device)
+{
+    Q_UNUSED(response);
+    Q_UNUSED(device);
+
+    if (this->expectedCommand.isEmpty())
+        return;
+
+    this->responseTimestamp = MockCasparServer::timestamp();
+    if (this->commandTimestamp != 0)
+        finish();
+}
+
+void Benchmark::connectionStateChanged(CasparDevice& device)
+{
+    if (device.isConnected())
+        finish();
+}
+
+void Benchmark::mediaChanged(const QList<CasparMedia>& mediaItems, CasparDevice& device)
+{
+    Q_UNUSED(mediaItems);
+    Q_UNUSED(device);
+
+    // Connected after the library manager, so this runs once the library has been updated.
+    this->mediaTimestamp = MockCasparServer::timestamp();
+
+    finish();
+}
+
+void Benchmark::messageReceived(const QString& path, const QList<QVariant>& arguments)
+{
+    this->oscSignals++;
+
+    if (path.endsWith("/file/frame") && !arguments.isEmpty())
+        this->oscFrame = qMax(this->oscFrame, arguments.at(0).toLongLong());
+
+    if (this->oscExpectedFrame > 0 && this->oscFrame >= this->oscExpectedFrame)
+        finish();
+}
+
+void Benchmark::report(const QString& name, QList<qint64> samples, const QString& unit, double divisor)
+{
+    if (samples.isEmpty())
+    {
+        printf("%-48s no samples\n", qPrintable(name));
+        return;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    double total = 0;
+    foreach (qint64 sample, samples)
+        total += sample;
+
+    printf("%-48s n %6d  min %10.1f  median %10.1f  p99 %10.1f  max %10.1f  mean %10.1f %s\n", qPrintable(name), static_cast<int>(samples.count()),
+           samples.first() / divisor, samples.at(samples.count() / 2) / divisor, samples.at(qMin(samples.count() - 1, samples.count() * 99 / 100)) / divisor,
+           samples.last() / divisor, total / samples.count() / divisor, qPrintable(unit));
+}
+
+void Benchmark::runTriggerLatency(int iterations, bool batchWrites)
+{
+    CasparDevice device("127.0.0.1", this->port);
+    device.setBatchWrites(batchWrites);
+
+    QObject::connect(&device, SIGNAL(connectionStateChanged(CasparDevice&)), this, SLOT(connectionStateChanged(CasparDevice&)));
+    QObject::connect(&device, SIGNAL(responseChanged(const QString&, CasparDevice&)), this, SLOT(responseChanged(const QString&, CasparDevice&)));
+
+    this->done = false;
+    device.connectDevice();
+    if (!wait(5000))
+    {
+        qCritical("Failed to connect to the mock server on port %d", this->port);
+        return;
+    }
+
+    // Trigger to wire is the call until the server read the command, the round trip lasts until the reply was dispatched.
+    QList<qint64> wire;
+    QList<qint64> roundTrip;
+    for (int i = 0; i < iterations; i++)
+    {
+        this->expectedCommand = "PLAY 1-10";
+        this->commandTimestamp = 0;
+        this->responseTimestamp = 0;
+        this->done = false;
+
+        qint64 start = MockCasparServer::timestamp();
+        device.playMovie(1, 10, QString("MEDIA/CLIP%1").arg(i % 1000, 6, 10, QChar('0')), "MIX", 12, "Linear", "RIGHT", 0, 0, false, false);
+
+        if (!wait(5000))
+        {
+            qCritical("Timed out waiting for the mock server after %d commands", i);
+            break;
+        }
+
+        wire.append(this->commandTimestamp - start);
+        roundTrip.append(this->responseTimestamp - start);
+    }
+
+    this->expectedCommand.clear();
+
+    QString mode = batchWrites ? "batched" : "unbatched";
+    report(QString("Trigger to wire (%1)").arg(mode), wire);
+    report(QString("Trigger to reply (%1)").arg(mode), roundTrip);
+
+    device.disconnectDevice();
+}
+
+bool Benchmark::openDatabase()
+{
+    if (this->databaseOpen)
+        return true;
+
+    QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE");
+    database.setDatabaseName(":memory:");
+    if (!database.open())
+    {
+        qCritical("Unable to open database");
+        return false;
+    }
+
+    DatabaseManager::getInstance().initialize();
+    DatabaseManager::getInstance().updateConfiguration(ConfigurationModel(0, "UseQueryConnection", "false"));
+    DatabaseManager::getInstance().updateConfiguration(ConfigurationModel(0, "StoreThumbnailsInDatabase", "false"));
+    LibraryStore::getInstance().load();
+
+    this->databaseOpen = true;
+
+    return true;
+}
+
+void Benchmark::runLibraryRefresh(const QList<int>& counts)
+{
+    if (!openDatabase())
+        return;
+
+    // The library manager has to exist before the devices are added, it connects to them as they are.
+    this->server->setMediaCount(0);
+    DatabaseManager::getInstance().insertDevice(DeviceModel(0, "Benchmark", "127.0.0.1", this->port, "", "", "", "", "No", 0, "", 0, 0));
+    LibraryManager::getInstance();
+    DeviceManager::getInstance().initialize();
+
+    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName("Benchmark");
+    QObject::connect(device.data(), SIGNAL(mediaChanged(const QList<CasparMedia>&, CasparDevice&)), this, SLOT(mediaChanged(const QList<CasparMedia>&, CasparDevice&)));
+
+    // The library manager refreshes everything on connect, let that settle before anything is measured.
+    this->done = false;
+    if (!wait(5000))
+    {
+        qCritical("Failed to refresh the library from the mock server on port %d", this->port);
+        return;
+    }
+
+    this->done = false;
+    wait(500);
+
+    // Every size is refreshed twice, the first refresh changes the library and the second finds nothing to change.
+    foreach (int count, counts)
+    {
+        this->server->setMediaCount(count);
+
+        QStringList passes;
+        passes << "changed" << "unchanged";
+        foreach (const QString& pass, passes)
+        {
+            this->done = false;
+
+            qint64 start = MockCasparServer::timestamp();
+            device->refreshMedia();
+            if (!wait(60000))
+            {
+                qCritical("Timed out waiting for %d clips", count);
+                return;
+            }
+
+            report(QString("Library refresh %1 clips (%2)").arg(count).arg(pass), QList<qint64>() << this->mediaTimestamp - start, "msec", 1000000.0);
+        }
+    }
+
+    DeviceManager::getInstance().uninitialize();
+}
+
+void Benchmark::runOscDispatch(int port, int count, int layers)
+{
+    OscMonitorListener listener;
+    QObject::connect(&listener, SIGNAL(messageReceived(const QString&, const QList<QVariant>&)), this, SLOT(messageReceived(const QString&, const QList<QVariant>&)));
+    listener.start(port);
+
+    this->oscFrame = 0;
+    this->oscSignals = 0;
+    this->oscExpectedFrame = 0;
+    this->done = false;
+
+    qint64 start = MockCasparServer::timestamp();
+
+    qint64 lastFrame = 0;
+    QMetaObject::invokeMethod(this->server, "sendOsc", Qt::BlockingQueuedConnection, Q_RETURN_ARG(qint64, lastFrame),
+                              Q_ARG(QString, QString("127.0.0.1")), Q_ARG(int, port), Q_ARG(int, count), Q_ARG(int, layers));
+
+    qint64 sent = MockCasparServer::timestamp();
+
+    // Done once the frame number of the last bundle has been dispatched, this includes the batch interval of the listener.
+    this->oscExpectedFrame = lastFrame;
+    if (!wait(10000))
+        qCritical("Last OSC message not dispatched, %lld of %lld frames seen", this->oscFrame, lastFrame);
+
+    qint64 dispatched = MockCasparServer::timestamp();
+
+    this->oscExpectedFrame = 0;
+
+    printf("%-48s %d messages sent in %.1f msec, dispatched after %.1f msec (%.0f messages/sec), %lld signals emitted\n",
+           "OSC dispatch", count, (sent - start) / 1000000.0, (dispatched - start) / 1000000.0,
+           count / ((dispatched - start) / 1000000000.0), this->oscSignals);
+}
+
+void Benchmark::runRundownLoad(int count, int iterations)
+{
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
+    writer.writeStartDocument();
+    writer.writeStartElement("items");
+    writer.writeTextElement("allowremotetriggering", "false");
+    for (int i = 0; i < count; i++)
+    {
+        writer.writeStartElement("item");
+        writer.writeTextElement("type", "MOVIE");
+        writer.writeTextElement("devicename", "Benchmark");
+        writer.writeTextElement("label", QString("CLIP%1").arg(i, 6, 10, QChar('0')));
+        writer.writeTextElement("name", QString("MEDIA/CLIP%1").arg(i, 6, 10, QChar('0')));
+        writer.writeTextElement("channel", "1");
+        writer.writeTextElement("videolayer", "10");
+        writer.writeTextElement("delay", "0");
+        writer.writeTextElement("duration", "0");
+        writer.writeTextElement("allowgpi", "false");
+        writer.writeTextElement("allowremotetriggering", "false");
+        writer.writeTextElement("remotetriggerid", "");
+        writer.writeTextElement("storyid", "");
+        writer.writeTextElement("transition", "MIX");
+        writer.writeTextElement("transitionDuration", "12");
+        writer.writeTextElement("tween", "Linear");
+        writer.writeTextElement("direction", "RIGHT");
+        writer.writeTextElement("seek", "0");
+        writer.writeTextElement("length", "0");
+        writer.writeTextElement("loop", "false");
+        writer.writeTextElement("freezeonload", "false");
+        writer.writeTextElement("triggeronnext", "false");
+        writer.writeTextElement("autoplay", "false");
+        writer.writeTextElement("color", "Transparent");
+        writer.writeEndElement();
+    }
+    writer.writeEndElement();
+    writer.writeEndDocument();
+
+    // The first batch is what the user waits for, the full read is what the worker thread spends on the rest.
+    QList<qint64> firstBatch;
+    QList<qint64> full;
+    for (int i = 0; i < iterations; i++)
+    {
+        RundownReader reader;
+
+        qint64 start = MockCasparServer::timestamp();
+        if (!reader.begin(data) || !reader.readItems(Rundown::FIRST_READ_BATCH_SIZE))
+        {
+            qCritical("Failed to read rundown: %s", qPrintable(reader.getErrorString()));
+            return;
+        }
+
+        firstBatch.append(MockCasparServer::timestamp() - start);
+
+        start = MockCasparServer::timestamp();
+        if (!reader.read(data))
+        {
+            qCritical("Failed to read rundown: %s", qPrintable(reader.getErrorString()));
+            return;
+        }
+
+        full.append(MockCasparServer::timestamp() - start);
+    }
+
+    report(QString("Rundown first batch (%1 items, %2 KB)").arg(count).arg(data.size() / 1024), firstBatch);
+    report(QString("Rundown load (%1 items, %2 KB)").arg(count).arg(data.size() / 1024), full, "msec", 1000000.0);
+}
+
+static void parseLegacy(const QByteArray& reply, int chunkSize, QList<QString>& lines)
+{
+    // As AmcpDevice::readMessage did before the line parser, every read is decoded and the string searched from the start.
+    QTextDecoder decoder(QTextCodec::codecForName("UTF-8"));
+    QString fragments;
+    for (qsizetype offset = 0; offset < reply.size(); offset += chunkSize)
+    {
+        fragments += decoder.toUnicode(reply.mid(offset, chunkSize));
+
+        int position;
+        while ((position = fragments.indexOf("\r\n")) != -1)
+        {
+            QString line = fragments.left(position);
+            fragments.remove(0, position + 2);
+
+            lines.append(line);
+        }
+    }
+}
+
+static void parseLines(const QByteArray& reply, int chunkSize, QList<QString>& lines)
+{
+    AmcpLineParser parser;
+    for (qsizetype offset = 0; offset < reply.size(); offset += chunkSize)
+    {
+        parser.append(reply.mid(offset, chunkSize));
+        parser.parse(lines);
+    }
+}
+
+void Benchmark::runLineParser(int clips, int thumbnailSize, int chunkSize, int iterations)
+{
+    // Replies as the mock server sends them, fed in socket sized chunks through the old and the current line parser.
+    MockCasparServer recorder;
+    recorder.setMediaCount(clips);
+    recorder.setThumbnailSize(thumbnailSize);
+
+    QStringList names;
+    QList<QByteArray> replies;
+    names << QString("CLS %1 clips").arg(clips) << QString("THUMBNAIL RETRIEVE %1 KB").arg(thumbnailSize / 1024);
+    replies << recorder.reply("CLS") << recorder.reply("THUMBNAIL RETRIEVE MEDIA/CLIP000000");
+
+    for (int r = 0; r < replies.count(); r++)
+    {
+        QList<qint64> legacy;
+        QList<qint64> current;
+        for (int i = 0; i < iterations; i++)
+        {
+            QList<QString> legacyLines;
+            qint64 start = MockCasparServer::timestamp();
+            parseLegacy(replies.at(r), chunkSize, legacyLines);
+            legacy.append(MockCasparServer::timestamp() - start);
+
+            QList<QString> lines;
+            start = MockCasparServer::timestamp();
+            parseLines(replies.at(r), chunkSize, lines);
+            current.append(MockCasparServer::timestamp() - start);
+
+            if (lines != legacyLines)
+            {
+                qCritical("Line parser differs from the legacy parser for %s", qPrintable(names.at(r)));
+                return;
+            }
+        }
+
+        report(QString("Legacy parser %1").arg(names.at(r)), legacy, "msec", 1000000.0);
+        report(QString("Line parser %1").arg(names.at(r)), current, "msec", 1000000.0);
+    }
+}
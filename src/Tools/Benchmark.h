@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CasparDevice.h"
+#include "Models/CasparMedia.h"
+
+#include <QtCore/QEventLoop>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QThread>
+#include <QtCore/QVariant>
+
+class MockCasparServer;
+
+class Benchmark : public QObject
+{
+    Q_OBJECT
+
+    public:
+        explicit Benchmark(QObject* parent = 0);
+        ~Benchmark();
+
+        bool start();
+
+        void runTriggerLatency(int iterations, bool batchWrites);
+        void runLibraryRefresh(const QList<int>& counts);
+        void runOscDispatch(int port, int count, int layers);
+        void runRundownLoad(int count, int iterations);
+        void runLineParser(int clips, int thumbnailSize, int chunkSize, int iterations);
+        void runCommandBuilder(int iterations);
+        void runLibraryQueries(int rows, int iterations);
+
+        static void report(const QString& name, QList<qint64> samples, const QString& unit = "usec", double divisor = 1000.0);
+
+    private:
+        QThread serverThread;
+        MockCasparServer* server = nullptr;
+        int port = 0;
+
+        bool databaseOpen = false;
+
+        QEventLoop loop;
+        bool done = false;
+
+        QString expectedCommand;
+        qint64 commandTimestamp = 0;
+        qint64 responseTimestamp = 0;
+        qint64 mediaTimestamp = 0;
+        qint64 oscFrame = 0;
+        qint64 oscSignals = 0;
+        qint64 oscExpectedFrame = 0;
+
+        bool openDatabase();
+        bool wait(int timeout);
+        void finish();
+
+        Q_SLOT void commandReceived(const QString&, qint64);
+        Q_SLOT void responseChanged(const QString&, CasparDevice&);
+        Q_SLOT void connectionStateChanged(CasparDevice&);
+        Q_SLOT void mediaChanged(const QList<CasparMedia>&, CasparDevice&);
+        Q_SLOT void messageReceived(const QString&, const QList<QVariant>&);
+};
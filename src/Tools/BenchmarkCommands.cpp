@@ -0,0 +1,130 @@
+#include "Benchmark.h"
+#include "LegacyCommandBuilder.h"
+#include "MockCasparServer.h"
+
+#include <cstdio>
+
+template <typename T>
+static void sendCommandSet(T& target, int i)
+{
+    // Every command builder once, with the arguments a rundown would typically pass.
+    QString name = QString("MEDIA/CLIP%1").arg(i % 1000, 6, 10, QChar('0'));
+    QString data = "<templateData><componentData id=\"f0\"><data id=\"text\" value=\"Lower third\"/></componentData></templateData>";
+
+    target.refreshData();
+    target.refreshMedia();
+    target.refreshTemplate();
+    target.refreshChannels();
+    target.refreshThumbnail();
+    target.refreshFlashVersion();
+    target.refreshServerVersion();
+    target.refreshTemplateHostVersion();
+    target.retrieveThumbnail(name);
+    target.sendCommand("PLAY 1-10 AMB");
+    target.clearChannel(1);
+    target.clearMixerChannel(1);
+    target.clearVideolayer(1, 10);
+    target.clearMixerVideolayer(1, 10);
+    target.pause(1, 10);
+    target.resume(1, 10);
+    target.stop(1, 10);
+    target.play(1, 10);
+    target.print(1, "Screenshot");
+    target.loadRouteChannel(1, 10, 2);
+    target.loadRouteChannel(1, 10, 2, 3);
+    target.playRouteChannel(1, 10, 2);
+    target.playRouteChannel(1, 10, 2, 3);
+    target.loadRouteVideolayer(1, 10, 2, 20);
+    target.loadRouteVideolayer(1, 10, 2, 20, 3);
+    target.playRouteVideolayer(1, 10, 2, 20);
+    target.playRouteVideolayer(1, 10, 2, 20, 3);
+    target.addTemplate(1, 20, 1, "TEMPLATES/LOWERTHIRD", false);
+    target.addTemplate(1, 20, 1, "TEMPLATES/LOWERTHIRD", true, data);
+    target.invokeTemplate(1, 20, 1, "leftTab()");
+    target.nextTemplate(1, 20, 1);
+    target.playTemplate(1, 20, 1);
+    target.playTemplate(1, 20, 1, "TEMPLATES/LOWERTHIRD");
+    target.playTemplate(1, 20, 1, "TEMPLATES/LOWERTHIRD", data);
+    target.removeTemplate(1, 20, 1);
+    target.stopTemplate(1, 20, 1);
+    target.updateTemplate(1, 20, 1, data);
+    target.playHtml(1, 10, "http://localhost/overlay.html", "MIX", 12, "Linear", "RIGHT", false);
+    target.loadHtml(1, 10, "http://localhost/overlay.html", "MIX", 12, "Linear", "RIGHT", false, true);
+    target.playMovie(1, 10, name, "MIX", 12, "Linear", "RIGHT", 0, 0, false, false);
+    target.playMovie(1, 10, name, "MIX", 12, "Linear", "RIGHT", 25, 250, true, true);
+    target.loadMovie(1, 10, name, "MIX", 12, "Linear", "RIGHT", 25, 250, true, false, false);
+    target.playAudio(1, 10, name, "MIX", 12, "Linear", "RIGHT", false, false);
+    target.loadAudio(1, 10, name, "MIX", 12, "Linear", "RIGHT", true, true);
+    target.playColor(1, 10, "#FF000000", "MIX", 12, "Linear", "RIGHT", false);
+    target.loadColor(1, 10, "#FF000000", "MIX", 12, "Linear", "RIGHT", true);
+    target.playStill(1, 10, name, "MIX", 12, "Linear", "RIGHT", false);
+    target.loadStill(1, 10, name, "MIX", 12, "Linear", "RIGHT", true);
+    target.startFileRecorder(1, "recording.mov", "-codec:v prores", true);
+    target.stopFileRecorder(1, "recording.mov");
+    target.startStream(1, 9250, 23, true, 1280, 720);
+    target.stopStream(1, 9250);
+    target.playDeviceInput(1, 10, 1, "1080i5000");
+    target.loadDeviceInput(1, 10, 1, "1080i5000");
+    target.playImageScroll(1, 10, name, 0, 5, false, true);
+    target.loadImageScroll(1, 10, name, 0, 5, false, true);
+    target.setCommit(1);
+    target.setReset(1, 10);
+    target.setChroma(1, 10, "Green", 0.34f, 0.44f, 0.2f);
+    target.setBlendMode(1, 10, "Normal");
+    target.setGrid(1, 2, 12, "Linear", true);
+    target.setKeyer(1, 10, 1, false);
+    target.setVolume(1, 10, 0.8f, true);
+    target.setVolume(1, 10, 0.8f, 12, "Linear", true);
+    target.setOpacity(1, 10, 0.5f, false);
+    target.setOpacity(1, 10, 0.5f, 12, "Linear", false);
+    target.setBrightness(1, 10, 1.2f, false);
+    target.setBrightness(1, 10, 1.2f, 12, "Linear", false);
+    target.setContrast(1, 10, 1.1f, false);
+    target.setContrast(1, 10, 1.1f, 12, "Linear", false);
+    target.setSaturation(1, 10, 0.9f, false);
+    target.setSaturation(1, 10, 0.9f, 12, "Linear", false);
+    target.setLevels(1, 10, 0.0f, 1.0f, 1.2f, 0.0f, 1.0f, false);
+    target.setLevels(1, 10, 0.0f, 1.0f, 1.2f, 0.0f, 1.0f, 12, "Linear", false);
+    target.setFill(1, 10, 0.25f, 0.25f, 0.5f, 0.5f, false, true);
+    target.setFill(1, 10, 0.25f, 0.25f, 0.5f, 0.5f, 12, "EaseInOutSine", true, true);
+    target.setClipping(1, 10, 0.25f, 0.25f, 0.5f, 0.5f, false);
+    target.setClipping(1, 10, 0.25f, 0.25f, 0.5f, 0.5f, 12, "Linear", false);
+    target.setPerspective(1, 10, 0.1f, 0.1f, 0.9f, 0.1f, 0.9f, 0.9f, 0.1f, 0.9f, false, true);
+    target.setPerspective(1, 10, 0.1f, 0.1f, 0.9f, 0.1f, 0.9f, 0.9f, 0.1f, 0.9f, 12, "Linear", false, true);
+    target.setRotation(1, 10, 45.0f, false);
+    target.setRotation(1, 10, 45.0f, 12, "Linear", false);
+    target.setAnchor(1, 10, 0.5f, 0.5f, false);
+    target.setAnchor(1, 10, 0.5f, 0.5f, 12, "Linear", false);
+    target.setCrop(1, 10, 0.1f, 0.1f, 0.9f, 0.9f, false);
+    target.setCrop(1, 10, 0.1f, 0.1f, 0.9f, 0.9f, 12, "Linear", false);
+    target.setMasterVolume(1, 0.8f);
+}
+
+void Benchmark::runCommandBuilder(int iterations)
+{
+    // The device is never connected, writeMessage returns as soon as the command is built so only the builder is measured.
+    // The legacy builder also converts to the wire format, as that used to happen on every write.
+    CasparDevice device("127.0.0.1", this->port);
+    LegacyCommandBuilder legacy;
+
+    // Warm up both, the first calls pay for allocations that are reused later on.
+    sendCommandSet(legacy, 0);
+    sendCommandSet(device, 0);
+
+    QList<qint64> legacySamples;
+    QList<qint64> currentSamples;
+    for (int i = 0; i < iterations; i++)
+    {
+        qint64 start = MockCasparServer::timestamp();
+        sendCommandSet(legacy, i);
+        legacySamples.append(MockCasparServer::timestamp() - start);
+
+        start = MockCasparServer::timestamp();
+        sendCommandSet(device, i);
+        currentSamples.append(MockCasparServer::timestamp() - start);
+    }
+
+    report("Legacy builder, full command set", legacySamples);
+    report("Command builder, full command set", currentSamples);
+    printf("%-48s %.1f bytes per set\n", "Legacy builder output", static_cast<double>(legacy.getBytesWritten()) / (iterations + 1));
+}
@@ -0,0 +1,81 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+
+#include <QtCore/QCommandLineOption>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QStringList>
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setApplicationName("casparcg-benchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures the client against a mock CasparCG server running in process.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("cases", "Cases to run: latency, library, osc, rundown, parser, commands, queries. All when omitted.", "[cases...]");
+
+    QCommandLineOption iterationsOption("iterations", "Number of commands sent for the latency case, command sets built are ten times that.", "count", "1000");
+    QCommandLineOption clipsOption("clips", "Comma separated library sizes for the library case.", "counts", "1000,10000,20000");
+    QCommandLineOption oscMessagesOption("osc-messages", "Number of OSC messages sent for the OSC case.", "count", "100000");
+    QCommandLineOption oscLayersOption("osc-layers", "Number of layers the OSC messages are spread over.", "count", "10");
+    QCommandLineOption oscPortOption("osc-port", "UDP port the OSC monitor listens on.", "port", "6250");
+    QCommandLineOption itemsOption("items", "Number of items in the generated rundown.", "count", "5000");
+    QCommandLineOption thumbnailSizeOption("thumbnail-size", "Size in bytes of the thumbnail fed through the parsers.", "bytes", "4194304");
+    QCommandLineOption chunkSizeOption("chunk-size", "Size in bytes of the socket reads the parsers are fed with.", "bytes", "65536");
+    QCommandLineOption rowsOption("rows", "Number of library rows for the queries case.", "count", "50000");
+    QCommandLineOption verboseOption("verbose", "Show the debug output of the client.");
+    parser.addOptions({ iterationsOption, clipsOption, oscMessagesOption, oscLayersOption, oscPortOption, itemsOption,
+                        thumbnailSizeOption, chunkSizeOption, rowsOption, verboseOption });
+
+    parser.process(application);
+
+    // The client logs every command it sends, that would be measured along with it.
+    if (!parser.isSet(verboseOption))
+        QLoggingCategory::setFilterRules("default.debug=false");
+
+    QStringList cases = parser.positionalArguments();
+    if (cases.isEmpty())
+        cases << "latency" << "library" << "osc" << "rundown" << "parser" << "commands" << "queries";
+
+    Benchmark benchmark;
+    if (!benchmark.start())
+        return 1;
+
+    if (cases.contains("latency"))
+    {
+        benchmark.runTriggerLatency(parser.value(iterationsOption).toInt(), false);
+        benchmark.runTriggerLatency(parser.value(iterationsOption).toInt(), true);
+    }
+
+    if (cases.contains("library"))
+    {
+        QList<int> counts;
+        foreach (const QString& count, parser.value(clipsOption).split(",", Qt::SkipEmptyParts))
+            counts.append(count.toInt());
+
+        benchmark.runLibraryRefresh(counts);
+    }
+
+    if (cases.contains("osc"))
+        benchmark.runOscDispatch(parser.value(oscPortOption).toInt(), parser.value(oscMessagesOption).toInt(), parser.value(oscLayersOption).toInt());
+
+    if (cases.contains("rundown"))
+        benchmark.runRundownLoad(parser.value(itemsOption).toInt(), 10);
+
+    if (cases.contains("parser"))
+        benchmark.runLineParser(20000, parser.value(thumbnailSizeOption).toInt(), parser.value(chunkSizeOption).toInt(), 10);
+
+    if (cases.contains("commands"))
+        benchmark.runCommandBuilder(parser.value(iterationsOption).toInt() * 10);
+
+    if (cases.contains("queries"))
+        benchmark.runLibraryQueries(parser.value(rowsOption).toInt(), 10);
+
+    fflush(stdout);
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "Benchmark.h"
+
+#include "DatabaseManager.h"
+#include "LibraryChangeSet.h"
+#include "Models/DeviceModel.h"
+#include "Models/LibraryModel.h"
+#include "Models/ThumbnailModel.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QStringList>
+
+#include <QtSql/QSqlError>
+#include <QtSql/QSqlQuery>
+
+static const int QUERY_DEVICE_COUNT = 4;
+static const int QUERY_LOOKUP_COUNT = 100;
+
+static void executeStatements(const QStringList& statements)
+{
+    foreach (const QString& statement, statements)
+    {
+        QSqlQuery sql;
+        if (!sql.exec(statement))
+            qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(statement), qPrintable(sql.lastError().text()));
+    }
+}
+
+static QString clipName(int i)
+{
+    return QString("MEDIA/CLIP%1").arg(i, 6, 10, QChar('0'));
+}
+
+void Benchmark::runLibraryQueries(int rows, int iterations)
+{
+    if (!openDatabase())
+        return;
+
+    // The library is spread over a few servers like a real installation, every clip has a thumbnail.
+    QList<QList<LibraryModel>> deviceModels;
+    for (int device = 0; device < QUERY_DEVICE_COUNT; device++)
+    {
+        DatabaseManager::getInstance().insertDevice(DeviceModel(0, QString("Query%1").arg(device), QString("192.0.2.%1").arg(device + 10), 5250, "", "", "", "", "No", 0, "", 0, 0));
+        deviceModels.append(QList<LibraryModel>());
+    }
+
+    for (int i = 0; i < rows; i++)
+        deviceModels[i % QUERY_DEVICE_COUNT].append(LibraryModel(0, clipName(i), clipName(i), "", "MOVIE", 0, "00:00:25:18"));
+
+    QByteArray data(2048, 'x');
+    for (int device = 0; device < QUERY_DEVICE_COUNT; device++)
+    {
+        QString address = QString("192.0.2.%1").arg(device + 10);
+
+        LibraryChangeSet changeSet(QList<LibraryModel>(), deviceModels.at(device));
+        DatabaseManager::getInstance().updateLibraryMedia(address, changeSet);
+
+        QList<ThumbnailModel> thumbnails;
+        foreach (const LibraryModel& model, deviceModels.at(device))
+            thumbnails.append(ThumbnailModel(0, data, "20121101T160514", "2048", model.getName(), address));
+
+        DatabaseManager::getInstance().updateThumbnails(thumbnails);
+    }
+
+    const QString address = "192.0.2.11";
+    const QString deviceName = "Query1";
+    const int deviceId = DatabaseManager::getInstance().getDeviceByAddress(address).getId();
+
+    QStringList names;
+    for (int i = 0; i < QUERY_LOOKUP_COUNT; i++)
+        names.append(clipName(((i * 7919) % (rows / QUERY_DEVICE_COUNT)) * QUERY_DEVICE_COUNT + 1));
+
+    // The indexes of change script 220, dropped for the second pass to compare against the tree without them.
+    QStringList dropIndexes;
+    dropIndexes << "DROP INDEX LibraryDeviceTypeName" << "DROP INDEX LibraryThumbnail" << "DROP INDEX DeviceAddress" << "DROP INDEX DeviceName";
+
+    QStringList createIndexes;
+    createIndexes << "CREATE INDEX LibraryDeviceTypeName ON Library (DeviceId, TypeId, Name)" << "CREATE INDEX LibraryThumbnail ON Library (ThumbnailId)"
+                  << "CREATE INDEX DeviceAddress ON Device (Address)" << "CREATE INDEX DeviceName ON Device (Name)";
+
+    QStringList passes;
+    passes << "indexed" << "not indexed";
+    foreach (const QString& pass, passes)
+    {
+        if (pass == "not indexed")
+            executeStatements(dropIndexes);
+
+        QList<qint64> mediaByAddress, thumbnailsByAddress, libraryByName, thumbnailByName, media;
+        QElapsedTimer timer;
+        for (int i = 0; i < iterations; i++)
+        {
+            timer.start();
+            DatabaseManager::getInstance().getLibraryMediaByDeviceAddress(address);
+            mediaByAddress.append(timer.nsecsElapsed());
+
+            timer.start();
+            DatabaseManager::getInstance().getThumbnailByDeviceAddress(address);
+            thumbnailsByAddress.append(timer.nsecsElapsed());
+
+            timer.start();
+            foreach (const QString& name, names)
+                DatabaseManager::getInstance().getLibraryByNameAndDeviceId(name, deviceId);
+            libraryByName.append(timer.nsecsElapsed());
+
+            timer.start();
+            foreach (const QString& name, names)
+                DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(name, deviceName);
+            thumbnailByName.append(timer.nsecsElapsed());
+
+            timer.start();
+            DatabaseManager::getInstance().getLibraryMedia();
+            media.append(timer.nsecsElapsed());
+        }
+
+        report(QString("Library %1 rows, media by device address (%2)").arg(rows).arg(pass), mediaByAddress, "msec", 1000000.0);
+        report(QString("Library %1 rows, thumbnails by device address (%2)").arg(rows).arg(pass), thumbnailsByAddress, "msec", 1000000.0);
+        report(QString("Library %1 rows, %2 x library by name and device (%3)").arg(rows).arg(QUERY_LOOKUP_COUNT).arg(pass), libraryByName, "msec", 1000000.0);
+        report(QString("Library %1 rows, %2 x thumbnail by name and device name (%3)").arg(rows).arg(QUERY_LOOKUP_COUNT).arg(pass), thumbnailByName, "msec", 1000000.0);
+        report(QString("Library %1 rows, all media (%2)").arg(rows).arg(pass), media, "msec", 1000000.0);
+    }
+
+    executeStatements(createIndexes);
+}
@@ -0,0 +1,630 @@
+#include "LegacyCommandBuilder.h"
+
+#include <QtCore/QByteArray>
+
+LegacyCommandBuilder::LegacyCommandBuilder()
+{
+}
+
+qint64 LegacyCommandBuilder::getBytesWritten() const
+{
+    return this->bytesWritten;
+}
+
+void LegacyCommandBuilder::writeMessage(const QString& message)
+{
+    this->bytesWritten += QString("%1\r\n").arg(message.trimmed()).toUtf8().size();
+}
+
+void LegacyCommandBuilder::refreshData()
+{
+    writeMessage("DATA LIST");
+}
+
+void LegacyCommandBuilder::refreshFlashVersion()
+{
+    writeMessage("VERSION FLASH");
+}
+
+void LegacyCommandBuilder::refreshServerVersion()
+{
+    writeMessage("VERSION SERVER");
+}
+
+void LegacyCommandBuilder::refreshTemplateHostVersion()
+{
+    writeMessage("VERSION TEMPLATEHOST");
+}
+
+void LegacyCommandBuilder::refreshMedia()
+{
+    writeMessage("CLS");
+}
+
+void LegacyCommandBuilder::refreshTemplate()
+{
+    writeMessage("TLS");
+}
+
+void LegacyCommandBuilder::refreshChannels()
+{
+    writeMessage("INFO");
+}
+
+void LegacyCommandBuilder::refreshThumbnail()
+{
+    writeMessage("THUMBNAIL LIST");
+}
+
+void LegacyCommandBuilder::retrieveThumbnail(const QString& name)
+{
+    writeMessage(QString("THUMBNAIL RETRIEVE \"%1\"").arg(name));
+}
+
+void LegacyCommandBuilder::sendCommand(const QString& command)
+{
+    writeMessage(QString("%1").arg(command));
+}
+
+void LegacyCommandBuilder::clearChannel(int channel)
+{
+    writeMessage(QString("CLEAR %1").arg(channel));
+}
+
+void LegacyCommandBuilder::clearMixerChannel(int channel)
+{
+    writeMessage(QString("MIXER %1 CLEAR").arg(channel));
+}
+
+void LegacyCommandBuilder::clearVideolayer(int channel, int videolayer)
+{
+    writeMessage(QString("CLEAR %1-%2").arg(channel).arg(videolayer));
+}
+
+void LegacyCommandBuilder::clearMixerVideolayer(int channel, int videolayer)
+{
+    writeMessage(QString("MIXER %1-%2 CLEAR").arg(channel).arg(videolayer));
+}
+
+void LegacyCommandBuilder::pause(int channel, int videolayer)
+{
+    writeMessage(QString("PAUSE %1-%2").arg(channel).arg(videolayer));
+}
+
+void LegacyCommandBuilder::resume(int channel, int videolayer)
+{
+    writeMessage(QString("RESUME %1-%2").arg(channel).arg(videolayer));
+}
+
+void LegacyCommandBuilder::stop(int channel, int videolayer)
+{
+    writeMessage(QString("STOP %1-%2").arg(channel).arg(videolayer));
+}
+
+void LegacyCommandBuilder::play(int channel, int videolayer)
+{
+    writeMessage(QString("PLAY %1-%2").arg(channel).arg(videolayer));
+}
+
+void LegacyCommandBuilder::print(int channel, const QString& output)
+{
+    writeMessage(QString("ADD %1 IMAGE \"%2\"").arg(channel).arg(output));
+}
+
+void LegacyCommandBuilder::loadRouteChannel(int toChannel, int toVideolayer, int fromChannel)
+{
+    writeMessage(QString("LOADBG %1-%2 route://%3").arg(toChannel).arg(toVideolayer).arg(fromChannel));
+}
+
+void LegacyCommandBuilder::loadRouteChannel(int toChannel, int toVideolayer, int fromChannel, int outputDelay)
+{
+    writeMessage(QString("LOADBG %1-%2 route://%3 FRAMES_DELAY %4").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(outputDelay));
+}
+
+void LegacyCommandBuilder::playRouteChannel(int toChannel, int toVideolayer, int fromChannel)
+{
+    writeMessage(QString("PLAY %1-%2 route://%3").arg(toChannel).arg(toVideolayer).arg(fromChannel));
+}
+
+void LegacyCommandBuilder::playRouteChannel(int toChannel, int toVideolayer, int fromChannel, int outputDelay)
+{
+    writeMessage(QString("PLAY %1-%2 route://%3 FRAMES_DELAY %4").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(outputDelay));
+}
+
+void LegacyCommandBuilder::loadRouteVideolayer(int toChannel, int toVideolayer, int fromChannel, int fromVideolayer)
+{
+    writeMessage(QString("LOADBG %1-%2 route://%3-%4").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(fromVideolayer));
+}
+
+void LegacyCommandBuilder::loadRouteVideolayer(int toChannel, int toVideolayer, int fromChannel, int fromVideolayer, int outputDelay)
+{
+    writeMessage(QString("LOADBG %1-%2 route://%3-%4 FRAMES_DELAY %5").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(fromVideolayer).arg(outputDelay));
+}
+
+void LegacyCommandBuilder::playRouteVideolayer(int toChannel, int toVideolayer, int fromChannel, int fromVideolayer)
+{
+    writeMessage(QString("PLAY %1-%2 route://%3-%4").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(fromVideolayer));
+}
+
+void LegacyCommandBuilder::playRouteVideolayer(int toChannel, int toVideolayer, int fromChannel, int fromVideolayer, int outputDelay)
+{
+    writeMessage(QString("PLAY %1-%2 route://%3-%4 FRAMES_DELAY %5").arg(toChannel).arg(toVideolayer).arg(fromChannel).arg(fromVideolayer).arg(outputDelay));
+}
+
+void LegacyCommandBuilder::addTemplate(int channel, int videolayer, int flashlayer, const QString& name, bool playOnLoad)
+{
+    writeMessage(QString("CG %1-%2 ADD %3 \"%4\" %5")
+                 .arg(channel).arg(videolayer).arg(flashlayer).arg(name)
+                 .arg((playOnLoad == true) ? "1" : "0"));
+}
+
+void LegacyCommandBuilder::addTemplate(int channel, int videolayer, int flashlayer, const QString& name, bool playOnLoad,
+                               const QString& data)
+{
+    writeMessage(QString("CG %1-%2 ADD %3 %4 \"%5\" \"%6\"")
+                 .arg(channel).arg(videolayer).arg(flashlayer).arg(name)
+                 .arg((playOnLoad == true) ? "1" : "0").arg(data));
+}
+
+void LegacyCommandBuilder::invokeTemplate(int channel, int videolayer, int flashlayer, const QString& label)
+{
+    QString value = label;
+    value = value.replace("\\", "\\\\").replace("\"", "\\\""); // Escape possibly HTML params.
+
+    writeMessage(QString("CG %1-%2 INVOKE %3 \"%4\"")
+                 .arg(channel).arg(videolayer).arg(flashlayer).arg(value));
+}
+
+void LegacyCommandBuilder::nextTemplate(int channel, int videolayer, int flashlayer)
+{
+    writeMessage(QString("CG %1-%2 NEXT %3")
+                 .arg(channel).arg(videolayer).arg(flashlayer));
+}
+
+void LegacyCommandBuilder::playTemplate(int channel, int videolayer, int flashlayer)
+{
+    writeMessage(QString("CG %1-%2 PLAY %3")
+                 .arg(channel).arg(videolayer).arg(flashlayer));
+}
+
+void LegacyCommandBuilder::playTemplate(int channel, int videolayer, int flashlayer, const QString& name)
+{
+    writeMessage(QString("CG %1-%2 ADD %3 \"%4\" 1")
+                 .arg(channel).arg(videolayer).arg(flashlayer).arg(name));
+}
+
+void LegacyCommandBuilder::playTemplate(int channel, int videolayer, int flashlayer, const QString& name, const QString& data)
+{
+    writeMessage(QString("CG %1-%2 ADD %3 \"%4\" 1 \"%5\"")
+                 .arg(channel).arg(videolayer).arg(flashlayer).arg(name).arg(data));
+}
+
+void LegacyCommandBuilder::removeTemplate(int channel, int videolayer, int flashlayer)
+{
+    writeMessage(QString("CG %1-%2 REMOVE %3")
+                 .arg(channel).arg(videolayer).arg(flashlayer));
+}
+
+void LegacyCommandBuilder::stopTemplate(int channel, int videolayer, int flashlayer)
+{
+    writeMessage(QString("CG %1-%2 STOP %3")
+                 .arg(channel).arg(videolayer).arg(flashlayer));
+}
+
+void LegacyCommandBuilder::updateTemplate(int channel, int videolayer, int flashlayer, const QString& data)
+{
+    writeMessage(QString("CG %1-%2 UPDATE %3 \"%4\"")
+                 .arg(channel).arg(videolayer).arg(flashlayer).arg(data));
+}
+
+void LegacyCommandBuilder::playHtml(int channel, int videolayer, const QString& url, const QString& transition, int duration,
+                            const QString& easing, const QString& direction, bool useAuto)
+{
+    if (useAuto)
+        loadHtml(channel, videolayer, url, transition, duration, easing, direction, false, useAuto);
+    else
+        writeMessage(QString("PLAY %1-%2 [HTML] \"%3\" %4 %5 %6 %7")
+                     .arg(channel).arg(videolayer).arg(url).arg(transition).arg(duration).arg(easing)
+                     .arg(direction));
+}
+
+void LegacyCommandBuilder::loadHtml(int channel, int videolayer, const QString& url, const QString& transition, int duration,
+                            const QString& easing, const QString& direction, bool freezeOnLoad, bool useAuto)
+{
+    writeMessage(QString("%1 %2-%3 [HTML] \"%4\" %5 %6 %7 %8 %9")
+                 .arg((freezeOnLoad == true) ? "LOAD" : "LOADBG")
+                 .arg(channel).arg(videolayer).arg(url).arg(transition).arg(duration).arg(easing)
+                 .arg(direction)
+                 .arg((useAuto == true) ? "AUTO" : ""));
+}
+
+void LegacyCommandBuilder::playMovie(int channel, int videolayer, const QString& name, const QString& transition, int duration,
+                             const QString& easing, const QString& direction, int seek, int length, bool loop, bool useAuto)
+{
+    if (useAuto)
+        loadMovie(channel, videolayer, name, transition, duration, easing, direction, seek, length, loop, false, useAuto);
+    else
+        writeMessage(QString("PLAY %1-%2 \"%3\" %4 %5 %6 %7 %8 %9 %10")
+                     .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
+                     .arg(direction)
+                     .arg((seek > 0) ? QString("SEEK %1").arg(seek) : "")
+                     .arg((length > 0) ? QString("LENGTH %1").arg(length) : "")
+                     .arg((loop == true) ? "LOOP" : ""));
+}
+
+void LegacyCommandBuilder::loadMovie(int channel, int videolayer, const QString& name, const QString& transition, int duration,
+                             const QString& easing, const QString& direction, int seek, int length, bool loop,
+                             bool freezeOnLoad, bool useAuto)
+{
+    writeMessage(QString("%1 %2-%3 \"%4\" %5 %6 %7 %8 %9 %10 %11 %12")
+                 .arg((freezeOnLoad == true) ? "LOAD" : "LOADBG")
+                 .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
+                 .arg(direction)
+                 .arg((seek > 0) ? QString("SEEK %1").arg(seek) : "")
+                 .arg((length > 0) ? QString("LENGTH %1").arg(length) : "")
+                 .arg((loop == true) ? "LOOP" : "")
+                 .arg((useAuto == true) ? "AUTO" : ""));
+}
+
+void LegacyCommandBuilder::playAudio(int channel, int videolayer, const QString& name, const QString& transition, int duration,
+                             const QString& easing, const QString& direction, bool loop, bool useAuto)
+{
+    if (useAuto)
+        loadAudio(channel, videolayer, name, transition, duration, easing, direction, loop, useAuto);
+    else
+        writeMessage(QString("PLAY %1-%2 \"%3\" %4 %5 %6 %7 %8")
+                     .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
+                     .arg(direction)
+                     .arg((loop == true) ? "LOOP" : ""));
+}
+
+void LegacyCommandBuilder::loadAudio(int channel, int videolayer, const QString& name, const QString& transition, int duration,
+                             const QString& easing, const QString& direction, bool loop, bool useAuto)
+{
+    writeMessage(QString("LOADBG %1-%2 \"%3\" %4 %5 %6 %7 %8 %9")
+                 .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
+                 .arg(direction)
+                 .arg((loop == true) ? "LOOP" : "")
+                 .arg((useAuto == true) ? "AUTO" : ""));
+}
+
+void LegacyCommandBuilder::playColor(int channel, int videolayer, const QString& color, const QString &transition, int duration,
+                             const QString& easing, const QString& direction, bool useAuto)
+{
+    if (useAuto)
+        loadColor(channel, videolayer, color, transition, duration, easing, direction, useAuto);
+    else
+        writeMessage(QString("PLAY %1-%2 \"%3\" %4 %5 %6 %7")
+                     .arg(channel).arg(videolayer).arg(color).arg(transition).arg(duration).arg(easing)
+                     .arg(direction));
+}
+
+void LegacyCommandBuilder::loadColor(int channel, int videolayer, const QString& color, const QString& transition, int duration,
+                             const QString& easing, const QString& direction, bool useAuto)
+{
+    writeMessage(QString("LOADBG %1-%2 \"%3\" %4 %5 %6 %7 %8")
+                 .arg(channel).arg(videolayer).arg(color).arg(transition).arg(duration).arg(easing)
+                 .arg(direction)
+                 .arg((useAuto == true) ? "AUTO" : ""));
+}
+
+void LegacyCommandBuilder::playStill(int channel, int videolayer, const QString& name, const QString& transition, int duration,
+                             const QString& easing, const QString& direction, bool useAuto)
+{
+    if (useAuto)
+        loadStill(channel, videolayer, name, transition, duration, easing, direction, useAuto);
+    else
+        writeMessage(QString("PLAY %1-%2 \"%3\" %4 %5 %6 %7")
+                     .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
+                     .arg(direction));
+}
+
+void LegacyCommandBuilder::loadStill(int channel, int videolayer, const QString& name, const QString& transition, int duration,
+                             const QString& easing, const QString& direction, bool useAuto)
+{
+    writeMessage(QString("LOADBG %1-%2 \"%3\" %4 %5 %6 %7")
+                 .arg(channel).arg(videolayer).arg(name).arg(transition).arg(duration).arg(easing)
+                 .arg(direction)
+                 .arg((useAuto == true) ? "AUTO" : ""));
+}
+
+void LegacyCommandBuilder::startFileRecorder(int channel, const QString& filename, const QString& preset, bool withAlpha)
+{
+    writeMessage(QString("ADD %1-%2 FILE \"%3\" %4 %5")
+                 .arg(channel)
+                 .arg(QString("%1").arg(qChecksum(filename.toUtf8())))
+                 .arg(filename)
+                 .arg((preset != "") ? preset : "")
+                 .arg((withAlpha == true) ? "SEPARATE_KEY" : ""));
+}
+
+void LegacyCommandBuilder::stopFileRecorder(int channel, const QString& filename)
+{
+    writeMessage(QString("REMOVE %1-%2 FILE")
+                 .arg(channel)
+                 .arg(QString("%1").arg(qChecksum(filename.toUtf8()))));
+}
+
+void LegacyCommandBuilder::startStream(int channel, int port, int quality, bool key, int width, int height)
+{
+    if (width > 0 && height > 0)
+    {
+        //writeMessage(QString("ADD %1 STREAM udp://<client_ip_address>:%2 -format mpegts -codec:v libx264 -crf:v %3 -tune:v zerolatency -preset:v ultrafast -filter:v scale=%4:%5%6")
+          //           .arg(channel).arg(port).arg(quality).arg(width).arg(height).arg((key == true) ? ",alphaextract,format=pix_fmts=yuv422p" : ""));
+        writeMessage(QString("ADD %1 STREAM udp://<client_ip_address>:%2 -format mpegts -codec:v libx264 -crf:v %3 -tune:v zerolatency -preset:v ultrafast -filter:v %4scale=%5:%6")
+                             .arg(channel).arg(port).arg(quality)
+                             .arg((key == true) ? "alphaextract,format=pix_fmts=yuv422p," : "")
+                             .arg(width).arg(height));
+    }
+    else
+    {
+        writeMessage(QString("ADD %1 STREAM udp://<client_ip_address>:%2 -format mpegts -codec:v libx264 -crf:v %3 -tune:v zerolatency -preset:v ultrafast %4")
+                     .arg(channel).arg(port).arg(quality).arg((key == true) ? "-filter:v alphaextract" : ""));
+    }
+}
+
+void LegacyCommandBuilder::stopStream(int channel, int port)
+{
+    writeMessage(QString("REMOVE %1 STREAM udp://<client_ip_address>:%2").arg(channel).arg(port));
+}
+
+void LegacyCommandBuilder::playDeviceInput(int channel, int videolayer, int device, const QString& format)
+{
+    writeMessage(QString("PLAY %1-%2 DECKLINK DEVICE %3 FORMAT %4")
+                 .arg(channel).arg(videolayer).arg(device).arg(format));
+}
+
+void LegacyCommandBuilder::loadDeviceInput(int channel, int videolayer, int device, const QString& format)
+{
+    writeMessage(QString("LOADBG %1-%2 DECKLINK DEVICE %3 FORMAT %4")
+                 .arg(channel).arg(videolayer).arg(device).arg(format));
+}
+
+void LegacyCommandBuilder::playImageScroll(int channel, int videolayer, const QString& name, int blur, int speed,
+                                   bool premultiply, bool progressive)
+{
+    writeMessage(QString("PLAY %1-%2 \"%3\" BLUR %4 SPEED %5 %6 %7")
+                 .arg(channel).arg(videolayer).arg(name).arg(blur).arg(speed)
+                 .arg((premultiply == true) ? "PREMULTIPLY" : "")
+                 .arg((progressive == true) ? "PROGRESSIVE" : ""));
+}
+
+void LegacyCommandBuilder::loadImageScroll(int channel, int videolayer, const QString& name, int blur, int speed,
+                                   bool premultiply, bool progressive)
+{
+    writeMessage(QString("LOADBG %1-%2 \"%3\" BLUR %4 SPEED %5 %6 %7")
+                 .arg(channel).arg(videolayer).arg(name).arg(blur).arg(speed)
+                 .arg((premultiply == true) ? "PREMULTIPLY" : "")
+                 .arg((progressive == true) ? "PROGRESSIVE" : ""));
+}
+
+void LegacyCommandBuilder::setReset(int channel, int videolayer)
+{
+    writeMessage(QString("MIXER %1-%2 CLEAR").arg(channel).arg(videolayer));
+}
+
+void LegacyCommandBuilder::setCommit(int channel)
+{
+    writeMessage(QString("MIXER %1 COMMIT").arg(channel));
+}
+
+void LegacyCommandBuilder::setMasterVolume(int channel, float masterVolume)
+{
+    writeMessage(QString("MIXER %1 MASTERVOLUME %2").arg(channel).arg(masterVolume));
+}
+
+void LegacyCommandBuilder::setChroma(int channel, int videolayer, const QString& key, float threshold, float spread, float spill)
+{
+    writeMessage(QString("MIXER %1-%2 CHROMA %3 %4 %5 %6")
+                 .arg(channel).arg(videolayer).arg(key).arg(threshold).arg(spread).arg(spill));
+}
+
+void LegacyCommandBuilder::setBlendMode(int channel, int videolayer, const QString& blendMode)
+{
+    writeMessage(QString("MIXER %1-%2 BLEND %3")
+                 .arg(channel).arg(videolayer).arg(blendMode));
+}
+
+void LegacyCommandBuilder::setGrid(int channel, int grid, int duration, const QString& easing, bool defer)
+{
+    writeMessage(QString("MIXER %1 GRID %2 %3 %4 %5")
+                 .arg(channel).arg(grid).arg(duration).arg(easing)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setKeyer(int channel, int videolayer, int keyer, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 KEYER %3 %4")
+                 .arg(channel).arg(videolayer).arg(keyer)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setVolume(int channel, int videolayer, float volume, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 VOLUME %3 %4")
+                 .arg(channel).arg(videolayer).arg(volume)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setVolume(int channel, int videolayer, float volume, int duration, const QString& easing, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 VOLUME %3 %4 %5 %6")
+                 .arg(channel).arg(videolayer).arg(volume).arg(duration)
+                 .arg(easing).arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setOpacity(int channel, int videolayer, float opacity, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 OPACITY %3 %4")
+                 .arg(channel).arg(videolayer).arg(opacity)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setOpacity(int channel, int videolayer, float opacity, int duration, const QString& easing, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 OPACITY %3 %4 %5 %6")
+                 .arg(channel).arg(videolayer).arg(opacity).arg(duration).arg(easing)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setBrightness(int channel, int videolayer, float brightness, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 BRIGHTNESS %3 %4")
+                 .arg(channel).arg(videolayer).arg(brightness)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setBrightness(int channel, int videolayer, float brightness, int duration, const QString& easing, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 BRIGHTNESS %3 %4 %5 %6")
+                .arg(channel).arg(videolayer).arg(brightness).arg(duration).arg(easing)
+                .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setContrast(int channel, int videolayer, float contrast, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 CONTRAST %3 %4")
+                 .arg(channel).arg(videolayer).arg(contrast)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setContrast(int channel, int videolayer, float contrast, int duration, const QString& easing, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 CONTRAST %3 %4 %5 %6")
+                 .arg(channel).arg(videolayer).arg(contrast).arg(duration).arg(easing)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setSaturation(int channel, int videolayer, float saturation, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 SATURATION %3 %4")
+                 .arg(channel).arg(videolayer).arg(saturation)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setSaturation(int channel, int videolayer, float saturation, int duration, const QString& easing, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 SATURATION %3 %4 %5 %6")
+                 .arg(channel).arg(videolayer).arg(saturation).arg(duration).arg(easing)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setLevels(int channel, int videolayer, float minIn, float maxIn, float gamma, float minOut, float maxOut,
+                             bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 LEVELS %3 %4 %5 %6 %7 %8")
+                 .arg(channel).arg(videolayer).arg(minIn).arg(maxIn).arg(gamma).arg(minOut).arg(maxOut)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setLevels(int channel, int videolayer, float minIn, float maxIn, float gamma, float minOut, float maxOut,
+                             int duration, const QString& easing, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 LEVELS %3 %4 %5 %6 %7 %8 %9 %10")
+                 .arg(channel).arg(videolayer).arg(minIn).arg(maxIn).arg(gamma).arg(minOut).arg(maxOut)
+                 .arg(duration).arg(easing)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setFill(int channel, int videolayer, float positionX, float positionY, float scaleX, float scaleY,
+                           bool defer, bool useMipmap)
+{
+    writeMessage(QString("MIXER %1-%2 MIPMAP %3").arg(channel).arg(videolayer).arg((useMipmap == true) ? "1" : "0"));
+    writeMessage(QString("MIXER %1-%2 FILL %3 %4 %5 %6 %7")
+                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY).arg(scaleX).arg(scaleY)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setFill(int channel, int videolayer, float positionX, float positionY, float scaleX, float scaleY,
+                           int duration, const QString& easing, bool defer, bool useMipmap)
+{
+    writeMessage(QString("MIXER %1-%2 MIPMAP %3").arg(channel).arg(videolayer).arg((useMipmap == true) ? "1" : "0"));
+    writeMessage(QString("MIXER %1-%2 FILL %3 %4 %5 %6 %7 %8 %9")
+                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY).arg(scaleX).arg(scaleY)
+                 .arg(duration).arg(easing)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setClipping(int channel, int videolayer, float positionX, float positionY, float scaleX, float scaleY,
+                               bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 CLIP %3 %4 %5 %6 %7")
+                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY).arg(scaleX)
+                 .arg(scaleY).arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setClipping(int channel, int videolayer, float positionX, float positionY, float scaleX, float scaleY,
+                               int duration, const QString& easing, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 CLIP %3 %4 %5 %6 %7 %8 %9")
+                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY).arg(scaleX).arg(scaleY)
+                 .arg(duration).arg(easing)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setCrop(int channel, int videolayer, float upperLeftX, float upperLeftY, float lowerRightX, float lowerRightY, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 CROP %3 %4 %5 %6 %7")
+                 .arg(channel).arg(videolayer).arg(upperLeftX).arg(upperLeftY).arg(lowerRightX).arg(lowerRightY)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setCrop(int channel, int videolayer, float upperLeftX, float upperLeftY, float lowerRightX, float lowerRightY, int duration, const QString& easing, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 CROP %3 %4 %5 %6 %7 %8 %9")
+                 .arg(channel).arg(videolayer).arg(upperLeftX).arg(upperLeftY).arg(lowerRightX).arg(lowerRightY)
+                 .arg(duration).arg(easing)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setPerspective(int channel, int videolayer, float upperLeftX, float upperLeftY, float upperRightX, float upperRightY,
+                                  float lowerRightX, float lowerRightY, float lowerLeftX, float lowerLeftY, bool defer, bool useMipmap)
+{
+    writeMessage(QString("MIXER %1-%2 MIPMAP %3").arg(channel).arg(videolayer).arg((useMipmap == true) ? "1" : "0"));
+    writeMessage(QString("MIXER %1-%2 PERSPECTIVE %3 %4 %5 %6 %7 %8 %9 %10 %11")
+                 .arg(channel).arg(videolayer)
+                 .arg(upperLeftX).arg(upperLeftY).arg(upperRightX).arg(upperRightY)
+                 .arg(lowerRightX).arg(lowerRightY).arg(lowerLeftX).arg(lowerLeftY)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setPerspective(int channel, int videolayer, float upperLeftX, float upperLeftY, float upperRightX, float upperRightY,
+                                  float lowerRightX, float lowerRightY, float lowerLeftX, float lowerLeftY, int duration, const QString& easing, bool defer, bool useMipmap)
+{
+    writeMessage(QString("MIXER %1-%2 MIPMAP %3").arg(channel).arg(videolayer).arg((useMipmap == true) ? "1" : "0"));
+    writeMessage(QString("MIXER %1-%2 PERSPECTIVE %3 %4 %5 %6 %7 %8 %9 %10 %11 %12 %13")
+                 .arg(channel).arg(videolayer)
+                 .arg(upperLeftX).arg(upperLeftY).arg(upperRightX).arg(upperRightY)
+                 .arg(lowerRightX).arg(lowerRightY).arg(lowerLeftX).arg(lowerLeftY)
+                 .arg(duration).arg(easing)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setRotation(int channel, int videolayer, float rotation, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 ROTATION %3 %4")
+                 .arg(channel).arg(videolayer).arg(rotation)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setRotation(int channel, int videolayer, float rotation, int duration, const QString& easing, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 ROTATION %3 %4 %5 %6")
+                .arg(channel).arg(videolayer).arg(rotation).arg(duration).arg(easing)
+                .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setAnchor(int channel, int videolayer, float positionX, float positionY, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 ANCHOR %3 %4 %5")
+                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
+
+void LegacyCommandBuilder::setAnchor(int channel, int videolayer, float positionX, float positionY, int duration, const QString& easing, bool defer)
+{
+    writeMessage(QString("MIXER %1-%2 ANCHOR %3 %4 %5 %6 %7")
+                 .arg(channel).arg(videolayer).arg(positionX).arg(positionY)
+                 .arg(duration).arg(easing)
+                 .arg((defer == true) ? "DEFER" : ""));
+}
@@ -0,0 +1,303 @@
+#include "MockCasparServer.h"
+
+#include <chrono>
+#include <stdexcept>
+
+#include <osc/OscOutboundPacketStream.h>
+#include <ip/UdpSocket.h>
+
+#include <QtCore/QList>
+
+#include <QtNetwork/QTcpSocket>
+
+MockCasparServer::MockCasparServer(QObject* parent)
+    : QTcpServer(parent), version("2.3.0 Stable"), mediaCount(1000), templateCount(100), thumbnailSize(16384), commandCount(0), oscTimer(this)
+{
+    QObject::connect(this, SIGNAL(newConnection()), this, SLOT(addConnection()));
+    QObject::connect(&this->oscTimer, SIGNAL(timeout()), this, SLOT(sendOscFrame()));
+}
+
+qint64 MockCasparServer::timestamp()
+{
+    // Steady clock in nanoseconds, shared with the benchmark so a command can be timed from the call to the wire.
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void MockCasparServer::setVersion(const QString& version)
+{
+    // Only read by the server thread, set it before the server is started.
+    this->version = version;
+}
+
+void MockCasparServer::setMediaCount(int count)
+{
+    this->mediaCount.store(count);
+}
+
+void MockCasparServer::setTemplateCount(int count)
+{
+    this->templateCount.store(count);
+}
+
+void MockCasparServer::setThumbnailSize(int size)
+{
+    this->thumbnailSize.store(size);
+}
+
+qint64 MockCasparServer::getCommandCount() const
+{
+    return this->commandCount.load();
+}
+
+bool MockCasparServer::start(int port)
+{
+    if (!QTcpServer::listen(QHostAddress::Any, port))
+    {
+        qCritical("Failed to listen on port %d: %s", port, qPrintable(QTcpServer::errorString()));
+        return false;
+    }
+
+    qDebug("Listening for incoming AMCP connections on port %d", QTcpServer::serverPort());
+
+    return true;
+}
+
+void MockCasparServer::addConnection()
+{
+    while (QTcpServer::hasPendingConnections())
+    {
+        QTcpSocket* socket = QTcpServer::nextPendingConnection();
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+        this->buffers.insert(socket, QByteArray());
+
+        QObject::connect(socket, SIGNAL(readyRead()), this, SLOT(readMessage()));
+        QObject::connect(socket, SIGNAL(disconnected()), this, SLOT(removeConnection()));
+    }
+}
+
+void MockCasparServer::removeConnection()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(QObject::sender());
+    if (socket == nullptr)
+        return;
+
+    this->buffers.remove(socket);
+    socket->deleteLater();
+}
+
+void MockCasparServer::readMessage()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(QObject::sender());
+    if (socket == nullptr || !this->buffers.contains(socket))
+        return;
+
+    // Taken before anything is parsed, this is the moment the command reached the server.
+    qint64 received = timestamp();
+
+    QByteArray& buffer = this->buffers[socket];
+    buffer.append(socket->readAll());
+
+    QByteArray replies;
+    qsizetype position;
+    while ((position = buffer.indexOf("\r\n")) != -1)
+    {
+        QByteArray command = buffer.left(position);
+        buffer.remove(0, position + 2);
+
+        if (command.isEmpty())
+            continue;
+
+        this->commandCount.fetch_add(1);
+
+        // Pipelined commands are prefixed with REQ <id>, the reply echoes the id as RES <id>.
+        QByteArray prefix;
+        if (command.startsWith("REQ "))
+        {
+            qsizetype separator = command.indexOf(' ', 4);
+            if (separator != -1)
+            {
+                prefix = "RES " + command.mid(4, separator - 4) + " ";
+                command = command.mid(separator + 1);
+            }
+        }
+
+        emit commandReceived(QString::fromUtf8(command), received);
+
+        replies.append(prefix);
+        replies.append(reply(command));
+    }
+
+    if (!replies.isEmpty())
+    {
+        socket->write(replies);
+        socket->flush();
+    }
+}
+
+QByteArray MockCasparServer::reply(const QByteArray& command)
+{
+    QList<QByteArray> tokens = command.trimmed().toUpper().split(' ');
+    QByteArray name = tokens.at(0);
+    if (tokens.count() > 1 && (name == "DATA" || name == "THUMBNAIL" || (name == "INFO" && tokens.at(1) == "SYSTEM")))
+        name += " " + tokens.at(1);
+
+    if (name == "VERSION")
+        return QString("201 VERSION OK\r\n%1\r\n").arg(this->version).toUtf8();
+
+    if (name == "CLS")
+    {
+        // Listings are generated once per size, a refresh of an unchanged library returns the same bytes.
+        int count = this->mediaCount.load();
+        if (count != this->mediaListCount)
+        {
+            this->mediaListCount = count;
+            this->mediaList = "200 CLS OK\r\n";
+            for (int i = 0; i < count; i++)
+                this->mediaList.append(QString("\"MEDIA/CLIP%1\" MOVIE 6445960 20121101160514 643 1/25\r\n").arg(i, 6, 10, QChar('0')).toUtf8());
+
+            this->mediaList.append("\r\n");
+        }
+
+        return this->mediaList;
+    }
+
+    if (name == "TLS")
+    {
+        int count = this->templateCount.load();
+        if (count != this->templateListCount)
+        {
+            this->templateListCount = count;
+            this->templateList = "200 TLS OK\r\n";
+            for (int i = 0; i < count; i++)
+                this->templateList.append(QString("\"TEMPLATES/TEMPLATE%1\" 34621 20121101160514\r\n").arg(i, 6, 10, QChar('0')).toUtf8());
+
+            this->templateList.append("\r\n");
+        }
+
+        return this->templateList;
+    }
+
+    if (name == "DATA LIST")
+    {
+        if (this->dataList.isEmpty())
+            this->dataList = "200 DATA LIST OK\r\n\"DATA/DATA000000\"\r\n\"DATA/DATA000001\"\r\n\r\n";
+
+        return this->dataList;
+    }
+
+    if (name == "THUMBNAIL LIST")
+    {
+        int count = this->mediaCount.load();
+        if (count != this->thumbnailListCount)
+        {
+            this->thumbnailListCount = count;
+            this->thumbnailList = "200 THUMBNAIL LIST OK\r\n";
+            for (int i = 0; i < count; i++)
+                this->thumbnailList.append(QString("\"MEDIA/CLIP%1\" 20121101T160514 %2\r\n").arg(i, 6, 10, QChar('0')).arg(this->thumbnailSize.load()).toUtf8());
+
+            this->thumbnailList.append("\r\n");
+        }
+
+        return this->thumbnailList;
+    }
+
+    if (name == "THUMBNAIL RETRIEVE")
+    {
+        // Pseudo random bytes, so the blob is as large on the wire as a real PNG of that size.
+        int size = this->thumbnailSize.load();
+        if (size != this->thumbnailDataSize)
+        {
+            this->thumbnailDataSize = size;
+
+            QByteArray data(size, Qt::Uninitialized);
+            quint32 seed = 0x12345678;
+            for (int i = 0; i < size; i++)
+            {
+                seed = seed * 1664525 + 1013904223;
+                data[i] = static_cast<char>(seed >> 24);
+            }
+
+            this->thumbnailData = "201 THUMBNAIL RETRIEVE OK\r\n" + data.toBase64() + "\r\n";
+        }
+
+        return this->thumbnailData;
+    }
+
+    if (name == "INFO")
+    {
+        if (tokens.count() > 1)
+            return QString("201 INFO OK\r\n<layer><status>playing</status></layer>\r\n").toUtf8();
+
+        return "200 INFO OK\r\n1 1080i5000 PLAYING\r\n2 1080i5000 PLAYING\r\n\r\n";
+    }
+
+    if (name == "INFO SYSTEM")
+        return "201 INFO SYSTEM OK\r\n<system><name>mock</name></system>\r\n";
+
+    return "202 " + name + " OK\r\n";
+}
+
+void MockCasparServer::startOsc(const QString& address, int port, int layers, int rate)
+{
+    this->oscAddress = address;
+    this->oscPort = port;
+    this->oscLayers = layers;
+
+    this->oscTimer.start(1000 / qMax(1, rate));
+
+    qDebug("Sending OSC messages for %d layers to %s:%d at %d frames per second", layers, qPrintable(address), port, rate);
+}
+
+void MockCasparServer::sendOscFrame()
+{
+    sendOsc(this->oscAddress, this->oscPort, this->oscLayers * 3, this->oscLayers);
+}
+
+qint64 MockCasparServer::sendOsc(const QString& address, int port, int count, int layers)
+{
+    // Same shape as the server, one bundle per layer and frame with the file time, frame and pause state.
+    // The frame carries a running sequence number, the receiver can tell when the last message has arrived.
+    QList<QByteArray> timePaths;
+    QList<QByteArray> framePaths;
+    QList<QByteArray> pausedPaths;
+    for (int layer = 1; layer <= layers; layer++)
+    {
+        timePaths.append(QString("/channel/1/stage/layer/%1/file/time").arg(layer).toUtf8());
+        framePaths.append(QString("/channel/1/stage/layer/%1/file/frame").arg(layer).toUtf8());
+        pausedPaths.append(QString("/channel/1/stage/layer/%1/paused").arg(layer).toUtf8());
+    }
+
+    try
+    {
+        UdpTransmitSocket socket(IpEndpointName(address.toStdString().c_str(), port));
+
+        char buffer[1024];
+        int sent = 0;
+        while (sent < count)
+        {
+            for (int layer = 0; layer < layers && sent < count; layer++)
+            {
+                this->oscSequence++;
+
+                osc::OutboundPacketStream stream(buffer, sizeof(buffer));
+                stream << osc::BeginBundleImmediate
+                       << osc::BeginMessage(timePaths.at(layer).constData()) << static_cast<float>(this->oscSequence / 25.0) << 25.76f << osc::EndMessage
+                       << osc::BeginMessage(framePaths.at(layer).constData()) << static_cast<osc::int32>(this->oscSequence) << static_cast<osc::int32>(644) << osc::EndMessage
+                       << osc::BeginMessage(pausedPaths.at(layer).constData()) << false << osc::EndMessage
+                       << osc::EndBundle;
+
+                socket.Send(stream.Data(), stream.Size());
+
+                sent += 3;
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        qCritical("Failed to send OSC messages: %s", e.what());
+        return 0;
+    }
+
+    return this->oscSequence;
+}
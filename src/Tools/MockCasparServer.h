@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+
+#include <QtNetwork/QTcpServer>
+
+class QTcpSocket;
+
+class MockCasparServer : public QTcpServer
+{
+    Q_OBJECT
+
+    public:
+        explicit MockCasparServer(QObject* parent = 0);
+
+        static qint64 timestamp();
+
+        void setVersion(const QString& version);
+        void setMediaCount(int count);
+        void setTemplateCount(int count);
+        void setThumbnailSize(int size);
+
+        qint64 getCommandCount() const;
+
+        void startOsc(const QString& address, int port, int layers, int rate);
+
+        QByteArray reply(const QByteArray& command);
+
+        Q_SLOT bool start(int port);
+        Q_SLOT qint64 sendOsc(const QString& address, int port, int count, int layers);
+
+        Q_SIGNAL void commandReceived(const QString&, qint64);
+
+    private:
+        QString version;
+
+        std::atomic<int> mediaCount;
+        std::atomic<int> templateCount;
+        std::atomic<int> thumbnailSize;
+        std::atomic<qint64> commandCount;
+
+        int mediaListCount = -1;
+        int templateListCount = -1;
+        int thumbnailListCount = -1;
+        int thumbnailDataSize = -1;
+
+        QByteArray mediaList;
+        QByteArray templateList;
+        QByteArray dataList;
+        QByteArray thumbnailList;
+        QByteArray thumbnailData;
+
+        qint64 oscSequence = 0;
+        QTimer oscTimer;
+        QString oscAddress;
+        int oscPort = 0;
+        int oscLayers = 0;
+
+        QHash<QTcpSocket*, QByteArray> buffers;
+
+        Q_SLOT void addConnection();
+        Q_SLOT void removeConnection();
+        Q_SLOT void readMessage();
+        Q_SLOT void sendOscFrame();
+};
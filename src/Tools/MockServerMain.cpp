@@ -0,0 +1,43 @@
+#include "MockCasparServer.h"
+
+#include <QtCore/QCommandLineOption>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setApplicationName("casparcg-mock-server");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Answers AMCP commands with synthetic replies and sends synthetic OSC messages.");
+    parser.addHelpOption();
+
+    QCommandLineOption portOption("port", "TCP port to listen on for AMCP.", "port", "5250");
+    QCommandLineOption versionOption("server-version", "Version reported by VERSION.", "version", "2.3.0 Stable");
+    QCommandLineOption clipsOption("clips", "Number of clips listed by CLS and THUMBNAIL LIST.", "count", "1000");
+    QCommandLineOption templatesOption("templates", "Number of templates listed by TLS.", "count", "100");
+    QCommandLineOption thumbnailSizeOption("thumbnail-size", "Size in bytes of the thumbnail returned by THUMBNAIL RETRIEVE.", "bytes", "16384");
+    QCommandLineOption oscAddressOption("osc-address", "Address to send OSC messages to.", "address", "127.0.0.1");
+    QCommandLineOption oscPortOption("osc-port", "UDP port to send OSC messages to, 0 disables OSC.", "port", "6250");
+    QCommandLineOption oscLayersOption("osc-layers", "Number of layers OSC messages are sent for.", "count", "10");
+    QCommandLineOption oscRateOption("osc-rate", "OSC frames sent per second.", "rate", "50");
+    parser.addOptions({ portOption, versionOption, clipsOption, templatesOption, thumbnailSizeOption,
+                        oscAddressOption, oscPortOption, oscLayersOption, oscRateOption });
+
+    parser.process(application);
+
+    MockCasparServer server;
+    server.setVersion(parser.value(versionOption));
+    server.setMediaCount(parser.value(clipsOption).toInt());
+    server.setTemplateCount(parser.value(templatesOption).toInt());
+    server.setThumbnailSize(parser.value(thumbnailSizeOption).toInt());
+
+    if (!server.start(parser.value(portOption).toInt()))
+        return 1;
+
+    if (parser.value(oscPortOption).toInt() > 0)
+        server.startOsc(parser.value(oscAddressOption), parser.value(oscPortOption).toInt(), parser.value(oscLayersOption).toInt(), parser.value(oscRateOption).toInt());
+
+    return application.exec();
+}
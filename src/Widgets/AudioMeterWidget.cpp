@@ -5,6 +5,7 @@
 #include "DatabaseManager.h"
 #include "DeviceManager.h"
 #include "EventManager.h"
+#include "HostResolver.h"
 
 #include <cmath>
 
@@ -15,6 +16,7 @@ AudioMeterWidget::AudioMeterWidget(QWidget* parent)
     setupUi(this);
 
     QObject::connect(&EventManager::getInstance(), SIGNAL(deviceChanged(const DeviceChangedEvent&)), this, SLOT(deviceChanged(const DeviceChangedEvent&)));
+    QObject::connect(&HostResolver::getInstance(), SIGNAL(hostResolved(const QString&, const QString&)), this, SLOT(hostResolved(const QString&, const QString&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(channelChanged(const ChannelChangedEvent&)), this, SLOT(channelChanged(const ChannelChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(emptyRundown(const EmptyRundownEvent&)), this, SLOT(emptyRundown(const EmptyRundownEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(rundownItemSelected(const RundownItemSelectedEvent&)), this, SLOT(rundownItemSelected(const RundownItemSelectedEvent&)));
@@ -51,6 +53,21 @@ void AudioMeterWidget::deviceChanged(const DeviceChangedEvent& event)
     }
 }
 
+void AudioMeterWidget::hostResolved(const QString& hostName, const QString& address)
+{
+    Q_UNUSED(address);
+
+    if (this->model == NULL)
+        return;
+
+    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model->getDeviceName());
+    if (device == NULL || device->getAddress() != hostName)
+        return;
+
+    // The filters were set up before the host name was resolved, or it resolves to another address now.
+    configureOscSubscriptions();
+}
+
 void AudioMeterWidget::channelChanged(const ChannelChangedEvent& event)
 {
     Q_UNUSED(event);
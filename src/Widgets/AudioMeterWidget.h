@@ -34,6 +34,7 @@ class WIDGETS_EXPORT AudioMeterWidget : public QWidget, Ui::AudioMeterWidget
         void configureOscSubscriptions();
 
         Q_SLOT void deviceChanged(const DeviceChangedEvent&);
+        Q_SLOT void hostResolved(const QString&, const QString&);
         Q_SLOT void channelChanged(const ChannelChangedEvent&);
         Q_SLOT void emptyRundown(const EmptyRundownEvent&);
         Q_SLOT void rundownItemSelected(const RundownItemSelectedEvent&);
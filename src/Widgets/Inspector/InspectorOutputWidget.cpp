@@ -5,6 +5,7 @@
 #include "DatabaseManager.h"
 #include "DeviceManager.h"
 #include "EventManager.h"
+#include "LibraryStore.h"
 #include "Commands/BlendModeCommand.h"
 #include "Commands/GridCommand.h"
 #include "Commands/BrightnessCommand.h"
@@ -76,6 +77,16 @@ void InspectorOutputWidget::libraryFilterChanged(const LibraryFilterChangedEvent
 {
     this->libraryFilter = event.getFilter();
 
+    // The target combo only lists the library entries matching the filter.
+    if (this->model != NULL)
+    {
+        blockAllSignals(true);
+
+        fillTargetCombo(this->model->getType());
+
+        blockAllSignals(false);
+    }
+
     checkEmptyTarget();
 }
 
@@ -457,11 +468,7 @@ void InspectorOutputWidget::fillTargetCombo(const QString &type, QString deviceN
 
     if (deviceModel)
     {
-        QList<LibraryModel> models;
-        if (this->libraryFilter.isEmpty())
-            models = DatabaseManager::getInstance().getLibraryByDeviceId(deviceModel->getId());
-        else
-            models = DatabaseManager::getInstance().getLibraryByDeviceIdAndFilter(deviceModel->getId(), this->libraryFilter);
+        QList<LibraryModel> models = LibraryStore::getInstance().getSnapshot()->getByDeviceAddress(deviceModel->getAddress(), this->libraryFilter);
 
         if (models.count() > 0)
         {
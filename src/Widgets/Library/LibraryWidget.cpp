@@ -5,6 +5,8 @@
 #include "DeviceManager.h"
 #include "DatabaseManager.h"
 #include "EventManager.h"
+#include "LibraryFilterWorker.h"
+#include "LibraryStore.h"
 #include "DeviceFilterWidget.h"
 #include "Events/AddPresetItemEvent.h"
 #include "Events/ExportPresetEvent.h"
@@ -16,8 +18,11 @@
 
 #include <QtCore/QPoint>
 #include <QtCore/QFileInfo>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
 #include <QtCore/QSharedDataPointer>
 #include <QtCore/QTextStream>
+#include <QtCore/QThread>
 #include <QtCore/QTime>
 #include <QtCore/QTimer>
 #include <QtCore/QModelIndex>
@@ -29,6 +34,7 @@
 #include <QtGui/QStandardItemModel>
 
 #include <QtWidgets/QApplication>
+#include <QtWidgets/QScrollBar>
 #include <QtWidgets/QTreeWidgetItem>
 #include <QtWidgets/QFileDialog>
 
@@ -102,9 +108,33 @@ LibraryWidget::LibraryWidget(QWidget* parent)
     QObject::connect(&EventManager::getInstance(), SIGNAL(exportPreset(const ExportPresetEvent&)), this, SLOT(exportPreset(const ExportPresetEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(repositoryRundown(const RepositoryRundownEvent&)), this, SLOT(repositoryRundown(const RepositoryRundownEvent&)));
 
+    // Filtering runs on its own thread, typing in a large library never waits on it.
+    this->filterThread = new QThread(this);
+    this->filterThread->setObjectName("Library filter");
+
+    this->filterWorker = new LibraryFilterWorker();
+    this->filterWorker->moveToThread(this->filterThread);
+
+    QObject::connect(this->filterThread, SIGNAL(finished()), this->filterWorker, SLOT(deleteLater()));
+    QObject::connect(this->filterWorker, SIGNAL(filtered()), this, SLOT(libraryFiltered()));
+
+    this->filterThread->start();
+
+    this->filterTimer.setSingleShot(true);
+    this->filterTimer.setInterval(Library::FILTER_DELAY);
+
+    QObject::connect(&this->filterTimer, SIGNAL(timeout()), this, SLOT(filterLibrary()));
+    QObject::connect(this->lineEditFilter, SIGNAL(textEdited(const QString&)), &this->filterTimer, SLOT(start()));
+
     QTimer::singleShot(0, this, SLOT(loadLibrary()));
 }
 
+LibraryWidget::~LibraryWidget()
+{
+    this->filterThread->quit();
+    this->filterThread->wait();
+}
+
 void LibraryWidget::setupTools()
 {
     QTreeWidgetItem* widgetAudio = new QTreeWidgetItem(this->treeWidgetTool->topLevelItem(0));
@@ -506,153 +536,199 @@ void LibraryWidget::mediaChanged(const MediaChangedEvent& event)
 {
     Q_UNUSED(event);
 
-    // TODO: Only add / remove necessary items.
-    this->treeWidgetAudio->clear();
-    this->treeWidgetImage->clear();
-    this->treeWidgetVideo->clear();
-    this->treeWidgetAudio->clearSelection();
-    this->treeWidgetImage->clearSelection();
-    this->treeWidgetVideo->clearSelection();
-
-    QList<LibraryModel> models;
-    if (this->lineEditFilter->text().isEmpty() &&  dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter().count() == 0)
-        models = DatabaseManager::getInstance().getLibraryMedia();
-    else
-        models = DatabaseManager::getInstance().getLibraryMediaByFilter(this->lineEditFilter->text(), dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter());
+    startFilter();
+}
 
-    if (models.count() > 0)
+void LibraryWidget::templateChanged(const TemplateChangedEvent& event)
+{
+    Q_UNUSED(event);
+
+    startFilter();
+}
+
+void LibraryWidget::dataChanged(const DataChangedEvent& event)
+{
+    Q_UNUSED(event);
+
+    startFilter();
+}
+
+void LibraryWidget::startFilter()
+{
+    const QList<QString>& devices = dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter();
+
+    // Thumbnail and filter events fire often, nothing to do when neither the library nor the filter changed.
+    QString state = QString("%1|%2|%3").arg(LibraryStore::getInstance().getSnapshot()->getVersion()).arg(this->lineEditFilter->text()).arg(QStringList(devices).join(","));
+    if (state == this->filterState)
+        return;
+
+    this->filterState = state;
+    this->filterWorker->filter(this->lineEditFilter->text(), devices);
+}
+
+void LibraryWidget::libraryFiltered()
+{
+    quint64 version;
+    QString filter;
+    QList<QString> devices;
+    QList<LibraryModel> media;
+    QList<LibraryModel> templates;
+    QList<LibraryModel> data;
+    if (!this->filterWorker->takeResult(version, filter, devices, media, templates, data))
+        return; // Out of date, the result of the latest filter is still on its way.
+
+    QList<LibraryModel> audioModels;
+    QList<LibraryModel> stillModels;
+    QList<LibraryModel> movieModels;
+    foreach (const LibraryModel& model, media)
     {
-        foreach (LibraryModel model, models)
-        {
-            if (model.getType() == "AUDIO")
-            {
-                QTreeWidgetItem* widget = new QTreeWidgetItem(this->treeWidgetAudio);
-                widget->setIcon(0, QIcon(":/Graphics/Images/AudioSmall.png"));
-                widget->setText(0, model.getName());
-                widget->setText(1, QString("%1").arg(model.getId()));
-                widget->setText(2, model.getLabel());
-                widget->setText(3, model.getDeviceName());
-                widget->setText(4, model.getType());
-                widget->setText(5, QString("%1").arg(model.getThumbnailId()));
-
-                if (this->useDropFrameNotation)
-                {
-                    QString timecode = model.getTimecode();
-                    widget->setText(6, timecode.replace(model.getTimecode().lastIndexOf(":"), 1, "."));
-                }
-                else
-                    widget->setText(6, model.getTimecode());
-            }
-            else if (model.getType() == "STILL")
-            {
-                QTreeWidgetItem* widget = new QTreeWidgetItem(this->treeWidgetImage);
-                widget->setIcon(0, QIcon(":/Graphics/Images/StillSmall.png"));
-                widget->setText(0, model.getName());
-                widget->setText(1, QString("%1").arg(model.getId()));
-                widget->setText(2, model.getLabel());
-                widget->setText(3, model.getDeviceName());
-                widget->setText(4, model.getType());
-                widget->setText(5, QString("%1").arg(model.getThumbnailId()));
-
-                if (this->useDropFrameNotation)
-                {
-                    QString timecode = model.getTimecode();
-                    widget->setText(6, timecode.replace(model.getTimecode().lastIndexOf(":"), 1, "."));
-                }
-                else
-                    widget->setText(6, model.getTimecode());
-            }
-            else if (model.getType() == "MOVIE")
-            {
-                QTreeWidgetItem* widget = new QTreeWidgetItem(this->treeWidgetVideo);
-                widget->setIcon(0, QIcon(":/Graphics/Images/MovieSmall.png"));
-                widget->setText(0, model.getName());
-                widget->setText(1, QString("%1").arg(model.getId()));
-                widget->setText(2, model.getLabel());
-                widget->setText(3, model.getDeviceName());
-                widget->setText(4, model.getType());
-                widget->setText(5, QString("%1").arg(model.getThumbnailId()));
-
-                if (this->useDropFrameNotation)
-                {
-                    QString timecode = model.getTimecode();
-                    widget->setText(6, timecode.replace(model.getTimecode().lastIndexOf(":"), 1, "."));
-                }
-                else
-                    widget->setText(6, model.getTimecode());
-            }
-        }
+        if (model.getType() == "AUDIO")
+            audioModels.push_back(model);
+        else if (model.getType() == "STILL")
+            stillModels.push_back(model);
+        else if (model.getType() == "MOVIE")
+            movieModels.push_back(model);
     }
 
+    updateTreeWidget(this->treeWidgetAudio, audioModels, QIcon(":/Graphics/Images/AudioSmall.png"));
+    updateTreeWidget(this->treeWidgetImage, stillModels, QIcon(":/Graphics/Images/StillSmall.png"));
+    updateTreeWidget(this->treeWidgetVideo, movieModels, QIcon(":/Graphics/Images/MovieSmall.png"));
+    updateTreeWidget(this->treeWidgetTemplate, templates, QIcon(":/Graphics/Images/TemplateSmall.png"));
+    updateTreeWidget(this->treeWidgetData, data, QIcon(":/Graphics/Images/DataSmall.png"));
+
     this->toolBoxLibrary->setItemText(Library::AUDIO_PAGE_INDEX, QString("Audio (%1)").arg(this->treeWidgetAudio->topLevelItemCount()));
     this->toolBoxLibrary->setItemText(Library::STILL_PAGE_INDEX, QString("Images (%1)").arg(this->treeWidgetImage->topLevelItemCount()));
+    this->toolBoxLibrary->setItemText(Library::TEMPLATE_PAGE_INDEX, QString("Templates (%1)").arg(this->treeWidgetTemplate->topLevelItemCount()));
     this->toolBoxLibrary->setItemText(Library::MOVIE_PAGE_INDEX, QString("Videos (%1)").arg(this->treeWidgetVideo->topLevelItemCount()));
+    this->toolBoxLibrary->setItemText(Library::DATA_PAGE_INDEX, QString("Stored Data (%1)").arg(this->treeWidgetData->topLevelItemCount()));
 }
 
-void LibraryWidget::templateChanged(const TemplateChangedEvent& event)
+void LibraryWidget::updateTreeWidget(QTreeWidget* treeWidget, const QList<LibraryModel>& models, const QIcon& icon)
 {
-    Q_UNUSED(event);
-
-    // TODO: Only add / remove necessary items.
-    this->treeWidgetTemplate->clear();
-    this->treeWidgetTemplate->clearSelection();
+    QHash<int, QTreeWidgetItem*> items;
+    items.reserve(treeWidget->topLevelItemCount());
+    for (int i = 0; i < treeWidget->topLevelItemCount(); i++)
+        items.insert(treeWidget->topLevelItem(i)->text(1).toInt(), treeWidget->topLevelItem(i));
+
+    QSet<int> ids;
+    ids.reserve(models.count());
+    foreach (const LibraryModel& model, models)
+        ids.insert(model.getId());
+
+    int changes = 0;
+    foreach (const LibraryModel& model, models)
+    {
+        if (!items.contains(model.getId()))
+            changes++;
+    }
+    for (QHash<int, QTreeWidgetItem*>::const_iterator iterator = items.constBegin(); iterator != items.constEnd(); ++iterator)
+    {
+        if (!ids.contains(iterator.key()))
+            changes++;
+    }
 
-    QList<LibraryModel> models;
-    if (this->lineEditFilter->text().isEmpty() &&  dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter().count() == 0)
-        models = DatabaseManager::getInstance().getLibraryTemplate();
-    else
-        models = DatabaseManager::getInstance().getLibraryTemplateByFilter(this->lineEditFilter->text(), dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter());
+    treeWidget->setUpdatesEnabled(false);
 
-    if (models.count() > 0)
+    if (changes <= Library::INCREMENTAL_UPDATE_LIMIT)
     {
-        foreach (LibraryModel model, models)
+        // A few rows added or removed on the server, the other rows keep their items and selection.
+        for (QHash<int, QTreeWidgetItem*>::iterator iterator = items.begin(); iterator != items.end();)
         {
-            QTreeWidgetItem* widget = new QTreeWidgetItem(this->treeWidgetTemplate);
-            widget->setIcon(0, QIcon(":/Graphics/Images/TemplateSmall.png"));
-            widget->setText(0, model.getName());
-            widget->setText(1, QString("%1").arg(model.getId()));
-            widget->setText(2, model.getLabel());
-            widget->setText(3, model.getDeviceName());
-            widget->setText(4, model.getType());
-            widget->setText(5, QString("%1").arg(model.getThumbnailId()));
-            widget->setText(6, model.getTimecode());
+            if (ids.contains(iterator.key()))
+            {
+                ++iterator;
+                continue;
+            }
+
+            delete iterator.value();
+            iterator = items.erase(iterator);
         }
-    }
 
-    this->toolBoxLibrary->setItemText(Library::TEMPLATE_PAGE_INDEX, QString("Templates (%1)").arg(this->treeWidgetTemplate->topLevelItemCount()));
-}
+        for (int row = 0; row < models.count(); row++)
+        {
+            const LibraryModel& model = models.at(row);
 
-void LibraryWidget::dataChanged(const DataChangedEvent& event)
-{
-    Q_UNUSED(event);
+            QTreeWidgetItem* item = treeWidget->topLevelItem(row);
+            if (item != NULL && item->text(1).toInt() == model.getId())
+            {
+                setLibraryItem(item, model);
+                continue;
+            }
 
-    // TODO: Only add / remove necessary items.
-    this->treeWidgetData->clear();
-    this->treeWidgetData->clearSelection();
+            item = items.value(model.getId());
+            if (item != NULL)
+            {
+                treeWidget->takeTopLevelItem(treeWidget->indexOfTopLevelItem(item));
+            }
+            else
+            {
+                item = new QTreeWidgetItem();
+                item->setIcon(0, icon);
+            }
 
-    QList<LibraryModel> models;
-    if (this->lineEditFilter->text().isEmpty() &&  dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter().count() == 0)
-        models = DatabaseManager::getInstance().getLibraryData();
+            setLibraryItem(item, model);
+            treeWidget->insertTopLevelItem(row, item);
+        }
+    }
     else
-        models = DatabaseManager::getInstance().getLibraryDataByFilter(this->lineEditFilter->text(), dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter());
-
-    if (models.count() > 0)
     {
-        foreach (LibraryModel model, models)
+        // Too many changes to apply row by row, the items are reused but the list is handed to the view in one go.
+        QList<int> selectedIds;
+        foreach (QTreeWidgetItem* item, treeWidget->selectedItems())
+            selectedIds.push_back(item->text(1).toInt());
+
+        int scrollPosition = treeWidget->verticalScrollBar()->value();
+
+        treeWidget->invisibleRootItem()->takeChildren();
+
+        QList<QTreeWidgetItem*> newItems;
+        newItems.reserve(models.count());
+        foreach (const LibraryModel& model, models)
         {
-            QTreeWidgetItem* widget = new QTreeWidgetItem(this->treeWidgetData);
-            widget->setIcon(0, QIcon(":/Graphics/Images/DataSmall.png"));
-            widget->setText(0, model.getName());
-            widget->setText(1, QString("%1").arg(model.getId()));
-            widget->setText(2, model.getLabel());
-            widget->setText(3, model.getDeviceName());
-            widget->setText(4, model.getType());
-            widget->setText(5, QString("%1").arg(model.getThumbnailId()));
-            widget->setText(6, model.getTimecode());
+            QTreeWidgetItem* item = items.take(model.getId());
+            if (item == NULL)
+            {
+                item = new QTreeWidgetItem();
+                item->setIcon(0, icon);
+            }
+
+            setLibraryItem(item, model);
+            newItems.push_back(item);
         }
+
+        qDeleteAll(items);
+
+        treeWidget->addTopLevelItems(newItems);
+
+        foreach (QTreeWidgetItem* item, newItems)
+        {
+            if (selectedIds.contains(item->text(1).toInt()))
+                item->setSelected(true);
+        }
+
+        treeWidget->verticalScrollBar()->setValue(scrollPosition);
     }
 
-    this->toolBoxLibrary->setItemText(Library::DATA_PAGE_INDEX, QString("Stored Data (%1)").arg(this->treeWidgetData->topLevelItemCount()));
+    treeWidget->setUpdatesEnabled(true);
+}
+
+void LibraryWidget::setLibraryItem(QTreeWidgetItem* item, const LibraryModel& model)
+{
+    // Unchanged texts are ignored by the item, a row that did not change is not repainted.
+    item->setText(0, model.getName());
+    item->setText(1, QString("%1").arg(model.getId()));
+    item->setText(2, model.getLabel());
+    item->setText(3, model.getDeviceName());
+    item->setText(4, model.getType());
+    item->setText(5, QString("%1").arg(model.getThumbnailId()));
+
+    if (this->useDropFrameNotation)
+    {
+        QString timecode = model.getTimecode();
+        item->setText(6, timecode.replace(model.getTimecode().lastIndexOf(":"), 1, "."));
+    }
+    else
+        item->setText(6, model.getTimecode());
 }
 
 void LibraryWidget::presetChanged(const PresetChangedEvent& event)
@@ -889,14 +965,14 @@ void LibraryWidget::contextMenuPresetTriggered(QAction* action)
 
 void LibraryWidget::filterLibrary()
 {
+    this->filterTimer.stop();
+
     checkEmptyFilter();
 
     EventManager::getInstance().fireLibraryFilterChangedEvent(LibraryFilterChangedEvent(this->lineEditFilter->text()));
-
-    EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
-    EventManager::getInstance().fireTemplateChangedEvent(TemplateChangedEvent());
-    EventManager::getInstance().fireDataChangedEvent(DataChangedEvent());
     EventManager::getInstance().firePresetChangedEvent(PresetChangedEvent());
+
+    startFilter();
 }
 
 void LibraryWidget::checkEmptyFilter()
@@ -14,8 +14,13 @@
 #include "Events/Rundown/RepositoryRundownEvent.h"
 #include "Models/LibraryModel.h"
 
+#include "LibraryFilterWorker.h"
+
 #include <QtCore/QPoint>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
 
+#include <QtGui/QIcon>
 #include <QtGui/QKeyEvent>
 
 #include <QtGui/QAction>
@@ -28,11 +33,17 @@ class WIDGETS_EXPORT LibraryWidget : public QWidget, Ui::LibraryWidget
 
     public:
         explicit LibraryWidget(QWidget* parent = 0);
+        virtual ~LibraryWidget();
 
     private:
         bool lock = false;
         bool useDropFrameNotation = false;
 
+        QString filterState;
+        QTimer filterTimer;
+        QThread* filterThread = nullptr;
+        LibraryFilterWorker* filterWorker = nullptr;
+
         QMenu* contextMenu;
         QMenu* contextMenuImage;
         QMenu* contextMenuPreset;
@@ -42,10 +53,14 @@ class WIDGETS_EXPORT LibraryWidget : public QWidget, Ui::LibraryWidget
         void setupTools();
         void setupUiMenu();
         void checkEmptyFilter();
+        void startFilter();
+        void updateTreeWidget(QTreeWidget* treeWidget, const QList<LibraryModel>& models, const QIcon& icon);
+        void setLibraryItem(QTreeWidgetItem* item, const LibraryModel& model);
 
         Q_SLOT void loadLibrary();
         Q_SLOT void toggleExpandItem(QTreeWidgetItem*, int);
         Q_SLOT void filterLibrary();
+        Q_SLOT void libraryFiltered();
         Q_SLOT void contextMenuTriggered(QAction*);
         Q_SLOT void contextMenuImageTriggered(QAction*);
         Q_SLOT void contextMenuPresetTriggered(QAction*);
@@ -77,6 +77,8 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent)
     QObject::connect(&EventManager::getInstance(), SIGNAL(exportPresetMenu(const ExportPresetMenuEvent&)), this, SLOT(exportPresetMenu(const ExportPresetMenuEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(saveAsPresetMenu(const SaveAsPresetMenuEvent&)), this, SLOT(saveAsPresetMenu(const SaveAsPresetMenuEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(reloadRundownMenu(const ReloadRundownMenuEvent&)), this, SLOT(reloadRundownMenu(const ReloadRundownMenuEvent&)));
+    QObject::connect(&EventManager::getInstance(), SIGNAL(saveMenu(const SaveMenuEvent&)), this, SLOT(saveMenu(const SaveMenuEvent&)));
+    QObject::connect(&EventManager::getInstance(), SIGNAL(saveAsMenu(const SaveAsMenuEvent&)), this, SLOT(saveAsMenu(const SaveAsMenuEvent&)));
 }
 
 void MainWindow::setupMenu()
@@ -210,6 +212,16 @@ void MainWindow::reloadRundownMenu(const ReloadRundownMenuEvent& event)
     this->reloadRundownAction->setEnabled(event.getEnabled());
 }
 
+void MainWindow::saveMenu(const SaveMenuEvent& event)
+{
+    this->saveAction->setEnabled(event.getEnabled());
+}
+
+void MainWindow::saveAsMenu(const SaveAsMenuEvent& event)
+{
+    this->saveAsAction->setEnabled(event.getEnabled());
+}
+
 void MainWindow::emptyRundown(const EmptyRundownEvent& event)
 {
     Q_UNUSED(event);
@@ -18,6 +18,8 @@
 #include "Events/Rundown/MarkAllItemsAsUnusedEvent.h"
 #include "Events/Rundown/OpenRundownMenuEvent.h"
 #include "Events/Rundown/ReloadRundownMenuEvent.h"
+#include "Events/Rundown/SaveAsMenuEvent.h"
+#include "Events/Rundown/SaveMenuEvent.h"
 
 #include <QtCore/QEvent>
 #include <QtCore/QObject>
@@ -118,4 +120,6 @@ class WIDGETS_EXPORT MainWindow : public QMainWindow, Ui::MainWindow
         Q_SLOT void exportPresetMenu(const ExportPresetMenuEvent&);
         Q_SLOT void saveAsPresetMenu(const SaveAsPresetMenuEvent&);
         Q_SLOT void reloadRundownMenu(const ReloadRundownMenuEvent&);
+        Q_SLOT void saveMenu(const SaveMenuEvent&);
+        Q_SLOT void saveAsMenu(const SaveAsMenuEvent&);
 };
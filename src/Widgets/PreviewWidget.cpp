@@ -4,14 +4,14 @@
 
 #include "DatabaseManager.h"
 #include "EventManager.h"
+#include "ThumbnailCache.h"
 #include "Models/LibraryModel.h"
-#include "Models/ThumbnailModel.h"
 
 #include <QtWidgets/QToolButton>
 
 PreviewWidget::PreviewWidget(QWidget* parent)
     : QWidget(parent),
-      viewAlpha(false), collapsed(false)
+      viewAlpha(false), collapsed(false), model(NULL)
 {
     setupUi(this);
     setupMenus();
@@ -19,6 +19,7 @@ PreviewWidget::PreviewWidget(QWidget* parent)
     QObject::connect(&EventManager::getInstance(), SIGNAL(libraryItemSelected(const LibraryItemSelectedEvent&)), this, SLOT(libraryItemSelected(const LibraryItemSelectedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(rundownItemSelected(const RundownItemSelectedEvent&)), this, SLOT(rundownItemSelected(const RundownItemSelectedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(targetChanged(const TargetChangedEvent&)), this, SLOT(targetChanged(const TargetChangedEvent&)));
+    QObject::connect(&ThumbnailCache::getInstance(), SIGNAL(thumbnailChanged(const QString&, const QString&)), this, SLOT(thumbnailChanged(const QString&, const QString&)));
 }
 
 void PreviewWidget::setupMenus()
@@ -69,26 +70,14 @@ void PreviewWidget::setThumbnail()
         return;
     }
 
-    int thumbnailId = this->model->getThumbnailId();
     QString name = this->model->getName();
     QString deviceName = this->model->getDeviceName();
 
-    QString data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(name, deviceName).getData();
-
-    /*
-    QString data = DatabaseManager::getInstance().getThumbnailById(thumbnailId).getData();
-    if (data.isEmpty())
-        data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(name, deviceName).getData();
-    */
-
-    if (!data.isEmpty())
+    // The preview has a fixed size, both the scaled thumbnail and its alpha are decoded once and cached.
+    QPixmap pixmap = ThumbnailCache::getInstance().getPixmap(name, deviceName, this->labelPreview->maximumSize(), devicePixelRatioF(), this->viewAlpha);
+    if (!pixmap.isNull())
     {
-        this->image.loadFromData(QByteArray::fromBase64(data.toLatin1()), "PNG");
-
-        if (this->viewAlpha)
-            this->labelPreview->setPixmap(QPixmap::fromImage(this->image.convertToFormat(QImage::Format_Alpha8)));
-        else
-            this->labelPreview->setPixmap(QPixmap::fromImage(this->image));
+        this->labelPreview->setPixmap(pixmap);
     }
     else
     {
@@ -98,12 +87,19 @@ void PreviewWidget::setThumbnail()
 
 void PreviewWidget::viewAlphaChanged(bool enabled)
 {
-    if (enabled)
-        this->labelPreview->setPixmap(QPixmap::fromImage(this->image.convertToFormat(QImage::Format_Alpha8)));
-    else
-        this->labelPreview->setPixmap(QPixmap::fromImage(this->image));
-
     this->viewAlpha = enabled;
+
+    if (this->model != NULL)
+        setThumbnail();
+}
+
+void PreviewWidget::thumbnailChanged(const QString& name, const QString& deviceName)
+{
+    // This event is not for us.
+    if (this->model == NULL || name != this->model->getName() || deviceName != this->model->getDeviceName())
+        return;
+
+    setThumbnail();
 }
 
 void PreviewWidget::toggleExpandCollapse()
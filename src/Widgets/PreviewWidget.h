@@ -24,7 +24,6 @@ class WIDGETS_EXPORT PreviewWidget : public QWidget, Ui::PreviewWidget
     private:
         bool viewAlpha;
         bool collapsed;
-        QImage image;
         LibraryModel* model;
 
         QMenu* contextMenuPreviewDropdown;
@@ -37,6 +36,7 @@ class WIDGETS_EXPORT PreviewWidget : public QWidget, Ui::PreviewWidget
 
         Q_SLOT void toggleExpandCollapse();
         Q_SLOT void viewAlphaChanged(bool);
+        Q_SLOT void thumbnailChanged(const QString&, const QString&);
         Q_SLOT void targetChanged(const TargetChangedEvent&);
         Q_SLOT void libraryItemSelected(const LibraryItemSelectedEvent&);
         Q_SLOT void rundownItemSelected(const RundownItemSelectedEvent&);
@@ -298,12 +298,8 @@ void RundownAnchorWidget::executeStop()
     if (device != NULL && device->isConnected())
         device->setAnchor(this->command.getChannel(), this->command.getVideolayer(), 0, 0);
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
             deviceShadow->setAnchor(this->command.getChannel(), this->command.getVideolayer(), 0, 0);
     }
@@ -316,12 +312,8 @@ void RundownAnchorWidget::executePlay()
         device->setAnchor(this->command.getChannel(), this->command.getVideolayer(), this->command.getPositionX(),
                           this->command.getPositionY(), this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
             deviceShadow->setAnchor(this->command.getChannel(), this->command.getVideolayer(), this->command.getPositionX(),
                                     this->command.getPositionY(), this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
@@ -342,11 +334,8 @@ void RundownAnchorWidget::executePlayPreview()
                               this->command.getPositionY(), this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const DeviceModel& model, DeviceManager::getInstance().getShadowDeviceModels())
     {
-        if (model.getShadow() == "No")
-            continue;
-
         if (model.getPreviewChannel() > 0)
         {
             const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
@@ -365,12 +354,8 @@ void RundownAnchorWidget::executeClearVideolayer()
     if (device != NULL && device->isConnected())
         device->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
             deviceShadow->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
     }
@@ -387,12 +372,8 @@ void RundownAnchorWidget::executeClearChannel()
         device->clearMixerChannel(this->command.getChannel());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
             deviceShadow->clearChannel(this->command.getChannel());
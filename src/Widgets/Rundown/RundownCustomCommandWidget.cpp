@@ -318,12 +318,8 @@ void RundownCustomCommandWidget::executeStop()
     if (device != NULL && device->isConnected() && !this->command.getStopCommand().isEmpty())
         device->sendCommand(this->command.getStopCommand());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getStopCommand().isEmpty())
             deviceShadow->sendCommand(this->command.getStopCommand());
     }
@@ -335,12 +331,8 @@ void RundownCustomCommandWidget::executePlay()
     if (device != NULL && device->isConnected() && !this->command.getPlayCommand().isEmpty())
         device->sendCommand(this->command.getPlayCommand());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getPlayCommand().isEmpty())
             deviceShadow->sendCommand(this->command.getPlayCommand());
     }
@@ -355,12 +347,8 @@ void RundownCustomCommandWidget::executeLoad()
     if (device != NULL && device->isConnected() && !this->command.getLoadCommand().isEmpty())
         device->sendCommand(this->command.getLoadCommand());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getLoadCommand().isEmpty())
             deviceShadow->sendCommand(this->command.getLoadCommand());
     }
@@ -372,12 +360,8 @@ void RundownCustomCommandWidget::executePause()
     if (device != NULL && device->isConnected() && !this->command.getPauseCommand().isEmpty())
         device->sendCommand(this->command.getPauseCommand());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getPauseCommand().isEmpty())
             deviceShadow->sendCommand(this->command.getPauseCommand());
     }
@@ -389,12 +373,8 @@ void RundownCustomCommandWidget::executeNext()
     if (device != NULL && device->isConnected() && !this->command.getNextCommand().isEmpty())
         device->sendCommand(this->command.getNextCommand());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getNextCommand().isEmpty())
             deviceShadow->sendCommand(this->command.getNextCommand());
     }
@@ -406,12 +386,8 @@ void RundownCustomCommandWidget::executeUpdate()
     if (device != NULL && device->isConnected() && !this->command.getUpdateCommand().isEmpty())
         device->sendCommand(this->command.getUpdateCommand());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getUpdateCommand().isEmpty())
             deviceShadow->sendCommand(this->command.getUpdateCommand());
     }
@@ -423,12 +399,8 @@ void RundownCustomCommandWidget::executeInvoke()
     if (device != NULL && device->isConnected() && !this->command.getInvokeCommand().isEmpty())
         device->sendCommand(this->command.getInvokeCommand());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getInvokeCommand().isEmpty())
             deviceShadow->sendCommand(this->command.getInvokeCommand());
     }
@@ -440,12 +412,8 @@ void RundownCustomCommandWidget::executePreview()
     if (device != NULL && device->isConnected() && !this->command.getPreviewCommand().isEmpty())
         device->sendCommand(this->command.getPreviewCommand());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getPreviewCommand().isEmpty())
             deviceShadow->sendCommand(this->command.getPreviewCommand());
     }
@@ -459,12 +427,8 @@ void RundownCustomCommandWidget::executeClear()
     if (device != NULL && device->isConnected() && !this->command.getClearCommand().isEmpty())
         device->sendCommand(this->command.getClearCommand());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getClearCommand().isEmpty())
             deviceShadow->sendCommand(this->command.getClearCommand());
     }
@@ -478,12 +442,8 @@ void RundownCustomCommandWidget::executeClearVideolayer()
     if (device != NULL && device->isConnected() && !this->command.getClearVideolayerCommand().isEmpty())
         device->sendCommand(this->command.getClearVideolayerCommand());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getClearVideolayerCommand().isEmpty())
             deviceShadow->sendCommand(this->command.getClearVideolayerCommand());
     }
@@ -497,12 +457,8 @@ void RundownCustomCommandWidget::executeClearChannel()
     if (device != NULL && device->isConnected() && !this->command.getClearChannelCommand().isEmpty())
         device->sendCommand(this->command.getClearChannelCommand());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getClearChannelCommand().isEmpty())
             deviceShadow->sendCommand(this->command.getClearChannelCommand());
     }
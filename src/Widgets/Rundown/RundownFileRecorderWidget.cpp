@@ -6,6 +6,7 @@
 #include "DeviceManager.h"
 #include "GpiManager.h"
 #include "EventManager.h"
+#include "HostResolver.h"
 #include "Events/ConnectionStateChangedEvent.h"
 #include "Utils/ItemScheduler.h"
 
@@ -50,6 +51,7 @@ RundownFileRecorderWidget::RundownFileRecorderWidget(const LibraryModel& model,
     QObject::connect(&this->command, SIGNAL(outputChanged(const QString&)), this, SLOT(outputChanged(const QString&)));
     QObject::connect(&this->command, SIGNAL(remoteTriggerIdChanged(const QString&)), this, SLOT(remoteTriggerIdChanged(const QString&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(deviceChanged(const DeviceChangedEvent&)), this, SLOT(deviceChanged(const DeviceChangedEvent&)));
+    QObject::connect(&HostResolver::getInstance(), SIGNAL(hostResolved(const QString&, const QString&)), this, SLOT(hostResolved(const QString&, const QString&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(targetChanged(const TargetChangedEvent&)), this, SLOT(targetChanged(const TargetChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(labelChanged(const LabelChangedEvent&)), this, SLOT(labelChanged(const LabelChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(channelChanged(const ChannelChangedEvent&)), this, SLOT(channelChanged(const ChannelChangedEvent&)));
@@ -131,6 +133,17 @@ void RundownFileRecorderWidget::deviceChanged(const DeviceChangedEvent& event)
     configureOscSubscriptions();
 }
 
+void RundownFileRecorderWidget::hostResolved(const QString& hostName, const QString& address)
+{
+    Q_UNUSED(address);
+
+    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
+    if (device == NULL || device->getAddress() != hostName)
+        return;
+
+    configureOscSubscriptions();
+}
+
 AbstractRundownWidget* RundownFileRecorderWidget::clone()
 {
     RundownFileRecorderWidget* widget = new RundownFileRecorderWidget(this->model, this->parentWidget(), this->color,
@@ -308,12 +321,8 @@ void RundownFileRecorderWidget::executeStop()
     if (device != NULL && device->isConnected())
         device->stopFileRecorder(this->command.getChannel(), this->command.getOutput());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
             deviceShadow->stopFileRecorder(this->command.getChannel(), this->command.getOutput());
     }
@@ -327,12 +336,8 @@ void RundownFileRecorderWidget::executePlay()
     if (device != NULL && device->isConnected())
         device->startFileRecorder(this->command.getChannel(), this->command.getOutput(), this->command.getPreset(), this->command.getWithAlpha());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
             deviceShadow->startFileRecorder(this->command.getChannel(), this->command.getOutput(), this->command.getPreset(), this->command.getWithAlpha());
     }
@@ -111,5 +111,6 @@ class WIDGETS_EXPORT RundownFileRecorderWidget : public QWidget, Ui::RundownFile
         Q_SLOT void labelChanged(const LabelChangedEvent&);
         Q_SLOT void targetChanged(const TargetChangedEvent&);
         Q_SLOT void deviceChanged(const DeviceChangedEvent&);
+        Q_SLOT void hostResolved(const QString&, const QString&);
         Q_SLOT void channelChanged(const ChannelChangedEvent&);
 };
@@ -6,12 +6,17 @@
 #include "DeviceManager.h"
 #include "GpiManager.h"
 #include "EventManager.h"
+#include "ThumbnailCache.h"
 #include "Events/ConnectionStateChangedEvent.h"
 #include "Utils/ItemScheduler.h"
 
 #include <QtCore/QObject>
+#include <QtCore/QSize>
+
+#include <QtGui/QHelpEvent>
 
 #include <QtWidgets/QGraphicsOpacityEffect>
+#include <QtWidgets/QToolTip>
 
 RundownImageScrollerWidget::RundownImageScrollerWidget(const LibraryModel& model, QWidget* parent, const QString& color,
                                                        bool active, bool loaded, bool paused, bool playing, bool inGroup,
@@ -24,6 +29,8 @@ RundownImageScrollerWidget::RundownImageScrollerWidget(const LibraryModel& model
 {
     setupUi(this);
 
+    this->labelThumbnail->installEventFilter(this);
+
     this->animation = new ActiveAnimation(this->labelActiveColor);
 
     this->delayType = DatabaseManager::getInstance().getConfigurationByName("DelayType").getValue();
@@ -202,21 +209,42 @@ void RundownImageScrollerWidget::setThumbnail()
         return;
     }
 
-    QString data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
+    // Decoded and scaled once for every item using the clip, the compact view scales it further down.
+    QPixmap pixmap = ThumbnailCache::getInstance().getPixmap(this->model.getName(), this->model.getDeviceName(),
+                                                             QSize(Rundown::DEFAULT_THUMBNAIL_WIDTH, Rundown::DEFAULT_THUMBNAIL_HEIGHT), devicePixelRatioF());
+    this->labelThumbnail->setPixmap(pixmap);
+
+    // The thumbnail is decoded or retrieved in the background, it is set again once it is ready.
+    if (pixmap.isNull())
+        QObject::connect(&ThumbnailCache::getInstance(), SIGNAL(thumbnailChanged(const QString&, const QString&)), this, SLOT(thumbnailChanged(const QString&, const QString&)), Qt::UniqueConnection);
+    else
+        QObject::disconnect(&ThumbnailCache::getInstance(), SIGNAL(thumbnailChanged(const QString&, const QString&)), this, SLOT(thumbnailChanged(const QString&, const QString&)));
+
+    // The tooltip is built when it is shown instead of keeping the image as text on every item.
+    this->showThumbnailTooltip = (DatabaseManager::getInstance().getConfigurationByName("ShowThumbnailTooltip").getValue() == "true") ? true : false;
+}
+
+void RundownImageScrollerWidget::thumbnailChanged(const QString& name, const QString& deviceName)
+{
+    // This event is not for us.
+    if (name != this->model.getName() || deviceName != this->model.getDeviceName())
+        return;
+
+    setThumbnail();
+}
 
-    /*
-    QString data = DatabaseManager::getInstance().getThumbnailById(this->model.getThumbnailId()).getData();
-    if (data.isEmpty())
-        data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
-    */
+bool RundownImageScrollerWidget::eventFilter(QObject* target, QEvent* event)
+{
+    if (target == this->labelThumbnail && event->type() == QEvent::ToolTip)
+    {
+        if (this->showThumbnailTooltip)
+            QToolTip::showText(static_cast<QHelpEvent*>(event)->globalPos(),
+                               ThumbnailCache::getInstance().getToolTip(this->model.getName(), this->model.getDeviceName()), this->labelThumbnail);
 
-    QImage image;
-    image.loadFromData(QByteArray::fromBase64(data.toLatin1()), "PNG");
-    this->labelThumbnail->setPixmap(QPixmap::fromImage(image));
+        return true;
+    }
 
-    bool displayThumbnailTooltip = (DatabaseManager::getInstance().getConfigurationByName("ShowThumbnailTooltip").getValue() == "true") ? true : false;
-    if (displayThumbnailTooltip)
-        this->labelThumbnail->setToolTip(QString("<img src=\"data:image/png;base64,%1 \"/>").arg(data));
+    return QWidget::eventFilter(target, event);
 }
 
 void RundownImageScrollerWidget::setSelected(bool selected)
@@ -342,12 +370,8 @@ void RundownImageScrollerWidget::executeStop()
     if (device != NULL && device->isConnected())
         device->stop(this->command.getChannel(), this->command.getVideolayer());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
             deviceShadow->stop(this->command.getChannel(), this->command.getVideolayer());
     }
@@ -370,12 +394,8 @@ void RundownImageScrollerWidget::executePlay()
                                     this->command.getProgressive());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
             if (this->loaded)
@@ -409,12 +429,8 @@ void RundownImageScrollerWidget::executePause()
             device->pause(this->command.getChannel(), this->command.getVideolayer());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
             if (this->paused)
@@ -437,12 +453,8 @@ void RundownImageScrollerWidget::executeLoad()
                                 this->command.getProgressive());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
             deviceShadow->loadImageScroll(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageScrollerName(),
@@ -464,12 +476,8 @@ void RundownImageScrollerWidget::executeClearVideolayer()
     if (device != NULL && device->isConnected())
         device->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
             deviceShadow->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
     }
@@ -490,12 +498,8 @@ void RundownImageScrollerWidget::executeClearChannel()
         device->clearMixerChannel(this->command.getChannel());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
             deviceShadow->clearChannel(this->command.getChannel());
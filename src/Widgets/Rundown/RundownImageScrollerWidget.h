@@ -56,6 +56,9 @@ class WIDGETS_EXPORT RundownImageScrollerWidget : public QWidget, Ui::RundownIma
         virtual void setUsed(bool used);
         virtual void setSelected(bool selected);
 
+    protected:
+        virtual bool eventFilter(QObject* target, QEvent* event);
+
     private:
         bool active;
         bool loaded;
@@ -70,6 +73,7 @@ class WIDGETS_EXPORT RundownImageScrollerWidget : public QWidget, Ui::RundownIma
         QString delayType;
         bool markUsedItems;
         bool selected = false;
+        bool showThumbnailTooltip = false;
 
         OscSubscription* stopControlSubscription;
         OscSubscription* playControlSubscription;
@@ -88,6 +92,7 @@ class WIDGETS_EXPORT RundownImageScrollerWidget : public QWidget, Ui::RundownIma
         void checkDeviceConnection();
         void configureOscSubscriptions();
 
+        Q_SLOT void thumbnailChanged(const QString&, const QString&);
         Q_SLOT void executeClearVideolayer();
         Q_SLOT void executeClearChannel();
         Q_SLOT void channelChanged(int);
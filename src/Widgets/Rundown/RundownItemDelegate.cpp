@@ -0,0 +1,82 @@
+#include "RundownItemDelegate.h"
+#include "RundownTreeBaseWidget.h"
+
+#include "Global.h"
+
+#include <QtCore/QRect>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QRegularExpressionMatch>
+
+#include <QtGui/QFontMetrics>
+
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QStyle>
+
+RundownItemDelegate::RundownItemDelegate(RundownTreeBaseWidget* parent)
+    : QStyledItemDelegate(parent), treeWidget(parent)
+{
+}
+
+void RundownItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    QStyleOptionViewItem itemOption(option);
+    initStyleOption(&itemOption, index);
+
+    QStyle* style = (option.widget != NULL) ? option.widget->style() : QApplication::style();
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem, &itemOption, painter, option.widget);
+
+    // A row with an item widget is covered by it, only rows without one are painted from their record.
+    if (this->treeWidget->indexWidget(index) != NULL)
+        return;
+
+    painter->save();
+
+    QColor color = parseColor(index.data(Rundown::COLOR_ROLE).toString());
+    if (color.isValid() && color.alpha() > 0)
+        painter->fillRect(option.rect, color);
+
+    if (index.data(Rundown::USED_ROLE).toBool())
+        painter->setOpacity(0.25);
+
+    int iconWidth = this->treeWidget->getCompactView() ? Rundown::COMPACT_ICON_WIDTH : Rundown::DEFAULT_ICON_WIDTH;
+    QRect rect = option.rect.adjusted(iconWidth + 2 * Rundown::ITEM_MARGIN, 0, -Rundown::ITEM_MARGIN, 0);
+
+    QString label = index.data(Rundown::LABEL_ROLE).toString();
+    QString details = index.data(Rundown::NAME_ROLE).toString();
+    QString deviceName = index.data(Rundown::DEVICENAME_ROLE).toString();
+    if (!deviceName.isEmpty())
+        details = details.isEmpty() ? deviceName : QString("%1 (%2)").arg(details).arg(deviceName);
+
+    QFontMetrics metrics(option.font);
+    int detailsWidth = qMin(metrics.horizontalAdvance(details), rect.width() / 2);
+
+    painter->setFont(option.font);
+    painter->setPen(option.palette.color((option.state & QStyle::State_Selected) ? QPalette::HighlightedText : QPalette::Text));
+    painter->drawText(rect.adjusted(0, 0, -(detailsWidth + Rundown::ITEM_MARGIN), 0), Qt::AlignLeft | Qt::AlignVCenter,
+                      metrics.elidedText(label, Qt::ElideRight, rect.width() - detailsWidth - Rundown::ITEM_MARGIN));
+
+    painter->setPen(option.palette.color(QPalette::Disabled, QPalette::Text));
+    painter->drawText(rect, Qt::AlignRight | Qt::AlignVCenter, metrics.elidedText(details, Qt::ElideLeft, detailsWidth));
+
+    painter->restore();
+}
+
+QSize RundownItemDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+
+    // Rows without a widget get the height of the current view mode, rows with one are sized to fit it by the view.
+    return QSize(option.rect.width(), this->treeWidget->getCompactView() ? Rundown::COMPACT_ITEM_HEIGHT : Rundown::DEFAULT_ITEM_HEIGHT);
+}
+
+QColor RundownItemDelegate::parseColor(const QString& color) const
+{
+    // Item colors are stored as style sheet values, either a color name or rgba(r, g, b, a).
+    static const QRegularExpression expression("^rgba\\((\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)\\)$");
+
+    QRegularExpressionMatch match = expression.match(color.trimmed());
+    if (match.hasMatch())
+        return QColor(match.captured(1).toInt(), match.captured(2).toInt(), match.captured(3).toInt(), match.captured(4).toInt());
+
+    return QColor(color);
+}
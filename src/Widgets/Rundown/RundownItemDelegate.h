@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../Shared.h"
+
+#include <QtCore/QModelIndex>
+#include <QtCore/QSize>
+#include <QtCore/QString>
+
+#include <QtGui/QColor>
+#include <QtGui/QPainter>
+
+#include <QtWidgets/QStyledItemDelegate>
+#include <QtWidgets/QStyleOptionViewItem>
+
+class RundownTreeBaseWidget;
+
+class WIDGETS_EXPORT RundownItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+    public:
+        explicit RundownItemDelegate(RundownTreeBaseWidget* parent);
+
+        void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const;
+        QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const;
+
+    private:
+        RundownTreeBaseWidget* treeWidget;
+
+        QColor parseColor(const QString& color) const;
+};
@@ -6,16 +6,21 @@
 #include "DeviceManager.h"
 #include "GpiManager.h"
 #include "EventManager.h"
+#include "HostResolver.h"
+#include "ThumbnailCache.h"
 #include "Events/ConnectionStateChangedEvent.h"
 #include "Events/Rundown/AutoPlayRundownItemEvent.h"
 #include "Utils/ItemScheduler.h"
 
 #include <QtCore/QObject>
+#include <QtCore/QSize>
 #include <QtCore/QFileInfo>
 
+#include <QtGui/QHelpEvent>
 #include <QtGui/QPixmap>
 
 #include <QtWidgets/QGraphicsOpacityEffect>
+#include <QtWidgets/QToolTip>
 
 RundownMovieWidget::RundownMovieWidget(const LibraryModel& model, QWidget* parent, const QString& color, bool active,
                                        bool loaded, bool paused, bool playing, bool inGroup, bool compactView)
@@ -28,6 +33,8 @@ RundownMovieWidget::RundownMovieWidget(const LibraryModel& model, QWidget* paren
 {
     setupUi(this);
 
+    this->labelThumbnail->installEventFilter(this);
+
     this->animation = new ActiveAnimation(this->labelActiveColor);
 
     this->delayType = DatabaseManager::getInstance().getConfigurationByName("DelayType").getValue();
@@ -66,6 +73,7 @@ RundownMovieWidget::RundownMovieWidget(const LibraryModel& model, QWidget* paren
     QObject::connect(&this->command, SIGNAL(autoPlayChanged(bool)), this, SLOT(autoPlayChanged(bool)));
     QObject::connect(&this->command, SIGNAL(remoteTriggerIdChanged(const QString&)), this, SLOT(remoteTriggerIdChanged(const QString&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(deviceChanged(const DeviceChangedEvent&)), this, SLOT(deviceChanged(const DeviceChangedEvent&)));
+    QObject::connect(&HostResolver::getInstance(), SIGNAL(hostResolved(const QString&, const QString&)), this, SLOT(hostResolved(const QString&, const QString&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(targetChanged(const TargetChangedEvent&)), this, SLOT(targetChanged(const TargetChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(labelChanged(const LabelChangedEvent&)), this, SLOT(labelChanged(const LabelChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(videolayerChanged(const VideolayerChangedEvent&)), this, SLOT(videolayerChanged(const VideolayerChangedEvent&)));
@@ -162,6 +170,18 @@ void RundownMovieWidget::deviceChanged(const DeviceChangedEvent& event)
     configureOscSubscriptions();
 }
 
+void RundownMovieWidget::hostResolved(const QString& hostName, const QString& address)
+{
+    Q_UNUSED(address);
+
+    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
+    if (device == NULL || device->getAddress() != hostName)
+        return;
+
+    // The OSC filters match on the address, not on the host name.
+    configureOscSubscriptions();
+}
+
 AbstractRundownWidget* RundownMovieWidget::clone()
 {
     RundownMovieWidget* widget = new RundownMovieWidget(this->model, this->parentWidget(), this->color, this->active,
@@ -256,21 +276,42 @@ void RundownMovieWidget::setThumbnail()
         return;
     }
 
-    QString data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
+    // Decoded and scaled once for every item using the clip, the compact view scales it further down.
+    QPixmap pixmap = ThumbnailCache::getInstance().getPixmap(this->model.getName(), this->model.getDeviceName(),
+                                                             QSize(Rundown::DEFAULT_THUMBNAIL_WIDTH, Rundown::DEFAULT_THUMBNAIL_HEIGHT), devicePixelRatioF());
+    this->labelThumbnail->setPixmap(pixmap);
 
-    /*
-    QString data = DatabaseManager::getInstance().getThumbnailById(this->model.getThumbnailId()).getData();
-    if (data.isEmpty())
-        data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
-    */
+    // The thumbnail is decoded or retrieved in the background, it is set again once it is ready.
+    if (pixmap.isNull())
+        QObject::connect(&ThumbnailCache::getInstance(), SIGNAL(thumbnailChanged(const QString&, const QString&)), this, SLOT(thumbnailChanged(const QString&, const QString&)), Qt::UniqueConnection);
+    else
+        QObject::disconnect(&ThumbnailCache::getInstance(), SIGNAL(thumbnailChanged(const QString&, const QString&)), this, SLOT(thumbnailChanged(const QString&, const QString&)));
+
+    // The tooltip is built when it is shown instead of keeping the image as text on every item.
+    this->showThumbnailTooltip = (DatabaseManager::getInstance().getConfigurationByName("ShowThumbnailTooltip").getValue() == "true") ? true : false;
+}
 
-    QImage image;
-    image.loadFromData(QByteArray::fromBase64(data.toLatin1()), "PNG");
-    this->labelThumbnail->setPixmap(QPixmap::fromImage(image));
+void RundownMovieWidget::thumbnailChanged(const QString& name, const QString& deviceName)
+{
+    // This event is not for us.
+    if (name != this->model.getName() || deviceName != this->model.getDeviceName())
+        return;
 
-    bool displayThumbnailTooltip = (DatabaseManager::getInstance().getConfigurationByName("ShowThumbnailTooltip").getValue() == "true") ? true : false;
-    if (displayThumbnailTooltip)
-        this->labelThumbnail->setToolTip(QString("<img src=\"data:image/png;base64,%1 \"/>").arg(data));
+    setThumbnail();
+}
+
+bool RundownMovieWidget::eventFilter(QObject* target, QEvent* event)
+{
+    if (target == this->labelThumbnail && event->type() == QEvent::ToolTip)
+    {
+        if (this->showThumbnailTooltip)
+            QToolTip::showText(static_cast<QHelpEvent*>(event)->globalPos(),
+                               ThumbnailCache::getInstance().getToolTip(this->model.getName(), this->model.getDeviceName()), this->labelThumbnail);
+
+        return true;
+    }
+
+    return QWidget::eventFilter(target, event);
 }
 
 void RundownMovieWidget::setSelected(bool selected)
@@ -436,11 +477,8 @@ void RundownMovieWidget::executeStop()
             device->stop(deviceModel->getPreviewChannel(), this->command.getVideolayer());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const DeviceModel& model, DeviceManager::getInstance().getShadowDeviceModels())
     {
-        if (model.getShadow() == "No")
-            continue;
-
         const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
@@ -493,12 +531,8 @@ void RundownMovieWidget::executePlay()
         }
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
             if (this->loaded)
@@ -551,12 +585,8 @@ void RundownMovieWidget::executePause()
             device->pause(this->command.getChannel(), this->command.getVideolayer());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
             if (this->paused)
@@ -582,12 +612,8 @@ void RundownMovieWidget::executeLoad()
                           this->command.getLoop(), this->command.getFreezeOnLoad(), false);
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
             deviceShadow->loadMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
@@ -618,11 +644,8 @@ void RundownMovieWidget::executeLoadPreview()
         }
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const DeviceModel& model, DeviceManager::getInstance().getShadowDeviceModels())
     {
-        if (model.getShadow() == "No")
-            continue;
-
         if (model.getPreviewChannel() > 0)
         {
             const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
@@ -651,12 +674,8 @@ void RundownMovieWidget::executeNext()
 
         }
 
-        foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+        foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
         {
-            if (model.getShadow() == "No")
-                continue;
-
-            const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
             if (deviceShadow != NULL && deviceShadow->isConnected())
             {
                 deviceShadow->playMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
@@ -690,11 +709,8 @@ void RundownMovieWidget::executeClearVideolayer()
             device->clearVideolayer(deviceModel->getPreviewChannel(), this->command.getVideolayer());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const DeviceModel& model, DeviceManager::getInstance().getShadowDeviceModels())
     {
-        if (model.getShadow() == "No")
-            continue;
-
         const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
@@ -738,11 +754,8 @@ void RundownMovieWidget::executeClearChannel()
         }
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const DeviceModel& model, DeviceManager::getInstance().getShadowDeviceModels())
     {
-        if (model.getShadow() == "No")
-            continue;
-
         const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
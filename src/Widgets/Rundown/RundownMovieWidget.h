@@ -59,6 +59,9 @@ class WIDGETS_EXPORT RundownMovieWidget : public QWidget, Ui::RundownMovieWidget
         virtual void setUsed(bool used);
         virtual void setSelected(bool selected);
 
+    protected:
+        virtual bool eventFilter(QObject* target, QEvent* event);
+
     private:
         bool active;
         bool loaded;
@@ -77,6 +80,7 @@ class WIDGETS_EXPORT RundownMovieWidget : public QWidget, Ui::RundownMovieWidget
         bool markUsedItems;
         bool useFreezeOnLoad;
         bool selected = false;
+        bool showThumbnailTooltip = false;
 
         OscFileModel fileModel;
         OscSubscription* timeSubscription;
@@ -108,6 +112,7 @@ class WIDGETS_EXPORT RundownMovieWidget : public QWidget, Ui::RundownMovieWidget
         void configureOscSubscriptions();
         void setTimecode(const QString& timecode);
 
+        Q_SLOT void thumbnailChanged(const QString&, const QString&);
         Q_SLOT void channelChanged(int);
         Q_SLOT void executeClearVideolayer();
         Q_SLOT void executeClearChannel();
@@ -148,4 +153,5 @@ class WIDGETS_EXPORT RundownMovieWidget : public QWidget, Ui::RundownMovieWidget
         Q_SLOT void labelChanged(const LabelChangedEvent&);
         Q_SLOT void targetChanged(const TargetChangedEvent&);
         Q_SLOT void deviceChanged(const DeviceChangedEvent&);
+        Q_SLOT void hostResolved(const QString&, const QString&);
 };
@@ -277,12 +277,8 @@ void RundownPrintWidget::executePlay()
     if (device != NULL && device->isConnected())
         device->print(this->command.getChannel(), this->command.getOutput());
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
             deviceShadow->print(this->command.getChannel(), this->command.getOutput());
     }
@@ -6,12 +6,17 @@
 #include "DeviceManager.h"
 #include "GpiManager.h"
 #include "EventManager.h"
+#include "ThumbnailCache.h"
 #include "Events/ConnectionStateChangedEvent.h"
 #include "Utils/ItemScheduler.h"
 
 #include <QtCore/QObject>
+#include <QtCore/QSize>
+
+#include <QtGui/QHelpEvent>
 
 #include <QtWidgets/QGraphicsOpacityEffect>
+#include <QtWidgets/QToolTip>
 
 RundownStillWidget::RundownStillWidget(const LibraryModel& model, QWidget* parent, const QString& color,
                                        bool active, bool loaded, bool paused, bool playing, bool inGroup,
@@ -24,6 +29,8 @@ RundownStillWidget::RundownStillWidget(const LibraryModel& model, QWidget* paren
 {
     setupUi(this);
 
+    this->labelThumbnail->installEventFilter(this);
+
     this->animation = new ActiveAnimation(this->labelActiveColor);
 
     this->delayType = DatabaseManager::getInstance().getConfigurationByName("DelayType").getValue();
@@ -197,21 +204,42 @@ LibraryModel* RundownStillWidget::getLibraryModel()
 
 void RundownStillWidget::setThumbnail()
 {
-    QString data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
+    // Decoded and scaled once for every item using the clip, the compact view scales it further down.
+    QPixmap pixmap = ThumbnailCache::getInstance().getPixmap(this->model.getName(), this->model.getDeviceName(),
+                                                             QSize(Rundown::DEFAULT_THUMBNAIL_WIDTH, Rundown::DEFAULT_THUMBNAIL_HEIGHT), devicePixelRatioF());
+    this->labelThumbnail->setPixmap(pixmap);
+
+    // The thumbnail is decoded or retrieved in the background, it is set again once it is ready.
+    if (pixmap.isNull())
+        QObject::connect(&ThumbnailCache::getInstance(), SIGNAL(thumbnailChanged(const QString&, const QString&)), this, SLOT(thumbnailChanged(const QString&, const QString&)), Qt::UniqueConnection);
+    else
+        QObject::disconnect(&ThumbnailCache::getInstance(), SIGNAL(thumbnailChanged(const QString&, const QString&)), this, SLOT(thumbnailChanged(const QString&, const QString&)));
+
+    // The tooltip is built when it is shown instead of keeping the image as text on every item.
+    this->showThumbnailTooltip = (DatabaseManager::getInstance().getConfigurationByName("ShowThumbnailTooltip").getValue() == "true") ? true : false;
+}
+
+void RundownStillWidget::thumbnailChanged(const QString& name, const QString& deviceName)
+{
+    // This event is not for us.
+    if (name != this->model.getName() || deviceName != this->model.getDeviceName())
+        return;
+
+    setThumbnail();
+}
 
-    /*
-    QString data = DatabaseManager::getInstance().getThumbnailById(this->model.getThumbnailId()).getData();
-    if (data.isEmpty())
-        data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
-    */
+bool RundownStillWidget::eventFilter(QObject* target, QEvent* event)
+{
+    if (target == this->labelThumbnail && event->type() == QEvent::ToolTip)
+    {
+        if (this->showThumbnailTooltip)
+            QToolTip::showText(static_cast<QHelpEvent*>(event)->globalPos(),
+                               ThumbnailCache::getInstance().getToolTip(this->model.getName(), this->model.getDeviceName()), this->labelThumbnail);
 
-    QImage image;
-    image.loadFromData(QByteArray::fromBase64(data.toLatin1()), "PNG");
-    this->labelThumbnail->setPixmap(QPixmap::fromImage(image));
+        return true;
+    }
 
-    bool displayThumbnailTooltip = (DatabaseManager::getInstance().getConfigurationByName("ShowThumbnailTooltip").getValue() == "true") ? true : false;
-    if (displayThumbnailTooltip)
-        this->labelThumbnail->setToolTip(QString("<img src=\"data:image/png;base64,%1 \"/>").arg(data));
+    return QWidget::eventFilter(target, event);
 }
 
 void RundownStillWidget::setSelected(bool selected)
@@ -348,11 +376,8 @@ void RundownStillWidget::executeStop()
             device->stop(deviceModel->getPreviewChannel(), this->command.getVideolayer());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const DeviceModel& model, DeviceManager::getInstance().getShadowDeviceModels())
     {
-        if (model.getShadow() == "No")
-            continue;
-
         const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
@@ -382,12 +407,8 @@ void RundownStillWidget::executePlay()
                               this->command.getDirection(), this->command.getUseAuto());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
             if (this->loaded)
@@ -421,11 +442,8 @@ void RundownStillWidget::executePlayPreview()
         }
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const DeviceModel& model, DeviceManager::getInstance().getShadowDeviceModels())
     {
-        if (model.getShadow() == "No")
-            continue;
-
         if (model.getPreviewChannel() > 0)
         {
             const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
@@ -453,12 +471,8 @@ void RundownStillWidget::executePause()
             device->pause(this->command.getChannel(), this->command.getVideolayer());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
             if (this->paused)
@@ -481,12 +495,8 @@ void RundownStillWidget::executeLoad()
                           this->command.getDirection(), this->command.getUseAuto());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const QSharedPointer<CasparDevice>& deviceShadow, DeviceManager::getInstance().getShadowDevices())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
             deviceShadow->loadStill(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageName(),
@@ -515,11 +525,8 @@ void RundownStillWidget::executeClearVideolayer()
             device->clearVideolayer(deviceModel->getPreviewChannel(), this->command.getVideolayer());
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const DeviceModel& model, DeviceManager::getInstance().getShadowDeviceModels())
     {
-        if (model.getShadow() == "No")
-            continue;
-
         const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
@@ -555,11 +562,8 @@ void RundownStillWidget::executeClearChannel()
         }
     }
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    foreach (const DeviceModel& model, DeviceManager::getInstance().getShadowDeviceModels())
     {
-        if (model.getShadow() == "No")
-            continue;
-
         const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
         if (deviceShadow != NULL && deviceShadow->isConnected())
         {
@@ -1,9 +1,11 @@
 #include "RundownTreeBaseWidget.h"
 #include "RundownItemFactory.h"
 #include "RundownGroupWidget.h"
+#include "RundownItemDelegate.h"
 
 #include "DatabaseManager.h"
 #include "EventManager.h"
+#include "RundownReader.h"
 #include "Commands/MovieCommand.h"
 #include "Events/Rundown/AllowRemoteTriggeringEvent.h"
 #include "Events/Rundown/RepositoryRundownEvent.h"
@@ -12,6 +14,7 @@
 #include "Models/LibraryModel.h"
 
 #include <iostream>
+#include <sstream>
 
 #include <QtCore/QDebug>
 
@@ -20,12 +23,22 @@
 #include <QtGui/QClipboard>
 
 #include <QtWidgets/QApplication>
+#include <QtWidgets/QScrollBar>
 
 RundownTreeBaseWidget::RundownTreeBaseWidget(QWidget* parent)
     : QTreeWidget(parent), compactView(false), theme(""), lock(false)
 {
     this->theme = DatabaseManager::getInstance().getConfigurationByName("Theme").getValue();
 
+    QTreeWidget::setItemDelegate(new RundownItemDelegate(this));
+
+    this->createTimer.setSingleShot(true);
+    this->createTimer.setInterval(0);
+
+    QObject::connect(&this->createTimer, SIGNAL(timeout()), this, SLOT(createVisibleItems()));
+    QObject::connect(QTreeWidget::verticalScrollBar(), SIGNAL(valueChanged(int)), &this->createTimer, SLOT(start()));
+    QObject::connect(this, SIGNAL(itemExpanded(QTreeWidgetItem*)), &this->createTimer, SLOT(start()));
+    QObject::connect(this, SIGNAL(itemCollapsed(QTreeWidgetItem*)), &this->createTimer, SLOT(start()));
     QObject::connect(&EventManager::getInstance(), SIGNAL(repositoryRundown(const RepositoryRundownEvent&)), this, SLOT(repositoryRundown(const RepositoryRundownEvent&)));
 }
 
@@ -39,8 +52,224 @@ void RundownTreeBaseWidget::setCompactView(bool compactView)
     this->compactView = compactView;
 }
 
+void RundownTreeBaseWidget::attachItemWidget(QTreeWidgetItem* item, AbstractRundownWidget* widget)
+{
+    // Keep a copy of what the delegate needs on the item itself, the row can then be painted without its widget.
+    item->setData(0, Rundown::TYPE_ROLE, widget->getLibraryModel()->getType());
+    item->setData(0, Rundown::LABEL_ROLE, widget->getLibraryModel()->getLabel());
+    item->setData(0, Rundown::DEVICENAME_ROLE, widget->getLibraryModel()->getDeviceName());
+    item->setData(0, Rundown::NAME_ROLE, widget->getLibraryModel()->getName());
+    item->setData(0, Rundown::COLOR_ROLE, widget->getColor());
+
+    QTreeWidget::setItemWidget(item, 0, dynamic_cast<QWidget*>(widget));
+}
+
+QWidget* RundownTreeBaseWidget::getItemWidget(QTreeWidgetItem* item)
+{
+    if (item == NULL)
+        return NULL;
+
+    QWidget* widget = QTreeWidget::itemWidget(item, 0);
+    if (widget != NULL || !isLazyItem(item))
+        return widget;
+
+    // The item has only been a record so far, build the widget now that something needs it.
+    boost::property_tree::wptree pt = item->data(0, Rundown::RECORD_ROLE).value<boost::property_tree::wptree>();
+    item->setData(0, Rundown::RECORD_ROLE, QVariant());
+
+    AbstractRundownWidget* rundownWidget = readProperties(pt);
+    rundownWidget->setInGroup(item->parent() != NULL);
+    rundownWidget->setExpanded(rundownWidget->isGroup() && item->isExpanded());
+
+    if (item->data(0, Rundown::USED_ROLE).toBool())
+        rundownWidget->setUsed(true);
+
+    attachItemWidget(item, rundownWidget);
+
+    this->createdItems.append(QPersistentModelIndex(QTreeWidget::indexFromItem(item)));
+
+    return dynamic_cast<QWidget*>(rundownWidget);
+}
+
+bool RundownTreeBaseWidget::isItemGroup(QTreeWidgetItem* item) const
+{
+    return item->data(0, Rundown::TYPE_ROLE).toString() == "GROUP";
+}
+
+QString RundownTreeBaseWidget::getStoryId(QTreeWidgetItem* item) const
+{
+    if (isLazyItem(item))
+        return QString::fromStdWString(item->data(0, Rundown::RECORD_ROLE).value<boost::property_tree::wptree>().get(L"storyid", L""));
+
+    return dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0))->getCommand()->getStoryId();
+}
+
+void RundownTreeBaseWidget::setUsed(QTreeWidgetItem* item, bool used)
+{
+    // Kept on the item as well, a widget that is released off screen gets it back when it is created again.
+    item->setData(0, Rundown::USED_ROLE, used);
+
+    AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0));
+    if (widget != NULL)
+        widget->setUsed(used);
+}
+
+void RundownTreeBaseWidget::setExecuted(QTreeWidgetItem* item)
+{
+    // Executed widgets may still be playing, hold delayed commands or sit in an auto play queue, they are never released.
+    // A group executes its children and a child is executed as part of its group, the whole group is kept.
+    QTreeWidgetItem* groupItem = (item->parent() != NULL) ? item->parent() : item;
+
+    groupItem->setData(0, Rundown::EXECUTED_ROLE, true);
+    for (int i = 0; i < groupItem->childCount(); i++)
+        groupItem->child(i)->setData(0, Rundown::EXECUTED_ROLE, true);
+}
+
+void RundownTreeBaseWidget::addLazyItem(QTreeWidgetItem* item, boost::property_tree::wptree& pt)
+{
+    item->setData(0, Rundown::TYPE_ROLE, QString::fromStdWString(pt.get(L"type", L"")));
+    item->setData(0, Rundown::LABEL_ROLE, QString::fromStdWString(pt.get(L"label", L"")));
+    item->setData(0, Rundown::DEVICENAME_ROLE, QString::fromStdWString(pt.get(L"devicename", L"")));
+    item->setData(0, Rundown::NAME_ROLE, QString::fromStdWString(pt.get(L"name", L"")));
+    item->setData(0, Rundown::COLOR_ROLE, QString::fromStdWString(pt.get(L"color", L"")));
+
+    // The record lives on the item, it goes away with the item however the item is deleted.
+    item->setData(0, Rundown::RECORD_ROLE, QVariant::fromValue(pt));
+}
+
+bool RundownTreeBaseWidget::isLazyItem(QTreeWidgetItem* item) const
+{
+    return item->data(0, Rundown::RECORD_ROLE).isValid();
+}
+
+bool RundownTreeBaseWidget::isLazyItem(const boost::property_tree::wptree& pt) const
+{
+    // Remote triggered items have to listen for their OSC control messages right away.
+    return !pt.get(L"allowremotetriggering", false);
+}
+
+void RundownTreeBaseWidget::createVisibleItems()
+{
+    QTreeWidgetItem* item = QTreeWidget::itemAt(0, 0);
+    while (item != NULL && QTreeWidget::visualItemRect(item).top() < QTreeWidget::viewport()->height())
+    {
+        getItemWidget(item);
+
+        item = QTreeWidget::itemBelow(item);
+    }
+
+    releaseHiddenItems();
+}
+
+void RundownTreeBaseWidget::releaseHiddenItems()
+{
+    // Widgets created from records are released again once they are a viewport away from the visible rows,
+    // scrolling back and forth does not create them over and over.
+    int height = QTreeWidget::viewport()->height();
+    for (int i = this->createdItems.count() - 1; i >= 0; i--)
+    {
+        QTreeWidgetItem* item = QTreeWidget::itemFromIndex(this->createdItems.at(i));
+        if (item == NULL)
+        {
+            this->createdItems.removeAt(i); // Removed from the rundown.
+            continue;
+        }
+
+        QRect rect = QTreeWidget::visualItemRect(item);
+        if (rect.isValid() && rect.bottom() >= -height && rect.top() < 2 * height)
+            continue;
+
+        if (item->isSelected() || item == QTreeWidget::currentItem())
+            continue; // Released once it is deselected and out of view.
+
+        releaseItemWidget(item);
+
+        this->createdItems.removeAt(i);
+    }
+}
+
+bool RundownTreeBaseWidget::releaseItemWidget(QTreeWidgetItem* item)
+{
+    AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0));
+    if (widget == NULL || isLazyItem(item))
+        return false;
+
+    // Remote triggered items listen for their OSC control messages, they keep their widget like when they are read.
+    if (item->data(0, Rundown::EXECUTED_ROLE).toBool() || widget->getCommand()->getAllowRemoteTriggering())
+        return false;
+
+    // The widget goes back to a record the same way the rundown is saved, edits made in the inspector are kept.
+    QString data;
+    QXmlStreamWriter writer(&data);
+    writer.writeStartDocument();
+    writeProperties(item, writer);
+    writer.writeEndDocument();
+
+    std::wstringstream wstringstream;
+    wstringstream << data.toStdWString();
+
+    boost::property_tree::wptree pt;
+    try
+    {
+        boost::property_tree::xml_parser::read_xml(wstringstream, pt);
+    }
+    catch (const boost::property_tree::xml_parser_error& e)
+    {
+        qCritical("Failed to release rundown item: %s", e.what());
+        return false;
+    }
+
+    // The children of a group are separate items, the group record keeps only its own properties.
+    boost::property_tree::wptree record = pt.get_child(L"item");
+    record.erase(L"items");
+
+    QTreeWidget::removeItemWidget(item, 0);
+    addLazyItem(item, record);
+
+    return true;
+}
+
+void RundownTreeBaseWidget::writeLazyProperties(const boost::property_tree::wptree& pt, QXmlStreamWriter& writer) const
+{
+    for (const boost::property_tree::wptree::value_type& value : pt)
+    {
+        if (value.second.empty())
+            writer.writeTextElement(QString::fromStdWString(value.first), QString::fromStdWString(value.second.data()));
+        else
+        {
+            writer.writeStartElement(QString::fromStdWString(value.first));
+            writeLazyProperties(value.second, writer);
+            writer.writeEndElement();
+        }
+    }
+}
+
 void RundownTreeBaseWidget::writeProperties(QTreeWidgetItem* item, QXmlStreamWriter& writer) const
 {
+    if (isLazyItem(item))
+    {
+        // Write the record back as it was read, only the group state lives on the tree item.
+        boost::property_tree::wptree pt = item->data(0, Rundown::RECORD_ROLE).value<boost::property_tree::wptree>();
+        if (isItemGroup(item))
+            pt.put(L"expanded", item->isExpanded() ? L"true" : L"false");
+
+        writer.writeStartElement("item");
+        writeLazyProperties(pt, writer);
+
+        if (isItemGroup(item))
+        {
+            writer.writeStartElement("items");
+            for (int i = 0; i < item->childCount(); i++)
+                writeProperties(item->child(i), writer);
+
+            writer.writeEndElement();
+        }
+
+        writer.writeEndElement();
+
+        return;
+    }
+
     AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0));
     if (widget->getLibraryModel()->getType() == "GROUP")
     {
@@ -154,7 +383,7 @@ bool RundownTreeBaseWidget::pasteItemProperties()
 
         foreach (QTreeWidgetItem* item, QTreeWidget::selectedItems())
         {
-            AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0));
+            AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(item));
             if (widget->getLibraryModel()->getType() == type)
                 widget->getCommand()->readProperties(parentValue.second);
         }
@@ -163,29 +392,140 @@ bool RundownTreeBaseWidget::pasteItemProperties()
     return true;
 }
 
-bool RundownTreeBaseWidget::pasteSelectedItems(bool repositoryRundown)
+void RundownTreeBaseWidget::appendItems(QList<boost::property_tree::wptree>& properties)
 {
-    std::wstringstream wstringstream;
-    wstringstream << qApp->clipboard()->text().toStdWString();
+    // Each batch goes in with updates suspended, the view is laid out once per batch.
+    QTreeWidget::setUpdatesEnabled(false);
 
-    int offset = 1; // Drop offset.
-    boost::property_tree::wptree pt;
-    boost::property_tree::xml_parser::read_xml(wstringstream, pt);
+    QList<QTreeWidgetItem*> items;
+    for (int i = 0; i < properties.count(); i++)
+        items.append(new QTreeWidgetItem());
+
+    QTreeWidget::invisibleRootItem()->addChildren(items);
 
-    if (pt.get_child(L"items").count(L"allowremotetriggering") > 0)
+    for (int i = 0; i < items.count(); i++)
     {
-        bool allowRemoteTriggering = pt.get_child(L"items").get(L"allowremotetriggering", false);
-        EventManager::getInstance().fireAllowRemoteTriggeringEvent(AllowRemoteTriggeringEvent(allowRemoteTriggering));
+        boost::property_tree::wptree& pt = properties[i];
+
+        // Items start out as records, their widget is created when they become visible or are used.
+        if (isLazyItem(pt))
+            addLazyItem(items.at(i), pt);
+        else
+        {
+            AbstractRundownWidget* widget = readProperties(pt);
+            widget->setInGroup(false);
+            widget->setExpanded(false);
+
+            attachItemWidget(items.at(i), widget);
+        }
+
+        if (QString::fromStdWString(pt.get(L"type", L"")) == "GROUP")
+            readLazyGroupItems(items.at(i), pt);
     }
 
-    EventManager::getInstance().fireRepositoryRundownEvent(RepositoryRundownEvent(repositoryRundown));
+    QTreeWidget::setUpdatesEnabled(true);
+    QTreeWidget::doItemsLayout();
 
-    for (boost::property_tree::wptree::value_type &parentValue : pt.get_child(L"items"))
+    checkEmptyRundown();
+
+    this->createTimer.start();
+}
+
+void RundownTreeBaseWidget::readLazyGroupItems(QTreeWidgetItem* parentItem, boost::property_tree::wptree& pt)
+{
+    if (pt.count(L"items") > 0)
     {
-        if (parentValue.first != L"item")
+        QList<QTreeWidgetItem*> items;
+        QList<boost::property_tree::wptree*> properties;
+        for (boost::property_tree::wptree::value_type& childValue : pt.get_child(L"items"))
+        {
+            if (childValue.first != L"item")
+                continue;
+
+            items.append(new QTreeWidgetItem());
+            properties.append(&childValue.second);
+        }
+
+        parentItem->addChildren(items);
+
+        for (int i = 0; i < items.count(); i++)
+        {
+            if (isLazyItem(*properties.at(i)))
+                addLazyItem(items.at(i), *properties.at(i));
+            else
+            {
+                AbstractRundownWidget* widget = readProperties(*properties.at(i));
+                widget->setInGroup(true);
+
+                attachItemWidget(items.at(i), widget);
+            }
+        }
+    }
+
+    bool expanded = pt.get(L"expanded", false);
+    parentItem->setExpanded(expanded);
+
+    AbstractRundownWidget* parentWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(parentItem, 0));
+    if (parentWidget != NULL)
+        parentWidget->setExpanded(expanded);
+
+    // The children are separate items now, the group record keeps only its own properties.
+    if (isLazyItem(parentItem))
+    {
+        boost::property_tree::wptree record = parentItem->data(0, Rundown::RECORD_ROLE).value<boost::property_tree::wptree>();
+        record.erase(L"items");
+
+        parentItem->setData(0, Rundown::RECORD_ROLE, QVariant::fromValue(record));
+    }
+}
+
+void RundownTreeBaseWidget::readGroupItems(QTreeWidgetItem* parentItem, AbstractRundownWidget* parentWidget, boost::property_tree::wptree& pt)
+{
+    bool expanded = pt.get(L"expanded", false);
+    parentItem->setExpanded(expanded);
+    parentWidget->setExpanded(expanded);
+
+    if (pt.count(L"items") == 0)
+        return;
+
+    QList<QTreeWidgetItem*> items;
+    QList<AbstractRundownWidget*> widgets;
+    for (boost::property_tree::wptree::value_type& childValue : pt.get_child(L"items"))
+    {
+        if (childValue.first != L"item")
             continue;
 
-        AbstractRundownWidget* parentWidget = readProperties(parentValue.second);
+        AbstractRundownWidget* widget = readProperties(childValue.second);
+        widget->setInGroup(true);
+
+        items.append(new QTreeWidgetItem());
+        widgets.append(widget);
+    }
+
+    parentItem->addChildren(items);
+
+    for (int i = 0; i < items.count(); i++)
+        attachItemWidget(items.at(i), widgets.at(i));
+}
+
+bool RundownTreeBaseWidget::pasteSelectedItems(bool repositoryRundown)
+{
+    RundownReader reader;
+    if (!reader.read(qApp->clipboard()->text().toUtf8()))
+        return true;
+
+    int offset = 1; // Drop offset.
+
+    if (reader.hasAllowRemoteTriggering())
+        EventManager::getInstance().fireAllowRemoteTriggeringEvent(AllowRemoteTriggeringEvent(reader.getAllowRemoteTriggering()));
+
+    EventManager::getInstance().fireRepositoryRundownEvent(RepositoryRundownEvent(repositoryRundown));
+
+    QTreeWidget::setUpdatesEnabled(false);
+
+    for (boost::property_tree::wptree& pt : reader.getItems())
+    {
+        AbstractRundownWidget* parentWidget = readProperties(pt);
 
         int row  = QTreeWidget::currentIndex().row();
 
@@ -205,38 +545,27 @@ bool RundownTreeBaseWidget::pasteSelectedItems(bool repositoryRundown)
         else
         {
             if (parentWidget->isGroup())
+            {
+                delete parentItem;
+                delete parentWidget;
+
                 continue; // We don't support group in groups.
+            }
 
             parentWidget->setInGroup(true);
 
             QTreeWidget::currentItem()->parent()->insertChild(row + offset++, parentItem);
         }
 
-        QTreeWidget::setItemWidget(parentItem, 0, dynamic_cast<QWidget*>(parentWidget));
-        //QTreeWidget::setCurrentItem(parentItem);
+        attachItemWidget(parentItem, parentWidget);
 
         if (parentWidget->isGroup())
-        {
-            bool expanded = parentValue.second.get(L"expanded", false);
-            parentItem->setExpanded(expanded);
-            parentWidget->setExpanded(expanded);
-
-            for (boost::property_tree::wptree::value_type &childValue : parentValue.second.get_child(L"items"))
-            {
-                AbstractRundownWidget* childWidget = readProperties(childValue.second);
-                childWidget->setInGroup(true);
-
-                QTreeWidgetItem* childItem = new QTreeWidgetItem();
-                parentItem->addChild(childItem);
-
-                QTreeWidget::setItemWidget(childItem, 0, dynamic_cast<QWidget*>(childWidget));
-            }
-        }
-
-        QTreeWidget::doItemsLayout(); // Refresh
-        QTreeWidget::repaint();
+            readGroupItems(parentItem, parentWidget, pt);
     }
 
+    QTreeWidget::setUpdatesEnabled(true);
+    QTreeWidget::doItemsLayout(); // Refresh
+
     checkEmptyRundown();
 
     return true;
@@ -271,8 +600,8 @@ void RundownTreeBaseWidget::removeSelectedItems()
 {
     foreach (QTreeWidgetItem* item, QTreeWidget::selectedItems())
     {
-        AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0));
-        if (widget->isGroup())
+        QWidget* widget = QTreeWidget::itemWidget(item, 0);
+        if (isItemGroup(item))
         {
             for (int i = item->childCount() - 1; i >= 0; i--)
             {
@@ -307,8 +636,8 @@ void RundownTreeBaseWidget::removeAllItems()
     for (int i = QTreeWidget::invisibleRootItem()->childCount() - 1; i >= 0; i--)
     {
         QTreeWidgetItem* item = QTreeWidget::invisibleRootItem()->child(i);
-        AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0));
-        if (widget->isGroup())
+        QWidget* widget = QTreeWidget::itemWidget(item, 0);
+        if (isItemGroup(item))
         {
             for (int j = item->childCount() - 1; j >= 0; j--)
             {
@@ -347,7 +676,7 @@ void RundownTreeBaseWidget::groupItems()
     bool isGroupItem = false;
     foreach (QTreeWidgetItem* item, QTreeWidget::selectedItems())
     {
-        QWidget* widget = QTreeWidget::itemWidget(item, 0);
+        QWidget* widget = getItemWidget(item);
 
         if (item->parent() != NULL) // Group item.
             isGroupItem = true;
@@ -367,7 +696,7 @@ void RundownTreeBaseWidget::groupItems()
 
     int row = QTreeWidget::indexOfTopLevelItem(QTreeWidget::selectedItems().at(0));
     QTreeWidget::invisibleRootItem()->insertChild(row, parentItem);
-    QTreeWidget::setItemWidget(parentItem, 0, dynamic_cast<QWidget*>(widget));
+    attachItemWidget(parentItem, widget);
     QTreeWidget::expandItem(parentItem);
 
     if (getCompactView())
@@ -380,11 +709,11 @@ void RundownTreeBaseWidget::groupItems()
         QTreeWidgetItem* childItem = new QTreeWidgetItem();
         parentItem->addChild(childItem);
 
-        AbstractRundownWidget* childWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0))->clone();
+        AbstractRundownWidget* childWidget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(item))->clone();
         childWidget->setInGroup(true);
         childWidget->setActive(false);
 
-        QTreeWidget::setItemWidget(childItem, 0, dynamic_cast<QWidget*>(childWidget));
+        attachItemWidget(childItem, childWidget);
     }
 
     removeSelectedItems();
@@ -403,7 +732,7 @@ void RundownTreeBaseWidget::ungroupItems()
     bool isGroupItem = false;
     foreach (QTreeWidgetItem* item, QTreeWidget::selectedItems())
     {
-        QWidget* widget = QTreeWidget::itemWidget(item, 0);
+        QWidget* widget = getItemWidget(item);
 
         if (item->parent() != NULL) // Group item.
             isGroupItem = true;
@@ -418,7 +747,7 @@ void RundownTreeBaseWidget::ungroupItems()
 
     QTreeWidgetItem* rootItem = QTreeWidget::invisibleRootItem();
 
-    if (dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(QTreeWidget::currentItem(), 0))->isGroup()) // Group.
+    if (isItemGroup(QTreeWidget::currentItem())) // Group.
     {
         QTreeWidgetItem* currentItem = QTreeWidget::currentItem();
         QTreeWidgetItem* currentItemAbove = QTreeWidget::itemAbove(QTreeWidget::currentItem());
@@ -433,11 +762,11 @@ void RundownTreeBaseWidget::ungroupItems()
             newItem = new QTreeWidgetItem();
             rootItem->insertChild(row + 1, newItem);
 
-            AbstractRundownWidget* newWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0))->clone();
+            AbstractRundownWidget* newWidget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(item))->clone();
             newWidget->setInGroup(false);
             newWidget->setActive(false);
 
-            QTreeWidget::setItemWidget(newItem, 0, dynamic_cast<QWidget*>(newWidget));
+            attachItemWidget(newItem, newWidget);
 
             row++;
         }
@@ -464,11 +793,11 @@ void RundownTreeBaseWidget::ungroupItems()
             newItem = new QTreeWidgetItem();
             rootItem->insertChild(parentRow + 1, newItem);
 
-            AbstractRundownWidget* newWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0))->clone();
+            AbstractRundownWidget* newWidget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(item))->clone();
             newWidget->setInGroup(false);
             newWidget->setActive(false);
 
-            QTreeWidget::setItemWidget(newItem, 0, dynamic_cast<QWidget*>(newWidget));
+            attachItemWidget(newItem, newWidget);
 
             // Remove our items from the auto play queue if it exists.
             EventManager::getInstance().fireRemoveItemFromAutoPlayQueueEvent(RemoveItemFromAutoPlayQueueEvent(item));
@@ -507,18 +836,18 @@ void RundownTreeBaseWidget::moveItemUp()
     QTreeWidgetItem* currentItem = QTreeWidget::currentItem();
     QTreeWidgetItem* parentItem = QTreeWidget::currentItem()->parent();
 
-    if (dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(currentItem, 0))->isGroup())
+    if (isItemGroup(currentItem))
     {
         int rowCount = 0;
         if (currentItem != NULL && row > rowCount)
         {
-            AbstractRundownWidget* parentWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(currentItem, 0))->clone();
+            AbstractRundownWidget* parentWidget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(currentItem))->clone();
             parentWidget->setInGroup(true);
             parentWidget->setExpanded(true);
 
             QTreeWidgetItem* parentItem = new QTreeWidgetItem();
             QTreeWidget::invisibleRootItem()->insertChild(row - 1, parentItem);
-            QTreeWidget::setItemWidget(parentItem, 0, dynamic_cast<QWidget*>(parentWidget));
+            attachItemWidget(parentItem, parentWidget);
 
             if (QTreeWidget::currentItem()->isExpanded())
                 QTreeWidget::expandItem(parentItem);
@@ -527,12 +856,12 @@ void RundownTreeBaseWidget::moveItemUp()
             {
                 QTreeWidgetItem* item = QTreeWidget::currentItem()->child(i);
 
-                AbstractRundownWidget* childWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0))->clone();
+                AbstractRundownWidget* childWidget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(item))->clone();
                 childWidget->setInGroup(true);
 
                 QTreeWidgetItem* childItem = new QTreeWidgetItem();
                 parentItem->addChild(childItem);
-                QTreeWidget::setItemWidget(childItem, 0, dynamic_cast<QWidget*>(childWidget));
+                attachItemWidget(childItem, childWidget);
             }
 
             // Remove our items from the auto play queue if it exists.
@@ -552,7 +881,7 @@ void RundownTreeBaseWidget::moveItemUp()
         int rowCount = 0;
         if (currentItem != NULL && row > rowCount)
         {
-            AbstractRundownWidget* newWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(currentItem, 0))->clone();
+            AbstractRundownWidget* newWidget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(currentItem))->clone();
 
             if (parentItem == NULL) // Top level item.
             {
@@ -567,7 +896,7 @@ void RundownTreeBaseWidget::moveItemUp()
                 QTreeWidget::currentItem()->parent()->insertChild(row - 1, currentItem);
             }
 
-            QTreeWidget::setItemWidget(currentItem, 0, dynamic_cast<QWidget*>(newWidget));
+            attachItemWidget(currentItem, newWidget);
             QTreeWidget::setCurrentItem(currentItem);
             QTreeWidget::doItemsLayout(); // Refresh
         }
@@ -583,7 +912,7 @@ void RundownTreeBaseWidget::moveItemDown()
     QTreeWidgetItem* currentItem = QTreeWidget::currentItem();
     QTreeWidgetItem* parentItem = QTreeWidget::currentItem()->parent();
 
-    if (dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(currentItem, 0))->isGroup())
+    if (isItemGroup(currentItem))
     {
         int rowCount = 0;
         if (parentItem == NULL) // Top level item.
@@ -591,13 +920,13 @@ void RundownTreeBaseWidget::moveItemDown()
 
         if (currentItem != NULL && row < rowCount)
         {
-            AbstractRundownWidget* parentWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(currentItem, 0))->clone();
+            AbstractRundownWidget* parentWidget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(currentItem))->clone();
             parentWidget->setInGroup(true);
             parentWidget->setExpanded(true);
 
             QTreeWidgetItem* parentItem = new QTreeWidgetItem();
             QTreeWidget::invisibleRootItem()->insertChild(row + 2, parentItem);
-            QTreeWidget::setItemWidget(parentItem, 0, dynamic_cast<QWidget*>(parentWidget));
+            attachItemWidget(parentItem, parentWidget);
 
             if (QTreeWidget::currentItem()->isExpanded())
                 QTreeWidget::expandItem(parentItem);
@@ -606,12 +935,12 @@ void RundownTreeBaseWidget::moveItemDown()
             {
                 QTreeWidgetItem* item = QTreeWidget::currentItem()->child(i);
 
-                AbstractRundownWidget* childWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0))->clone();
+                AbstractRundownWidget* childWidget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(item))->clone();
                 childWidget->setInGroup(true);
 
                 QTreeWidgetItem* childItem = new QTreeWidgetItem();
                 parentItem->addChild(childItem);
-                QTreeWidget::setItemWidget(childItem, 0, dynamic_cast<QWidget*>(childWidget));
+                attachItemWidget(childItem, childWidget);
             }
 
             // Remove our items from the auto play queue if it exists.
@@ -636,7 +965,7 @@ void RundownTreeBaseWidget::moveItemDown()
 
         if (currentItem != NULL && row < rowCount)
         {
-            AbstractRundownWidget* newWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(currentItem, 0))->clone();
+            AbstractRundownWidget* newWidget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(currentItem))->clone();
 
             if (parentItem == NULL) // Top level item.
             {
@@ -651,7 +980,7 @@ void RundownTreeBaseWidget::moveItemDown()
                 QTreeWidget::currentItem()->parent()->insertChild(row + 1, currentItem);
             }
 
-            QTreeWidget::setItemWidget(currentItem, 0, dynamic_cast<QWidget*>(newWidget));
+            attachItemWidget(currentItem, newWidget);
             QTreeWidget::setCurrentItem(currentItem);
             QTreeWidget::doItemsLayout(); // Refresh
         }
@@ -672,12 +1001,12 @@ void RundownTreeBaseWidget::moveItemOutOfGroup()
     int currentRow  = QTreeWidget::currentIndex().row();
     int parentRow  = QTreeWidget::indexOfTopLevelItem(QTreeWidget::currentItem()->parent());
 
-    AbstractRundownWidget* newWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(currentItem, 0))->clone();
+    AbstractRundownWidget* newWidget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(currentItem))->clone();
     newWidget->setInGroup(false);
 
     QTreeWidget::currentItem()->parent()->takeChild(currentRow);
     QTreeWidget::invisibleRootItem()->insertChild(parentRow + 1, newItem);
-    QTreeWidget::setItemWidget(newItem, 0, dynamic_cast<QWidget*>(newWidget));
+    attachItemWidget(newItem, newWidget);
     QTreeWidget::setCurrentItem(newItem);
     QTreeWidget::doItemsLayout(); // Refresh
 
@@ -708,24 +1037,24 @@ void RundownTreeBaseWidget::moveItemIntoGroup()
     if (QTreeWidget::currentItem() == NULL || QTreeWidget::currentItem()->parent() != NULL) // Group item.
         return;
 
-    if (dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(QTreeWidget::currentItem(), 0))->isGroup())
+    if (isItemGroup(QTreeWidget::currentItem()))
         return;
 
     QTreeWidgetItem* currentItemAbove = QTreeWidget::invisibleRootItem()->child(QTreeWidget::currentIndex().row() - 1);
-    if (currentItemAbove != NULL && dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(currentItemAbove, 0))->isGroup()) // Group.
+    if (currentItemAbove != NULL && isItemGroup(currentItemAbove)) // Group.
     {
         QTreeWidgetItem* newItem = new QTreeWidgetItem();
         QTreeWidgetItem* currentItem = QTreeWidget::currentItem();
 
         int currentRow  = QTreeWidget::currentIndex().row();
 
-        AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(currentItem, 0))->clone();
+        AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(getItemWidget(currentItem))->clone();
         widget->setInGroup(true);
 
         currentItemAbove->addChild(newItem);
 
         QTreeWidget::invisibleRootItem()->takeChild(currentRow);
-        QTreeWidget::setItemWidget(newItem, 0, dynamic_cast<QWidget*>(widget));
+        attachItemWidget(newItem, widget);
         QTreeWidget::doItemsLayout(); // Ref resh
         QTreeWidget::setCurrentItem(newItem);
 
@@ -744,7 +1073,7 @@ void RundownTreeBaseWidget::setExpanded(bool expanded)
     if (QTreeWidget::currentItem() == nullptr)
         return;
 
-    QWidget* selectedWidget = QTreeWidget::itemWidget(QTreeWidget::currentItem(), 0);
+    QWidget* selectedWidget = getItemWidget(QTreeWidget::currentItem());
     AbstractRundownWidget* rundownWidget = dynamic_cast<AbstractRundownWidget*>(selectedWidget);
 
     if (rundownWidget->isGroup()) // Group.
@@ -817,6 +1146,13 @@ void RundownTreeBaseWidget::mousePressEvent(QMouseEvent* event)
     QTreeWidget::mousePressEvent(event);
 }
 
+void RundownTreeBaseWidget::resizeEvent(QResizeEvent* event)
+{
+    QTreeWidget::resizeEvent(event);
+
+    this->createTimer.start();
+}
+
 void RundownTreeBaseWidget::mouseMoveEvent(QMouseEvent* event)
 {
     if (this->lock)
@@ -912,8 +1248,8 @@ bool RundownTreeBaseWidget::dropMimeData(QTreeWidgetItem* parent, int index, con
             for (int i = items.count() - 1; i >= 0; i--)
             {
                 QTreeWidgetItem* item = items.at(i);
-                AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0));
-                if (widget->isGroup())
+                QWidget* widget = QTreeWidget::itemWidget(item, 0);
+                if (isItemGroup(item))
                 {
                     for (int i = item->childCount() - 1; i >= 0; i--)
                     {
@@ -951,7 +1287,7 @@ bool RundownTreeBaseWidget::hasItemBelow() const
         return false;
 
     QTreeWidgetItem* itemBelow = NULL;
-    if (dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(QTreeWidget::currentItem(), 0))->isGroup()) // Group.
+    if (isItemGroup(QTreeWidget::currentItem())) // Group.
         itemBelow = QTreeWidget::invisibleRootItem()->child(QTreeWidget::currentIndex().row() + 1);
     else
         itemBelow = QTreeWidget::itemBelow(QTreeWidget::currentItem());
@@ -968,7 +1304,7 @@ void RundownTreeBaseWidget::selectItemAbove()
     }
 
     QTreeWidgetItem* itemAbove = NULL;
-    if (dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(QTreeWidget::currentItem(), 0))->isGroup()) // Group.
+    if (isItemGroup(QTreeWidget::currentItem())) // Group.
         itemAbove = QTreeWidget::invisibleRootItem()->child(QTreeWidget::currentIndex().row() - 1);
     else
         itemAbove = QTreeWidget::itemAbove(QTreeWidget::currentItem());
@@ -992,7 +1328,7 @@ void RundownTreeBaseWidget::selectItemBelow()
     }
 
     QTreeWidgetItem* itemBelow = NULL;
-    if (dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(QTreeWidget::currentItem(), 0))->isGroup()) // Group.
+    if (isItemGroup(QTreeWidget::currentItem())) // Group.
         itemBelow = QTreeWidget::invisibleRootItem()->child(QTreeWidget::currentIndex().row() + 1);
     else
         itemBelow = QTreeWidget::itemBelow(QTreeWidget::currentItem());
@@ -1054,13 +1390,11 @@ QString RundownTreeBaseWidget::currentItemStoryId()
     if (QTreeWidget::currentItem() != NULL)
     {
         QTreeWidgetItem* currentItem = QTreeWidget::currentItem();
-        AbstractRundownWidget* currentWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(currentItem, 0));
-        AbstractRundownWidget* parentWidget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(currentItem->parent(), 0));
 
-        if (parentWidget != NULL)
-            currentStoryId = parentWidget->getCommand()->getStoryId(); // Group item.
+        if (currentItem->parent() != NULL)
+            currentStoryId = getStoryId(currentItem->parent()); // Group item.
         else
-            currentStoryId = currentWidget->getCommand()->getStoryId(); // Group or top level item.
+            currentStoryId = getStoryId(currentItem); // Group or top level item.
     }
 
     return currentStoryId;
@@ -1110,8 +1444,7 @@ void RundownTreeBaseWidget::addRepositoryItem(const QString& storyId, const QStr
     for (int i = QTreeWidget::topLevelItemCount() - 1; i >= 0; i--)
     {
         QTreeWidgetItem* item = QTreeWidget::topLevelItem(i);
-        AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0));
-        if (widget->getCommand()->getStoryId() == storyId)
+        if (getStoryId(item) == storyId)
         {
             row = QTreeWidget::indexFromItem(item).row();
             break; // We have found the last story id in the rundown.
@@ -1137,7 +1470,7 @@ void RundownTreeBaseWidget::addRepositoryItem(const QString& storyId, const QStr
         QTreeWidgetItem* parentItem = new QTreeWidgetItem();
 
         QTreeWidget::invisibleRootItem()->insertChild(row + offset++, parentItem);
-        QTreeWidget::setItemWidget(parentItem, 0, dynamic_cast<QWidget*>(parentWidget));
+        attachItemWidget(parentItem, parentWidget);
 
         if (parentWidget->isGroup())
         {
@@ -1149,7 +1482,7 @@ void RundownTreeBaseWidget::addRepositoryItem(const QString& storyId, const QStr
                 QTreeWidgetItem* childItem = new QTreeWidgetItem();
                 parentItem->addChild(childItem);
 
-                QTreeWidget::setItemWidget(childItem, 0, dynamic_cast<QWidget*>(childWidget));
+                attachItemWidget(childItem, childWidget);
             }
         }
 
@@ -1163,10 +1496,10 @@ void RundownTreeBaseWidget::removeRepositoryItem(const QString& storyId)
     for (int i = QTreeWidget::topLevelItemCount() - 1; i >= 0; i--)
     {
         QTreeWidgetItem* item = QTreeWidget::topLevelItem(i);
-        AbstractRundownWidget* widget = dynamic_cast<AbstractRundownWidget*>(QTreeWidget::itemWidget(item, 0));
-        if (widget->getCommand()->getStoryId() == storyId)
+        if (getStoryId(item) == storyId)
         {
-            if (widget->isGroup())
+            QWidget* widget = QTreeWidget::itemWidget(item, 0);
+            if (isItemGroup(item))
             {
                 for (int i = item->childCount() - 1; i >= 0; i--)
                 {
@@ -13,9 +13,15 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QMetaType>
 #include <QtCore/QModelIndexList>
 #include <QtCore/QMimeData>
+#include <QtCore/QPersistentModelIndex>
 #include <QtCore/QRect>
+#include <QtCore/QTimer>
+#include <QtCore/QVariant>
 #include <QtCore/QXmlStreamWriter>
 
 #include <QtGui/QDragEnterEvent>
@@ -23,11 +29,14 @@
 #include <QtGui/QKeyEvent>
 #include <QtGui/QMouseEvent>
 #include <QtGui/QPixmap>
+#include <QtGui/QResizeEvent>
 
 #include <QtWidgets/QTreeWidget>
 #include <QtWidgets/QTreeWidgetItem>
 #include <QtWidgets/QWidget>
 
+Q_DECLARE_METATYPE(boost::property_tree::wptree)
+
 class WIDGETS_EXPORT RundownTreeBaseWidget : public QTreeWidget
 {
     Q_OBJECT
@@ -42,9 +51,16 @@ class WIDGETS_EXPORT RundownTreeBaseWidget : public QTreeWidget
         Qt::DropActions supportedDropActions() const;
         void dragEnterEvent(QDragEnterEvent* event);
 
+        void attachItemWidget(QTreeWidgetItem* item, AbstractRundownWidget* widget);
+        QWidget* getItemWidget(QTreeWidgetItem* item);
+        bool isItemGroup(QTreeWidgetItem* item) const;
+        QString getStoryId(QTreeWidgetItem* item) const;
+        void setUsed(QTreeWidgetItem* item, bool used);
+        void setExecuted(QTreeWidgetItem* item);
         AbstractRundownWidget* readProperties(boost::property_tree::wptree& pt);
         void writeProperties(QTreeWidgetItem* item, QXmlStreamWriter& writer) const;
 
+        void appendItems(QList<boost::property_tree::wptree>& properties);
         bool pasteSelectedItems(bool repositoryRundown = false);
         bool pasteItemProperties();
         bool duplicateSelectedItems();
@@ -74,6 +90,7 @@ class WIDGETS_EXPORT RundownTreeBaseWidget : public QTreeWidget
         void keyPressEvent(QKeyEvent* event);
         void mouseMoveEvent(QMouseEvent* event);
         void mousePressEvent(QMouseEvent* event);
+        void resizeEvent(QResizeEvent* event);
 
     private:
         bool compactView;
@@ -83,10 +100,22 @@ class WIDGETS_EXPORT RundownTreeBaseWidget : public QTreeWidget
         QPoint dragStartPosition;
         QList<RepositoryChangeModel> repositoryChanges;
 
+        QTimer createTimer;
+        QList<QPersistentModelIndex> createdItems;
+
         QString currentItemStoryId();
+        void readGroupItems(QTreeWidgetItem* parentItem, AbstractRundownWidget* parentWidget, boost::property_tree::wptree& pt);
+        void readLazyGroupItems(QTreeWidgetItem* parentItem, boost::property_tree::wptree& pt);
+        void addLazyItem(QTreeWidgetItem* item, boost::property_tree::wptree& pt);
+        bool isLazyItem(const boost::property_tree::wptree& pt) const;
+        bool isLazyItem(QTreeWidgetItem* item) const;
+        bool releaseItemWidget(QTreeWidgetItem* item);
+        void releaseHiddenItems();
+        void writeLazyProperties(const boost::property_tree::wptree& pt, QXmlStreamWriter& writer) const;
         void removeRepositoryItem(const QString& storyId);
         bool containsStoryId(const QString& storyId, const QString& data);
         void addRepositoryItem(const QString& storyId, const QString& data);
 
+        Q_SLOT void createVisibleItems();
         Q_SLOT void repositoryRundown(const RepositoryRundownEvent&);
 };
@@ -47,7 +47,6 @@
 #include <QtCore/QPoint>
 #include <QtCore5Compat/QTextCodec>
 #include <QtCore/QElapsedTimer>
-#include <QtCore/QTextStream>
 #include <QtCore/QCryptographicHash>
 
 #include <QtGui/QClipboard>
@@ -62,11 +61,12 @@
 RundownTreeWidget::RundownTreeWidget(QWidget* parent)
     : QWidget(parent),
       active(false), enterPressed(false), allowRemoteRundownTriggering(false), repositoryRundown(false), previewOnAutoStep(false),
-      clearDelayedCommandsOnAutoStep(false), activeRundown(Rundown::DEFAULT_NAME), currentAutoPlayWidget(NULL), copyItem(NULL), currentPlayingItem(NULL), currentPlayingAutoStepItem(NULL),
+      clearDelayedCommandsOnAutoStep(false), readingRundown(false), activeRundown(Rundown::DEFAULT_NAME), currentAutoPlayWidget(NULL), copyItem(NULL), currentPlayingItem(NULL), currentPlayingAutoStepItem(NULL),
       upControlSubscription(NULL), downControlSubscription(NULL), playAndAutoStepControlSubscription(NULL), playNowAndAutoStepControlSubscription(NULL),
       playNowIfChannelControlSubscription(NULL), stopControlSubscription(NULL), playControlSubscription(NULL), playNowControlSubscription(NULL),
       loadControlSubscription(NULL), pauseControlSubscription(NULL), nextControlSubscription(NULL), updateControlSubscription(NULL), invokeControlSubscription(NULL), previewControlSubscription(NULL),
-      clearControlSubscription(NULL), clearVideolayerControlSubscription(NULL), clearChannelControlSubscription(NULL), repositoryDevice(NULL)
+      clearControlSubscription(NULL), clearVideolayerControlSubscription(NULL), clearChannelControlSubscription(NULL), repositoryDevice(NULL),
+      readThread(NULL), readWorker(NULL)
 {
     setupUi(this);
     setupMenus();
@@ -103,6 +103,18 @@ RundownTreeWidget::RundownTreeWidget(QWidget* parent)
     this->treeWidgetRundown->checkEmptyRundown();
 }
 
+RundownTreeWidget::~RundownTreeWidget()
+{
+    if (this->readThread == NULL)
+        return;
+
+    // Stop a read in progress, it gives up at the next batch.
+    this->readWorker->cancel();
+
+    this->readThread->quit();
+    this->readThread->wait();
+}
+
 void RundownTreeWidget::setupMenus()
 {
     this->contextMenuMixer = new QMenu(this);
@@ -339,21 +351,27 @@ void RundownTreeWidget::compactView(const CompactViewEvent& event)
     if (this->treeWidgetRundown->invisibleRootItem()->childCount() == 0)
         return;
 
+    // Items without a widget yet pick up the view when their widget is created.
     for (int i = 0; i < this->treeWidgetRundown->invisibleRootItem()->childCount(); i++)
     {
         QTreeWidgetItem* item = this->treeWidgetRundown->invisibleRootItem()->child(i);
         QWidget* widget = dynamic_cast<QWidget*>(this->treeWidgetRundown->itemWidget(item, 0));
 
-        dynamic_cast<AbstractRundownWidget*>(widget)->setCompactView(!this->treeWidgetRundown->getCompactView());
-        if (this->treeWidgetRundown->getCompactView())
-            widget->setFixedHeight(Rundown::DEFAULT_ITEM_HEIGHT);
-        else
-            widget->setFixedHeight(Rundown::COMPACT_ITEM_HEIGHT);
+        if (widget != NULL)
+        {
+            dynamic_cast<AbstractRundownWidget*>(widget)->setCompactView(!this->treeWidgetRundown->getCompactView());
+            if (this->treeWidgetRundown->getCompactView())
+                widget->setFixedHeight(Rundown::DEFAULT_ITEM_HEIGHT);
+            else
+                widget->setFixedHeight(Rundown::COMPACT_ITEM_HEIGHT);
+        }
 
         for (int j = 0; j < item->childCount(); j++)
         {
             QTreeWidgetItem* child = item->child(j);
             QWidget* widget = dynamic_cast<QWidget*>(this->treeWidgetRundown->itemWidget(child, 0));
+            if (widget == NULL)
+                continue;
 
             dynamic_cast<AbstractRundownWidget*>(widget)->setCompactView(!this->treeWidgetRundown->getCompactView());
             if (this->treeWidgetRundown->getCompactView())
@@ -363,9 +381,9 @@ void RundownTreeWidget::compactView(const CompactViewEvent& event)
         }
     }
 
-    this->treeWidgetRundown->doItemsLayout(); // Refresh
-
     this->treeWidgetRundown->setCompactView(!this->treeWidgetRundown->getCompactView());
+
+    this->treeWidgetRundown->doItemsLayout(); // Refresh
 }
 
 void RundownTreeWidget::executeRundownItem(const ExecuteRundownItemEvent& event)
@@ -384,7 +402,8 @@ void RundownTreeWidget::clearDelayedCommands()
         for (int i = 0; i < this->currentPlayingAutoStepItem->childCount(); i++)
         {
             QWidget* childWidget = this->treeWidgetRundown->itemWidget(this->currentPlayingAutoStepItem->child(i), 0);
-            dynamic_cast<AbstractRundownWidget*>(childWidget)->clearDelayedCommands();
+            if (childWidget != NULL)
+                dynamic_cast<AbstractRundownWidget*>(childWidget)->clearDelayedCommands();
         }
     }
 }
@@ -421,7 +440,7 @@ void RundownTreeWidget::addRudnownItem(const AddRudnownItemEvent& event)
         widget->setInGroup(true);
     }
 
-    this->treeWidgetRundown->setItemWidget(item, 0, dynamic_cast<QWidget*>(widget));
+    this->treeWidgetRundown->attachItemWidget(item, widget);
     this->treeWidgetRundown->setCurrentItem(item);
     this->treeWidgetRundown->setFocus();
 
@@ -443,7 +462,7 @@ void RundownTreeWidget::autoPlayChanged(const AutoPlayChangedEvent& event)
 
     for (int i = 0; i < this->treeWidgetRundown->currentItem()->childCount(); i++)
     {
-        QWidget* childWidget = this->treeWidgetRundown->itemWidget(this->treeWidgetRundown->currentItem()->child(i), 0);
+        QWidget* childWidget = this->treeWidgetRundown->getItemWidget(this->treeWidgetRundown->currentItem()->child(i));
         AbstractRundownWidget* childRundownWidget = dynamic_cast<AbstractRundownWidget*>(childWidget);
 
         if (dynamic_cast<MovieCommand*>(childRundownWidget->getCommand()))
@@ -513,12 +532,16 @@ void RundownTreeWidget::setActive(bool active)
     {
         EventManager::getInstance().fireAllowRemoteTriggeringEvent(AllowRemoteTriggeringEvent(this->allowRemoteRundownTriggering));
         EventManager::getInstance().fireRepositoryRundownEvent(RepositoryRundownEvent(this->repositoryRundown));
+
+        // A rundown still loading can't be saved, it would be saved without the items not read yet.
+        EventManager::getInstance().fireSaveMenuEvent(SaveMenuEvent(!this->repositoryRundown && !this->readingRundown));
+        EventManager::getInstance().fireSaveAsMenuEvent(SaveAsMenuEvent(!this->repositoryRundown && !this->readingRundown));
     }
 
     EventManager::getInstance().fireActiveRundownChangedEvent(ActiveRundownChangedEvent(this->activeRundown));
 
     QTreeWidgetItem* currentItem = this->treeWidgetRundown->currentItem();
-    QWidget* currentItemWidget = this->treeWidgetRundown->itemWidget(currentItem, 0);
+    QWidget* currentItemWidget = this->treeWidgetRundown->getItemWidget(currentItem);
 
     QTreeWidgetItem* currentItemParent = NULL;
     if (currentItem != NULL)
@@ -526,7 +549,7 @@ void RundownTreeWidget::setActive(bool active)
 
     QWidget* currentItemWidgetParent = NULL;
     if (currentItemParent != NULL)
-        currentItemWidgetParent = this->treeWidgetRundown->itemWidget(currentItemParent, 0);
+        currentItemWidgetParent = this->treeWidgetRundown->getItemWidget(currentItemParent);
 
     if (currentItem != NULL && currentItemWidget != NULL)
     {
@@ -548,46 +571,105 @@ void RundownTreeWidget::setActive(bool active)
 
 void RundownTreeWidget::openRundown(const QString& path)
 {
-    QElapsedTimer time;
-    time.start();
-
     EventManager::getInstance().fireStatusbarEvent(StatusbarEvent("Opening rundown..."));
 
     qDebug("Open rundown %s", qPrintable(path));
 
     QFile file(path);
-    if (file.open(QFile::ReadOnly | QIODevice::Text))
+    if (!file.open(QFile::ReadOnly | QIODevice::Text))
     {
-        this->activeRundown = path;
+        EventManager::getInstance().fireStatusbarEvent(StatusbarEvent(""));
+        return;
+    }
+
+    this->activeRundown = path;
+
+    QByteArray data = file.readAll();
+    file.close();
+
+    this->hexHash = QString(QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex());
+    qDebug("Hash is %s", qPrintable(this->hexHash));
+
+    readRundown(data);
+
+    DatabaseManager::getInstance().insertOpenRecent(path);
+}
 
-        QTextStream stream(&file);
-        stream.setEncoding(QStringConverter::Utf8);
+void RundownTreeWidget::readRundown(const QByteArray& data)
+{
+    this->readTime.start();
+    this->readingRundown = true;
+
+    EventManager::getInstance().fireRepositoryRundownEvent(RepositoryRundownEvent(this->repositoryRundown));
+
+    if (this->active)
+    {
+        EventManager::getInstance().fireSaveMenuEvent(SaveMenuEvent(false));
+        EventManager::getInstance().fireSaveAsMenuEvent(SaveAsMenuEvent(false));
+    }
 
-        // Save the latest value stored in the clipboard.
-        QString latest = qApp->clipboard()->text();
-        QString data = stream.readAll();
+    // Parsing runs on its own thread, the items are inserted batch by batch as they come in.
+    if (this->readThread == NULL)
+    {
+        this->readThread = new QThread(this);
+        this->readThread->setObjectName("Rundown reader");
 
-        this->hexHash = QString(QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
-        qDebug("Hash is %s", qPrintable(this->hexHash));
+        this->readWorker = new RundownReadWorker();
+        this->readWorker->moveToThread(this->readThread);
 
-        qApp->clipboard()->setText(data);
-        pasteSelectedItems();
+        QObject::connect(this->readThread, SIGNAL(finished()), this->readWorker, SLOT(deleteLater()));
+        QObject::connect(this->readWorker, SIGNAL(itemsRead()), this, SLOT(rundownItemsRead()));
 
-        // Set previous stored clipboard value.
-        qApp->clipboard()->setText(latest);
+        this->readThread->start();
+    }
 
-        qDebug("Parsing rundown completed in %lld msec", time.elapsed());
+    // The cache is keyed by the hash of the rundown, any edit to the file gives a new entry.
+    bool useRundownCache = (DatabaseManager::getInstance().getConfigurationByName("UseRundownCache").getValue() == "true") ? true : false;
 
-        file.close();
+    this->readWorker->read(data, this->hexHash, useRundownCache);
+}
 
-        if (this->treeWidgetRundown->invisibleRootItem()->childCount() > 0)
-            this->treeWidgetRundown->setCurrentItem(this->treeWidgetRundown->invisibleRootItem()->child(0));
+void RundownTreeWidget::rundownItemsRead()
+{
+    QList<boost::property_tree::wptree> items;
+    bool hasAllowRemoteTriggering;
+    bool allowRemoteTriggering;
+    bool finished;
+    bool failed;
+    if (!this->readWorker->takeItems(items, hasAllowRemoteTriggering, allowRemoteTriggering, finished, failed))
+        return; // Out of date, the rundown was closed or opened again.
 
+    if (hasAllowRemoteTriggering)
+        EventManager::getInstance().fireAllowRemoteTriggeringEvent(AllowRemoteTriggeringEvent(allowRemoteTriggering));
+
+    bool firstItems = (this->treeWidgetRundown->invisibleRootItem()->childCount() == 0);
+
+    this->treeWidgetRundown->appendItems(items);
+
+    // The first screenful is usable right away, the rest of the rundown keeps loading below it.
+    if (firstItems && this->treeWidgetRundown->invisibleRootItem()->childCount() > 0)
+    {
+        this->treeWidgetRundown->setCurrentItem(this->treeWidgetRundown->invisibleRootItem()->child(0));
         this->treeWidgetRundown->setFocus();
 
-        DatabaseManager::getInstance().insertOpenRecent(path);
+        qDebug("First rundown items shown in %lld msec", this->readTime.elapsed());
+    }
+
+    if (!finished)
+        return;
+
+    this->readingRundown = false;
+
+    // A rundown that can't be read is not opened half way, saving it would truncate the file.
+    if (failed)
+        this->treeWidgetRundown->removeAllItems();
 
-        qDebug("RundownTreeWidget::openRundown %lld msec (%d items)", time.elapsed(), this->treeWidgetRundown->invisibleRootItem()->childCount());
+    qDebug("RundownTreeWidget::readRundown %lld msec (%d items)", this->readTime.elapsed(), this->treeWidgetRundown->invisibleRootItem()->childCount());
+
+    if (this->active)
+    {
+        EventManager::getInstance().fireSaveMenuEvent(SaveMenuEvent(!this->repositoryRundown));
+        EventManager::getInstance().fireSaveAsMenuEvent(SaveAsMenuEvent(!this->repositoryRundown));
     }
 
     EventManager::getInstance().fireStatusbarEvent(StatusbarEvent(""));
@@ -616,28 +698,16 @@ void RundownTreeWidget::doOpenRundownFromUrl(QNetworkReply* reply)
 {
     this->repositoryRundown = true;
 
-    // Save the latest value stored in the clipboard.
-    QString latest = qApp->clipboard()->text();
-    QString data = QString::fromUtf8(reply->readAll());
+    QByteArray data = reply->readAll();
 
-    this->hexHash = QString(QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+    this->hexHash = QString(QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex());
     qDebug("Hash is %s", qPrintable(this->hexHash));
 
-    qApp->clipboard()->setText(data);
-    pasteSelectedItems();
-
-    // Set previous stored clipboard value.
-    qApp->clipboard()->setText(latest);
-
-    if (this->treeWidgetRundown->invisibleRootItem()->childCount() > 0)
-        this->treeWidgetRundown->setCurrentItem(this->treeWidgetRundown->invisibleRootItem()->child(0));
-
-    this->treeWidgetRundown->setFocus();
+    readRundown(data);
 
     EventManager::getInstance().fireSaveMenuEvent(SaveMenuEvent(false));
     EventManager::getInstance().fireSaveAsMenuEvent(SaveAsMenuEvent(false));
     EventManager::getInstance().fireReloadRundownMenuEvent(ReloadRundownMenuEvent(true));
-    EventManager::getInstance().fireStatusbarEvent(StatusbarEvent(""));
 
     reply->deleteLater();
     this->networkManager->deleteLater();
@@ -696,9 +766,6 @@ void RundownTreeWidget::reloadRundown()
         openRundownFromUrl(this->activeRundown);
     else
         openRundown(this->activeRundown);
-
-    if (this->treeWidgetRundown->invisibleRootItem()->childCount() > 0)
-        this->treeWidgetRundown->setCurrentItem(this->treeWidgetRundown->invisibleRootItem()->child(0));
 }
 
 void RundownTreeWidget::saveRundown(bool saveAs)
@@ -706,6 +773,13 @@ void RundownTreeWidget::saveRundown(bool saveAs)
     if (this->treeWidgetRundown->invisibleRootItem()->childCount() == 0)
         return;
 
+    // A rundown still loading would be saved without the items not read yet.
+    if (this->readingRundown)
+    {
+        EventManager::getInstance().fireStatusbarEvent(StatusbarEvent("The rundown is still opening, it can be saved once it is open."));
+        return;
+    }
+
     QString path;
     if (saveAs)
         path = QFileDialog::getSaveFileName(this, "Save Rundown", QDir::homePath(), "Rundown (*.xml)");
@@ -769,6 +843,10 @@ bool RundownTreeWidget::checkForSave() const
     if (this->repositoryRundown)
         return false;
 
+    // Nor rundowns still loading.
+    if (this->readingRundown)
+        return false;
+
     QByteArray data;
     QXmlStreamWriter writer(&data);
 
@@ -800,7 +878,7 @@ void RundownTreeWidget::colorizeItems(const QString& color)
         return;
 
     foreach (QTreeWidgetItem* item, this->treeWidgetRundown->selectedItems())
-        dynamic_cast<AbstractRundownWidget*>(this->treeWidgetRundown->itemWidget(item, 0))->setColor(color); // Colorize current selected item.
+        dynamic_cast<AbstractRundownWidget*>(this->treeWidgetRundown->getItemWidget(item))->setColor(color); // Colorize current selected item.
 }
 
 void RundownTreeWidget::gpiPortTriggered(int gpiPort, GpiDevice* device)
@@ -825,7 +903,7 @@ void RundownTreeWidget::customContextMenuRequested(const QPoint& point)
     bool isGroupItem = false;
     foreach (QTreeWidgetItem* item, this->treeWidgetRundown->selectedItems())
     {
-        QWidget* widget = this->treeWidgetRundown->itemWidget(item, 0);
+        QWidget* widget = this->treeWidgetRundown->getItemWidget(item);
 
         if (item->parent() != NULL) // Group item.
             isGroupItem = true;
@@ -872,7 +950,7 @@ void RundownTreeWidget::customContextMenuRequested(const QPoint& point)
         if (this->treeWidgetRundown->selectedItems().count() == 1)
         {
             QTreeWidgetItem* currentItem = this->treeWidgetRundown->currentItem();
-            QWidget* currentItemWidget = this->treeWidgetRundown->itemWidget(currentItem, 0);
+            QWidget* currentItemWidget = this->treeWidgetRundown->getItemWidget(currentItem);
             if (dynamic_cast<AbstractRundownWidget*>(currentItemWidget) != NULL)
             {
                 QString color = dynamic_cast<AbstractRundownWidget*>(currentItemWidget)->getColor();
@@ -987,7 +1065,7 @@ void RundownTreeWidget::itemClicked(QTreeWidgetItem* current, int index)
         return;
 
     QTreeWidgetItem* currentItem = this->treeWidgetRundown->currentItem();
-    QWidget* currentItemWidget = this->treeWidgetRundown->itemWidget(currentItem, 0);
+    QWidget* currentItemWidget = this->treeWidgetRundown->getItemWidget(currentItem);
 
     QTreeWidgetItem* currentItemParent = NULL;
     if (currentItem != NULL)
@@ -995,7 +1073,7 @@ void RundownTreeWidget::itemClicked(QTreeWidgetItem* current, int index)
 
     QWidget* currentItemWidgetParent = NULL;
     if (currentItemParent != NULL)
-        currentItemWidgetParent = this->treeWidgetRundown->itemWidget(currentItemParent, 0);
+        currentItemWidgetParent = this->treeWidgetRundown->getItemWidget(currentItemParent);
 
     if (currentItem != NULL && currentItemWidget != NULL)
     {
@@ -1009,8 +1087,8 @@ void RundownTreeWidget::itemClicked(QTreeWidgetItem* current, int index)
 
 void RundownTreeWidget::currentItemChanged(QTreeWidgetItem* current, QTreeWidgetItem* previous)
 {
-    QWidget* currentWidget = this->treeWidgetRundown->itemWidget(current, 0);
-    QWidget* previousWidget = this->treeWidgetRundown->itemWidget(previous, 0);
+    QWidget* currentWidget = this->treeWidgetRundown->getItemWidget(current);
+    QWidget* previousWidget = this->treeWidgetRundown->getItemWidget(previous);
 
     if (previous != NULL && previousWidget != NULL)
     {
@@ -1029,7 +1107,7 @@ void RundownTreeWidget::currentItemChanged(QTreeWidgetItem* current, QTreeWidget
     }
 
     QTreeWidgetItem* currentItem = this->treeWidgetRundown->currentItem();
-    QWidget* currentItemWidget = this->treeWidgetRundown->itemWidget(currentItem, 0);
+    QWidget* currentItemWidget = this->treeWidgetRundown->getItemWidget(currentItem);
 
     QTreeWidgetItem* currentItemParent = NULL;
     if (currentItem != NULL)
@@ -1037,7 +1115,7 @@ void RundownTreeWidget::currentItemChanged(QTreeWidgetItem* current, QTreeWidget
 
     QWidget* currentItemWidgetParent = NULL;
     if (currentItemParent != NULL)
-        currentItemWidgetParent = this->treeWidgetRundown->itemWidget(currentItemParent, 0);
+        currentItemWidgetParent = this->treeWidgetRundown->getItemWidget(currentItemParent);
 
     if (currentItem != NULL && currentItemWidget != NULL)
     {
@@ -1058,7 +1136,7 @@ void RundownTreeWidget::itemDoubleClicked(QTreeWidgetItem* item, int index)
 {
     Q_UNUSED(index);
 
-    QWidget* selectedWidget = this->treeWidgetRundown->itemWidget(this->treeWidgetRundown->currentItem(), 0);
+    QWidget* selectedWidget = this->treeWidgetRundown->getItemWidget(this->treeWidgetRundown->currentItem());
     AbstractRundownWidget* rundownWidget = dynamic_cast<AbstractRundownWidget*>(selectedWidget);
 
     if (rundownWidget->isGroup()) // Group.
@@ -1082,21 +1160,15 @@ bool RundownTreeWidget::copySelectedItems() const
 
 void RundownTreeWidget::setUsed(bool used)
 {
-    if (this->treeWidgetRundown->currentItem() == NULL)
+    QTreeWidgetItem* currentItem = this->treeWidgetRundown->currentItem();
+    if (currentItem == NULL)
         return;
 
-    QWidget* selectedWidget = this->treeWidgetRundown->itemWidget(this->treeWidgetRundown->currentItem(), 0);
-    AbstractRundownWidget* rundownWidget = dynamic_cast<AbstractRundownWidget*>(selectedWidget);
-
-    rundownWidget->setUsed(used);
-    if (rundownWidget != NULL && rundownWidget->isGroup())
+    this->treeWidgetRundown->setUsed(currentItem, used);
+    if (this->treeWidgetRundown->isItemGroup(currentItem))
     {
-        for (int i = 0; i < this->treeWidgetRundown->currentItem()->childCount(); i++)
-        {
-            QWidget* childWidget = this->treeWidgetRundown->itemWidget(this->treeWidgetRundown->currentItem()->child(i), 0);
-
-            dynamic_cast<AbstractRundownWidget*>(childWidget)->setUsed(used);
-        }
+        for (int i = 0; i < currentItem->childCount(); i++)
+            this->treeWidgetRundown->setUsed(currentItem->child(i), used);
     }
 }
 
@@ -1105,17 +1177,12 @@ void RundownTreeWidget::setAllUsed(bool used)
     for (int i = 0; i < this->treeWidgetRundown->invisibleRootItem()->childCount(); i++)
     {
         QTreeWidgetItem* currentItem = this->treeWidgetRundown->invisibleRootItem()->child(i);
-        AbstractRundownWidget* rundownWidget = dynamic_cast<AbstractRundownWidget*>(this->treeWidgetRundown->itemWidget(currentItem, 0));
 
-        rundownWidget->setUsed(used);
-        if (rundownWidget != NULL && rundownWidget->isGroup())
+        this->treeWidgetRundown->setUsed(currentItem, used);
+        if (this->treeWidgetRundown->isItemGroup(currentItem))
         {
             for (int i = 0; i < currentItem->childCount(); i++)
-            {
-                QWidget* childWidget = this->treeWidgetRundown->itemWidget(currentItem->child(i), 0);
-
-                dynamic_cast<AbstractRundownWidget*>(childWidget)->setUsed(used);
-            }
+                this->treeWidgetRundown->setUsed(currentItem->child(i), used);
         }
     }
 }
@@ -1139,8 +1206,8 @@ bool RundownTreeWidget::executeCommand(Playout::PlayoutType type, Action::Action
         currentItem = this->treeWidgetRundown->currentItem();
         //currentIndex = this->treeWidgetRundown->currentIndex();
 
-        selectedWidget = this->treeWidgetRundown->itemWidget(currentItem, 0);
-        selectedWidgetParent = this->treeWidgetRundown->itemWidget(currentItem->parent(), 0);
+        selectedWidget = this->treeWidgetRundown->getItemWidget(currentItem);
+        selectedWidgetParent = this->treeWidgetRundown->getItemWidget(currentItem->parent());
 
         rundownWidget = dynamic_cast<AbstractRundownWidget*>(selectedWidget);
         rundownWidgetParent = dynamic_cast<AbstractRundownWidget*>(selectedWidgetParent);
@@ -1150,8 +1217,8 @@ bool RundownTreeWidget::executeCommand(Playout::PlayoutType type, Action::Action
         currentItem = item;
         //currentIndex = this->treeWidgetRundown->indexOfTopLevelItem(item);
 
-        selectedWidget = this->treeWidgetRundown->itemWidget(currentItem, 0);
-        selectedWidgetParent = this->treeWidgetRundown->itemWidget(currentItem->parent(), 0);
+        selectedWidget = this->treeWidgetRundown->getItemWidget(currentItem);
+        selectedWidgetParent = this->treeWidgetRundown->getItemWidget(currentItem->parent());
 
         rundownWidget = dynamic_cast<AbstractRundownWidget*>(selectedWidget);
         rundownWidgetParent = dynamic_cast<AbstractRundownWidget*>(selectedWidgetParent);
@@ -1160,6 +1227,8 @@ bool RundownTreeWidget::executeCommand(Playout::PlayoutType type, Action::Action
     if (source == Action::ActionType::GpiPulse && !rundownWidget->getCommand()->getAllowGpi())
         return true; // Gpi pulses cannot trigger this item.
 
+    this->treeWidgetRundown->setExecuted(currentItem);
+
     if (type == Playout::PlayoutType::Next && rundownWidgetParent != nullptr && rundownWidgetParent->isGroup() && dynamic_cast<GroupCommand*>(rundownWidgetParent->getCommand())->getAutoPlay())
     {
         EventManager::getInstance().fireAutoPlayNextRundownItemEvent(AutoPlayNextRundownItemEvent(dynamic_cast<QWidget*>(this->currentAutoPlayWidget)));
@@ -1169,7 +1238,7 @@ bool RundownTreeWidget::executeCommand(Playout::PlayoutType type, Action::Action
     else
     {
         if (this->currentPlayingItem != nullptr)
-            dynamic_cast<AbstractRundownWidget*>(this->treeWidgetRundown->itemWidget(this->currentPlayingItem, 0))->setActive(false);
+            dynamic_cast<AbstractRundownWidget*>(this->treeWidgetRundown->getItemWidget(this->currentPlayingItem))->setActive(false);
 
         dynamic_cast<AbstractRundownWidget*>(selectedWidget)->setActive(true);
         dynamic_cast<AbstractPlayoutCommand*>(selectedWidget)->executeCommand(type);
@@ -1197,7 +1266,7 @@ bool RundownTreeWidget::executeCommand(Playout::PlayoutType type, Action::Action
             QList<AbstractRundownWidget*>* autoPlayQueue = new QList<AbstractRundownWidget*>();
             for (int i = 0; i < currentItem->childCount(); i++)
             {
-                QWidget* childWidget = this->treeWidgetRundown->itemWidget(currentItem->child(i), 0);
+                QWidget* childWidget = this->treeWidgetRundown->getItemWidget(currentItem->child(i));
                 AbstractRundownWidget* rundownChildWidget = dynamic_cast<AbstractRundownWidget*>(childWidget);
                 if (dynamic_cast<MovieCommand*>(rundownChildWidget->getCommand()))
                 {
@@ -1244,7 +1313,7 @@ bool RundownTreeWidget::executeCommand(Playout::PlayoutType type, Action::Action
             // Execute command on the selected item.
             for (int i = 0; i < currentItem->childCount(); i++)
             {
-                QWidget* childWidget = this->treeWidgetRundown->itemWidget(currentItem->child(i), 0);
+                QWidget* childWidget = this->treeWidgetRundown->getItemWidget(currentItem->child(i));
 
                 EventManager::getInstance().fireRemoveItemFromAutoPlayQueueEvent(RemoveItemFromAutoPlayQueueEvent(currentItem->child(i)));
 
@@ -1284,7 +1353,7 @@ bool RundownTreeWidget::executeCommand(Playout::PlayoutType type, Action::Action
             QList<AbstractRundownWidget*>* autoPlayQueue = new QList<AbstractRundownWidget*>();
             for (int i = currentItem->parent()->indexOfChild(currentItem); i < currentItem->parent()->childCount(); i++)
             {
-                QWidget* childWidget = this->treeWidgetRundown->itemWidget(currentItem->parent()->child(i), 0);
+                QWidget* childWidget = this->treeWidgetRundown->getItemWidget(currentItem->parent()->child(i));
                 AbstractRundownWidget* rundownChildWidget = dynamic_cast<AbstractRundownWidget*>(childWidget);
                 if (dynamic_cast<MovieCommand*>(rundownChildWidget->getCommand()))
                 {
@@ -1782,14 +1851,14 @@ void RundownTreeWidget::playNowIfChannelControlSubscriptionReceived(const QStrin
     if (this->allowRemoteRundownTriggering && arguments.count() > 0)
     {
         QTreeWidgetItem* currentItem = this->treeWidgetRundown->currentItem();
-        AbstractRundownWidget* rundownWidget = dynamic_cast<AbstractRundownWidget*>(this->treeWidgetRundown->itemWidget(currentItem, 0));
+        AbstractRundownWidget* rundownWidget = dynamic_cast<AbstractRundownWidget*>(this->treeWidgetRundown->getItemWidget(currentItem));
 
         if (rundownWidget != NULL && rundownWidget->isGroup())
         {
             for (int i = 0; i < currentItem->childCount(); i++)
             {
                 QTreeWidgetItem* childItem = currentItem->child(i);
-                AbstractRundownWidget* rundownChildWidget = dynamic_cast<AbstractRundownWidget*>(this->treeWidgetRundown->itemWidget(childItem, 0));
+                AbstractRundownWidget* rundownChildWidget = dynamic_cast<AbstractRundownWidget*>(this->treeWidgetRundown->getItemWidget(childItem));
 
                 LibraryModel* model = rundownChildWidget->getLibraryModel();
                 if (model == NULL)
@@ -9,6 +9,7 @@
 
 #include "GpiDevice.h"
 #include "RepositoryDevice.h"
+#include "RundownReadWorker.h"
 #include "Models/RepositoryChangeModel.h"
 
 #include "Events/AddPresetItemEvent.h"
@@ -32,12 +33,14 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QEvent>
 #include <QtCore/QMap>
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QXmlStreamWriter>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThread>
 
 #include <QtWidgets/QMenu>
 #include <QtWidgets/QTreeWidgetItem>
@@ -52,6 +55,7 @@ class WIDGETS_EXPORT RundownTreeWidget : public QWidget, Ui::RundownTreeWidget
 
     public:
         explicit RundownTreeWidget(QWidget* parent = 0);
+        ~RundownTreeWidget();
 
         void setActive(bool active);
         void openRundown(const QString& path);
@@ -75,6 +79,7 @@ class WIDGETS_EXPORT RundownTreeWidget : public QWidget, Ui::RundownTreeWidget
         bool repositoryRundown;
         bool previewOnAutoStep;
         bool clearDelayedCommandsOnAutoStep;
+        bool readingRundown;
 
         QString page;
         QString activeRundown;
@@ -119,6 +124,11 @@ class WIDGETS_EXPORT RundownTreeWidget : public QWidget, Ui::RundownTreeWidget
 
         QNetworkAccessManager* networkManager;
 
+        QThread* readThread;
+        RundownReadWorker* readWorker;
+        QElapsedTimer readTime;
+
+        void readRundown(const QByteArray& data);
         bool pasteSelectedItems();
         bool duplicateSelectedItems();
         bool copySelectedItems() const;
@@ -210,6 +220,7 @@ class WIDGETS_EXPORT RundownTreeWidget : public QWidget, Ui::RundownTreeWidget
         Q_SLOT void clearVideolayerControlSubscriptionReceived(const QString&, const QList<QVariant>&);
         Q_SLOT void clearChannelControlSubscriptionReceived(const QString&, const QList<QVariant>&);
         Q_SLOT void doOpenRundownFromUrl(QNetworkReply*);
+        Q_SLOT void rundownItemsRead();
         Q_SLOT void markItemAsUsed();
         Q_SLOT void markItemAsUnused();
         Q_SLOT void markAllItemsAsUsed();
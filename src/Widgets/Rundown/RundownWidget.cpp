@@ -52,6 +52,8 @@ RundownWidget::RundownWidget(QWidget* parent)
     QObject::connect(&EventManager::getInstance(), SIGNAL(markAllItemsAsUsed(const MarkAllItemsAsUsedEvent&)), this, SLOT(markAllItemsAsUsed(const MarkAllItemsAsUsedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(markAllItemsAsUnused(const MarkAllItemsAsUnusedEvent&)), this, SLOT(markAllItemsAsUnused(const MarkAllItemsAsUnusedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(reloadRundownMenu(const ReloadRundownMenuEvent&)), this, SLOT(reloadRundownMenu(const ReloadRundownMenuEvent&)));
+    QObject::connect(&EventManager::getInstance(), SIGNAL(saveMenu(const SaveMenuEvent&)), this, SLOT(saveMenu(const SaveMenuEvent&)));
+    QObject::connect(&EventManager::getInstance(), SIGNAL(saveAsMenu(const SaveAsMenuEvent&)), this, SLOT(saveAsMenu(const SaveAsMenuEvent&)));
 }
 
 void RundownWidget::setupMenus()
@@ -172,6 +174,16 @@ void RundownWidget::reloadRundownMenu(const ReloadRundownMenuEvent& event)
     this->reloadRundownAction->setEnabled(event.getEnabled());
 }
 
+void RundownWidget::saveMenu(const SaveMenuEvent& event)
+{
+    this->saveAction->setEnabled(event.getEnabled());
+}
+
+void RundownWidget::saveAsMenu(const SaveAsMenuEvent& event)
+{
+    this->saveAsAction->setEnabled(event.getEnabled());
+}
+
 void RundownWidget::newRundownMenu(const NewRundownMenuEvent& event)
 {
     this->newRundownAction->setEnabled(event.getEnabled());
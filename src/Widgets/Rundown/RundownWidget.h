@@ -25,6 +25,8 @@
 #include "Events/Rundown/ReloadRundownEvent.h"
 #include "Events/Rundown/SaveRundownEvent.h"
 #include "Events/Rundown/ReloadRundownMenuEvent.h"
+#include "Events/Rundown/SaveAsMenuEvent.h"
+#include "Events/Rundown/SaveMenuEvent.h"
 
 #include <QtCore/QEvent>
 #include <QtCore/QObject>
@@ -104,4 +106,6 @@ class WIDGETS_EXPORT RundownWidget : public QWidget, Ui::RundownWidget
         Q_SLOT void activeRundownChanged(const ActiveRundownChangedEvent&);
         Q_SLOT void reloadRundown(const ReloadRundownEvent&);
         Q_SLOT void reloadRundownMenu(const ReloadRundownMenuEvent&);
+        Q_SLOT void saveMenu(const SaveMenuEvent&);
+        Q_SLOT void saveAsMenu(const SaveAsMenuEvent&);
 };
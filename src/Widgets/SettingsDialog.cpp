@@ -6,6 +6,8 @@
 #include "DatabaseManager.h"
 #include "GpiManager.h"
 #include "EventManager.h"
+#include "LibraryStore.h"
+#include "ThumbnailCache.h"
 #include "Events/OscOutputChangedEvent.h"
 #include "Events/Library/RefreshLibraryEvent.h"
 #include "Events/Library/AutoRefreshLibraryEvent.h"
@@ -719,6 +721,8 @@ void SettingsDialog::deleteThumbnails()
     EventManager::getInstance().fireStatusbarEvent(StatusbarEvent("Deleting thumbnails..."));
 
     DatabaseManager::getInstance().deleteThumbnails();
+    LibraryStore::getInstance().load();
+    ThumbnailCache::getInstance().clear();
 
     EventManager::getInstance().fireStatusbarEvent(StatusbarEvent(""));
 